@@ -0,0 +1,54 @@
+/*
+    随机键的插入、查找与有序遍历：set（红黑树）与 btree_set 的对比
+    用法：bench_btree [n]
+*/
+#include "AssociativeContainers/BTree/btree_set.h"
+#include "AssociativeContainers/Set/stl_set.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+template<class F>
+double time_it(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+template<class Set>
+void run(const char *name, const TinySTL::vector<long> &keys, size_t &sink) {
+  Set s;
+  double insert = time_it([&] {
+    for (long k : keys) s.insert(k);
+  });
+  double find = time_it([&] {
+    for (long k : keys) sink += s.find(k) != s.end();
+  });
+  double iterate = time_it([&] {
+    for (int round = 0; round < 10; ++round)
+      for (auto it = s.begin(); it != s.end(); ++it) sink += *it;
+  });
+  std::printf("%-10s insert %7.3f s  find %7.3f s  iterate x10 %7.3f s\n", name, insert, find,
+              iterate);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? std::atol(argv[1]) : 2000000;
+  TinySTL::vector<long> keys;
+  std::mt19937_64 gen(42);
+  for (long i = 0; i < n; ++i) keys.push_back(static_cast<long>(gen() >> 1));
+
+  size_t sink = 0;
+  std::printf("n=%ld\n", n);
+  run<TinySTL::set<long>>("set", keys, sink);
+  run<TinySTL::btree_set<long>>("btree_set", keys, sink);
+  std::printf("checksum %zu\n", sink);
+  return 0;
+}
@@ -0,0 +1,53 @@
+/*
+    一次建立、之后只读的场景：map 与 flat_map 的建立与随机查找对比
+    用法：bench_flat_map [n]
+*/
+#include "AssociativeContainers/Flat/flat_map.h"
+#include "AssociativeContainers/Map/stl_map.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+template<class F>
+double time_it(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+template<class Map>
+void run(const char *name, const TinySTL::vector<TinySTL::pair<long, long>> &items,
+         const TinySTL::vector<long> &probes, size_t &sink) {
+  Map m;
+  double build = time_it([&] { m.insert(items.begin(), items.end()); });
+  double find = time_it([&] {
+    for (long k : probes) {
+      auto it = m.find(k);
+      if (it != m.end()) sink += it->second;
+    }
+  });
+  std::printf("%-9s build %7.3f s  find %7.3f s\n", name, build, find);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? std::atol(argv[1]) : 1000000;
+  std::mt19937_64 gen(7);
+  TinySTL::vector<TinySTL::pair<long, long>> items;
+  TinySTL::vector<long> probes;
+  for (long i = 0; i < n; ++i) items.push_back(TinySTL::pair<long, long>(gen() % (4 * n), i));
+  for (long i = 0; i < 4 * n; ++i) probes.push_back(gen() % (4 * n));
+
+  size_t sink = 0;
+  std::printf("n=%ld, %ld probes\n", n, 4 * n);
+  run<TinySTL::map<long, long>>("map", items, probes, sink);
+  run<TinySTL::flat_map<long, long>>("flat_map", items, probes, sink);
+  std::printf("checksum %zu\n", sink);
+  return 0;
+}
@@ -0,0 +1,57 @@
+/*
+    区间重叠查询：逐项扫描 multimap 与 interval_map 的对比
+    用法：bench_interval_map [n] [queries]
+*/
+#include "AssociativeContainers/Interval/interval_map.h"
+#include "AssociativeContainers/Map/stl_multimap.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+template<class F>
+double time_it(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? std::atol(argv[1]) : 200000;
+  long q = argc > 2 ? std::atol(argv[2]) : 200;
+  const long span = 100 * n;
+  std::mt19937_64 gen(7);
+  TinySTL::multimap<long, long> by_start;// 以起点为键，值为终点
+  TinySTL::interval_map<long, long> im;
+  for (long i = 0; i < n; ++i) {
+    long lo = gen() % span, hi = lo + 1 + gen() % 500;
+    by_start.insert(TinySTL::pair<const long, long>(lo, hi));
+    im.insert(lo, hi, i);
+  }
+
+  size_t scan_hits = 0, tree_hits = 0;
+  std::mt19937_64 qgen(11);
+  double scan = time_it([&] {
+    for (long i = 0; i < q; ++i) {
+      long lo = qgen() % span, hi = lo + 1000;
+      for (auto it = by_start.begin(); it != by_start.end(); ++it)
+        if (it->first < hi && lo < it->second) ++scan_hits;
+    }
+  });
+  qgen.seed(11);
+  double tree = time_it([&] {
+    for (long i = 0; i < q; ++i) {
+      long lo = qgen() % span, hi = lo + 1000;
+      im.for_each_overlap(lo, hi, [&](TinySTL::interval_map<long, long>::iterator) { ++tree_hits; });
+    }
+  });
+  std::printf("n=%ld, %ld queries\n", n, q);
+  std::printf("multimap scan %8.3f s  hits %zu\n", scan, scan_hits);
+  std::printf("interval_map  %8.3f s  hits %zu\n", tree, tree_hits);
+  return 0;
+}
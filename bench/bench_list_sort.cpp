@@ -0,0 +1,97 @@
+/*
+    list::sort / list::sort_gathered 与原先基于 64 个临时 list 的归并排序的对比
+    用法：bench_list_sort [n]
+    大 list：先排序一次把节点在内存中打散，再填入新的随机值计时，模拟长期使用后的 list；
+    小 list：反复排序 32 个元素的 list，此时每次调用的固定开销占主导
+*/
+#include "SequenceContainers/List/stl_list.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using list_t = TinySTL::list<unsigned>;
+
+// 原先的实现：carry 与 counter[64] 均为带哨兵节点的 list
+void legacy_sort(list_t &l) {
+  if (l.size() < 2) return;
+  list_t carry;
+  list_t counter[64];
+  int fill = 0;
+  while (!l.empty()) {
+    carry.splice(carry.begin(), l, l.begin());
+    int i = 0;
+    while (i < fill && !counter[i].empty()) {
+      counter[i].merge(carry);
+      carry.swap(counter[i++]);
+    }
+    carry.swap(counter[i]);
+    if (i == fill) ++fill;
+  }
+  for (int i = 1; i < fill; ++i) counter[i].merge(counter[i - 1]);
+  l.swap(counter[fill - 1]);
+}
+
+unsigned next_random(unsigned &seed) {
+  seed = seed * 1664525u + 1013904223u;
+  return seed;
+}
+
+void refill(list_t &l, unsigned seed) {
+  for (unsigned &x : l) x = next_random(seed);
+}
+
+template<class Sort>
+double run_small(list_t &l, int rounds, Sort sort) {
+  unsigned seed = 7;
+  double total = 0;
+  for (int r = 0; r < rounds; ++r) {
+    refill(l, seed++);
+    auto begin = std::chrono::steady_clock::now();
+    sort(l);
+    auto end = std::chrono::steady_clock::now();
+    total += std::chrono::duration<double>(end - begin).count();
+  }
+  return total;
+}
+
+template<class Sort>
+double run(list_t &l, unsigned seed, Sort sort) {
+  refill(l, seed);
+  auto begin = std::chrono::steady_clock::now();
+  sort(l);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+  unsigned seed = 42;
+  list_t l;
+  for (size_t i = 0; i < n; ++i) l.push_back(next_random(seed));
+  l.sort();// 打散节点的内存次序
+
+  double legacy = run(l, 1, legacy_sort);
+  double links = run(l, 2, [](list_t &x) { x.sort(); });
+  double gathered = run(l, 3, [](list_t &x) { x.sort_gathered(); });
+
+  std::printf("n = %zu\n", n);
+  std::printf("legacy (64 lists)   : %.3f s\n", legacy);
+  std::printf("sort (node links)   : %.3f s  (%.2fx)\n", links, legacy / links);
+  std::printf("sort_gathered       : %.3f s  (%.2fx)\n", gathered, legacy / gathered);
+
+  const int rounds = 200000;
+  list_t small;
+  for (int i = 0; i < 32; ++i) small.push_back(0);
+  legacy = run_small(small, rounds, legacy_sort);
+  links = run_small(small, rounds, [](list_t &x) { x.sort(); });
+  gathered = run_small(small, rounds, [](list_t &x) { x.sort_gathered(); });
+  std::printf("\n%d x 32 elements\n", rounds);
+  std::printf("legacy (64 lists)   : %.3f s\n", legacy);
+  std::printf("sort (node links)   : %.3f s  (%.2fx)\n", links, legacy / links);
+  std::printf("sort_gathered       : %.3f s  (%.2fx)\n", gathered, legacy / gathered);
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+    mpmc_queue 与 mutex + TinySTL::deque 的吞吐量对比
+    用法：bench_mpmc_queue [producers] [consumers] [items_per_producer]
+*/
+#include "SequenceContainers/Deque/stl_deque.h"
+#include "SequenceContainers/MpmcQueue/stl_mpmc_queue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 以互斥量保护的 deque，作为对照组
+class locked_deque {
+ public:
+  bool try_push(int v) {
+    std::lock_guard<std::mutex> lock(m);
+    if (dq.size() >= capacity) return false;
+    dq.push_back(v);
+    return true;
+  }
+  bool try_pop(int &v) {
+    std::lock_guard<std::mutex> lock(m);
+    if (dq.empty()) return false;
+    v = dq.front();
+    dq.pop_front();
+    return true;
+  }
+
+  size_t capacity = 1024;
+
+ private:
+  std::mutex m;
+  TinySTL::deque<int> dq;
+};
+
+template<class Queue>
+double run(Queue &q, int producers, int consumers, int per_producer) {
+  const long long total = static_cast<long long>(producers) * per_producer;
+  std::atomic<long long> received(0);
+  std::atomic<long long> checksum(0);
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&q, per_producer] {
+      for (int i = 0; i < per_producer; ++i)
+        while (!q.try_push(i)) std::this_thread::yield();
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      long long local = 0;
+      int v;
+      while (received.load(std::memory_order_relaxed) < total) {
+        if (q.try_pop(v)) {
+          local += v;
+          received.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      checksum += local;
+    });
+  }
+  for (auto &t : threads) t.join();
+  auto stop = std::chrono::steady_clock::now();
+
+  long long expected = static_cast<long long>(producers) * per_producer * (per_producer - 1) / 2;
+  if (checksum.load() != expected) {
+    std::fprintf(stderr, "checksum mismatch\n");
+    std::exit(1);
+  }
+  double seconds = std::chrono::duration<double>(stop - start).count();
+  return total / seconds;
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  int producers = argc > 1 ? std::atoi(argv[1]) : 4;
+  int consumers = argc > 2 ? std::atoi(argv[2]) : 4;
+  int per_producer = argc > 3 ? std::atoi(argv[3]) : 1000000;
+
+  TinySTL::mpmc_queue<int> mpmc(1024);
+  locked_deque locked;
+
+  double lock_free = run(mpmc, producers, consumers, per_producer);
+  double locked_rate = run(locked, producers, consumers, per_producer);
+
+  std::printf("producers=%d consumers=%d items=%lld\n", producers, consumers,
+              static_cast<long long>(producers) * per_producer);
+  std::printf("mpmc_queue        : %12.0f ops/s\n", lock_free);
+  std::printf("mutex + deque     : %12.0f ops/s\n", locked_rate);
+  std::printf("speedup           : %12.2fx\n", lock_free / locked_rate);
+  return 0;
+}
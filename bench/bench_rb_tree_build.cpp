@@ -0,0 +1,48 @@
+/*
+    有序输入建树：逐个 insert_unique 与线性建树（set 的区间构造 / assign_sorted）的对比
+    用法：bench_rb_tree_build [n]
+*/
+#include "AssociativeContainers/Set/stl_set.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+template<class F>
+double time_it(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? std::atol(argv[1]) : 5000000;
+  TinySTL::vector<long> keys;
+  for (long i = 0; i < n; ++i) keys.push_back(i * 3);
+
+  size_t sink = 0;
+  double one_by_one = time_it([&] {
+    TinySTL::set<long> s;
+    for (long k : keys) s.insert(k);
+    sink += s.size();
+  });
+  double range = time_it([&] {
+    TinySTL::set<long> s(keys.begin(), keys.end());
+    sink += s.size();
+  });
+  double tagged = time_it([&] {
+    TinySTL::set<long> s(TinySTL::assign_sorted, keys.begin(), keys.end());
+    sink += s.size();
+  });
+
+  std::printf("n=%ld (checksum %zu)\n", n, sink);
+  std::printf("insert one by one : %8.3f s\n", one_by_one);
+  std::printf("range ctor        : %8.3f s (%.2fx)\n", range, one_by_one / range);
+  std::printf("assign_sorted     : %8.3f s (%.2fx)\n", tagged, one_by_one / tagged);
+  return 0;
+}
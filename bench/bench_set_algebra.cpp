@@ -0,0 +1,58 @@
+/*
+    有序集合的并、交：逐个插入 / 查找与基于 split / join 的 union_with、intersect_with 的对比
+    用法：bench_set_algebra [n] [m] [threads]
+*/
+#include "AssociativeContainers/Set/stl_set.h"
+#include "Parallel/thread_pool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+template<class F>
+double time_it(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? std::atol(argv[1]) : 1000000;
+  long m = argc > 2 ? std::atol(argv[2]) : 100000;
+  long threads = argc > 3 ? std::atol(argv[3]) : 4;
+  std::mt19937_64 gen(5);
+  TinySTL::set<long> big, small;
+  while (static_cast<long>(big.size()) < n) big.insert(static_cast<long>(gen() % (4 * n)));
+  while (static_cast<long>(small.size()) < m) small.insert(static_cast<long>(gen() % (4 * n)));
+  TinySTL::thread_pool pool(threads);
+
+  // 并：逐个插入 small 与各版本 union_with（右值版本直接链接节点）
+  TinySTL::set<long> u1 = big, u2 = big, u3 = big;
+  TinySTL::set<long> s2 = small, s3 = small;
+  double insert_union = time_it([&] {
+    for (long v : small) u1.insert(v);
+  });
+  double join_union = time_it([&] { u2.union_with(TinySTL::move(s2)); });
+  double par_union = time_it([&] { u3.parallel_union_with(TinySTL::move(s3), pool); });
+
+  // 交：逐个查找后重建与 intersect_with
+  TinySTL::set<long> i1, i2 = big, i3 = big;
+  double find_inter = time_it([&] {
+    for (long v : small)
+      if (big.count(v)) i1.insert(i1.end(), v);
+  });
+  double join_inter = time_it([&] { i2.intersect_with(small); });
+  double par_inter = time_it([&] { i3.parallel_intersect_with(small, pool); });
+
+  std::printf("n = %ld, m = %ld, threads = %ld\n", n, m, threads);
+  std::printf("union:        insert %.4fs  union_with %.4fs  parallel %.4fs  (%zu/%zu/%zu)\n",
+              insert_union, join_union, par_union, u1.size(), u2.size(), u3.size());
+  std::printf("intersection: find   %.4fs  intersect  %.4fs  parallel %.4fs  (%zu/%zu/%zu)\n",
+              find_inter, join_inter, par_inter, i1.size(), i2.size(), i3.size());
+  return u1 == u2 && u2 == u3 && i1 == i2 && i2 == i3 ? 0 : 1;
+}
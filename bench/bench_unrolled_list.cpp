@@ -0,0 +1,63 @@
+/*
+    unrolled_list 与 list 的对比：有序插入与顺序扫描
+    用法：bench_unrolled_list [n]
+*/
+#include "SequenceContainers/List/stl_list.h"
+#include "SequenceContainers/UnrolledList/stl_unrolled_list.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+unsigned next_random(unsigned &seed) {
+  seed = seed * 1664525u + 1013904223u;
+  return seed >> 8;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// 线性查找插入点后插入，保持有序
+template<class List>
+double ordered_insert(List &l, size_t n) {
+  unsigned seed = 1;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < n; ++i) {
+    unsigned x = next_random(seed);
+    auto it = l.begin();
+    while (it != l.end() && *it < x) ++it;
+    l.insert(it, x);
+  }
+  return seconds_since(begin);
+}
+
+template<class List>
+double scan(const List &l, int rounds, unsigned long long &sum) {
+  auto begin = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r)
+    for (unsigned x : l) sum += x;
+  return seconds_since(begin);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+  TinySTL::list<unsigned> l;
+  TinySTL::unrolled_list<unsigned> ul;
+
+  double list_insert = ordered_insert(l, n);
+  double unrolled_insert = ordered_insert(ul, n);
+  unsigned long long s1 = 0, s2 = 0;
+  double list_scan = scan(l, 200, s1);
+  double unrolled_scan = scan(ul, 200, s2);
+
+  std::printf("n = %zu, K = %zu\n", n, TinySTL::unrolled_list<unsigned>::node_capacity);
+  std::printf("ordered insert  list: %.3f s  unrolled_list: %.3f s  (%.2fx)\n", list_insert,
+              unrolled_insert, list_insert / unrolled_insert);
+  std::printf("scan x200       list: %.3f s  unrolled_list: %.3f s  (%.2fx)%s\n", list_scan,
+              unrolled_scan, list_scan / unrolled_scan, s1 == s2 ? "" : "  MISMATCH");
+  return 0;
+}
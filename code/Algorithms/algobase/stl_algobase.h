@@ -13,6 +13,14 @@ namespace TinySTL {
 template<class InputIterator1, class InputIterator2, class BinaryPredicate = equal_to<value_type_t<InputIterator1>>>
 inline bool equal(InputIterator1 first1, InputIterator1 last1,
                   InputIterator2 first2, const BinaryPredicate &binary_pred = BinaryPredicate()) {
+  return _equal(first1, last1, first2, binary_pred,
+                is_segmented_iterator_t<InputIterator1>());
+}
+
+// first2 以引用传入，以便分段版本逐段推进
+template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+inline bool _equal_aux(InputIterator1 first1, InputIterator1 last1,
+                       InputIterator2 &first2, const BinaryPredicate &binary_pred) {
   for (; first1 != last1; ++first1, ++first2) {
     if (!binary_pred(*first1, *first2)) {
       return false;
@@ -21,11 +29,60 @@ inline bool equal(InputIterator1 first1, InputIterator1 last1,
   return true;
 }
 
+template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+inline bool _equal(InputIterator1 first1, InputIterator1 last1,
+                   InputIterator2 first2, const BinaryPredicate &binary_pred,
+                   false_type) {
+  return _equal_aux(first1, last1, first2, binary_pred);
+}
+
+// 分段迭代器：逐段以原始指针比较
+template<class SegmentedIterator, class InputIterator2, class BinaryPredicate>
+bool _equal(SegmentedIterator first1, SegmentedIterator last1,
+            InputIterator2 first2, const BinaryPredicate &binary_pred,
+            true_type) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto sfirst = traits::segment(first1);
+  auto slast = traits::segment(last1);
+  if (sfirst == slast)
+    return _equal_aux(traits::local(first1), traits::local(last1), first2, binary_pred);
+  if (!_equal_aux(traits::local(first1), traits::end(sfirst), first2, binary_pred))
+    return false;
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    if (!_equal_aux(traits::begin(sfirst), traits::end(sfirst), first2, binary_pred))
+      return false;
+  }
+  return _equal_aux(traits::begin(slast), traits::local(last1), first2, binary_pred);
+}
+
 template<class ForwardIterator, class T>
-void fill(ForwardIterator first, ForwardIterator last, const T &value) {
+inline void fill(ForwardIterator first, ForwardIterator last, const T &value) {
+  _fill(first, last, value, is_segmented_iterator_t<ForwardIterator>());
+}
+
+template<class ForwardIterator, class T>
+inline void _fill(ForwardIterator first, ForwardIterator last, const T &value,
+                  false_type) {
   for (; first != last; ++first) *first = value;
 }
 
+// 分段迭代器：段内为紧凑的指针循环，便于编译器向量化
+template<class SegmentedIterator, class T>
+void _fill(SegmentedIterator first, SegmentedIterator last, const T &value,
+           true_type) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    _fill(traits::local(first), traits::local(last), value, false_type());
+    return;
+  }
+  _fill(traits::local(first), traits::end(sfirst), value, false_type());
+  for (++sfirst; sfirst != slast; ++sfirst)
+    _fill(traits::begin(sfirst), traits::end(sfirst), value, false_type());
+  _fill(traits::begin(slast), traits::local(last), value, false_type());
+}
+
 // 显然，本算法执行覆写操作，因此通常配合inserter完成
 template<class OutputIterator, class Size, class T>
 OutputIterator fill_n(OutputIterator first, Size n, const T &value) {
@@ -162,10 +219,71 @@ struct _copy_dispatch<const T *, T *> {
 template<class InputIterator, class OutputIterator>
 inline OutputIterator copy(InputIterator first, InputIterator last,
                            OutputIterator result) {
+  // 先按是否为分段迭代器拆分区间，再交由 _copy_dispatch
+  return _copy_segmented(first, last, result,
+                         is_segmented_iterator_t<InputIterator>(),
+                         is_segmented_iterator_t<OutputIterator>());
+}
+
+template<class InputIterator, class OutputIterator>
+inline OutputIterator _copy_segmented(InputIterator first, InputIterator last,
+                                      OutputIterator result, false_type,
+                                      false_type) {
   return _copy_dispatch<InputIterator, OutputIterator>()(
       first, last, result);// _copy_dispatch是一个仿函数对象
 }
 
+// 来源为分段迭代器：逐段以原始指针区间复制（目的端若分段则由下一层处理）
+template<class SegmentedIterator, class OutputIterator, class OutputSegmented>
+OutputIterator _copy_segmented(SegmentedIterator first, SegmentedIterator last,
+                               OutputIterator result, true_type,
+                               OutputSegmented) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast)
+    return TinySTL::copy(traits::local(first), traits::local(last), result);
+  result = TinySTL::copy(traits::local(first), traits::end(sfirst), result);
+  for (++sfirst; sfirst != slast; ++sfirst)
+    result = TinySTL::copy(traits::begin(sfirst), traits::end(sfirst), result);
+  return TinySTL::copy(traits::begin(slast), traits::local(last), result);
+}
+
+// 目的端为分段迭代器：来源可随机访问时按目的段切块
+template<class InputIterator, class SegmentedIterator>
+inline SegmentedIterator _copy_segmented(InputIterator first, InputIterator last,
+                                         SegmentedIterator result, false_type,
+                                         true_type) {
+  return _copy_to_segmented(first, last, result,
+                            iterator_category_t<InputIterator>());
+}
+
+template<class InputIterator, class SegmentedIterator>
+inline SegmentedIterator _copy_to_segmented(InputIterator first,
+                                            InputIterator last,
+                                            SegmentedIterator result,
+                                            input_iterator_tag) {
+  return _copy_dispatch<InputIterator, SegmentedIterator>()(first, last, result);
+}
+
+template<class RandomAccessIterator, class SegmentedIterator>
+SegmentedIterator _copy_to_segmented(RandomAccessIterator first,
+                                     RandomAccessIterator last,
+                                     SegmentedIterator result,
+                                     random_access_iterator_tag) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto seg = traits::segment(result);
+  auto cur = traits::local(result);
+  while (first != last) {
+    if (cur == traits::end(seg)) cur = traits::begin(++seg);
+    const ptrdiff_t n = TinySTL::min(static_cast<ptrdiff_t>(last - first),
+                                     static_cast<ptrdiff_t>(traits::end(seg) - cur));
+    cur = TinySTL::copy(first, first + n, cur);
+    first += n;
+  }
+  return traits::compose(seg, cur);
+}
+
 // 针对指针的偏特化
 inline char *copy(const char *first, const char *last, char *result) {
   memmove(result, first, last - first);
@@ -268,20 +386,106 @@ struct _copy_backward_dispatch<const T *, T *, true_type> {
 
 template<class BI1, class BI2>
 inline BI2 copy_backward(BI1 first, BI1 last, BI2 result) {
+  return _copy_backward_segmented(first, last, result,
+                                  is_segmented_iterator_t<BI1>(),
+                                  is_segmented_iterator_t<BI2>());
+}
+
+template<class BI1, class BI2>
+inline BI2 _copy_backward_segmented(BI1 first, BI1 last, BI2 result,
+                                    false_type, false_type) {
   using Trivial = typename type_traits<
       value_type_t<BI2>>::has_trivial_assignment_operator;
   return _copy_backward_dispatch<BI1, BI2, Trivial>()(first, last, result);
 }
 
-template<typename T>
-decltype(auto) move(T &&param) {
-  using ReturnType = remove_reference_t<T> &&;
-  return static_cast<ReturnType>(param);
+// 来源为分段迭代器：自最后一段起逐段向前复制
+template<class SegmentedIterator, class BI2, class OutputSegmented>
+BI2 _copy_backward_segmented(SegmentedIterator first, SegmentedIterator last,
+                             BI2 result, true_type, OutputSegmented) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast)
+    return TinySTL::copy_backward(traits::local(first), traits::local(last), result);
+  result = TinySTL::copy_backward(traits::begin(slast), traits::local(last), result);
+  for (--slast; slast != sfirst; --slast)
+    result = TinySTL::copy_backward(traits::begin(slast), traits::end(slast), result);
+  return TinySTL::copy_backward(traits::local(first), traits::end(sfirst), result);
+}
+
+template<class BI1, class SegmentedIterator>
+inline SegmentedIterator _copy_backward_segmented(BI1 first, BI1 last,
+                                                  SegmentedIterator result,
+                                                  false_type, true_type) {
+  return _copy_backward_to_segmented(first, last, result,
+                                     iterator_category_t<BI1>());
 }
 
-template<typename T>
-T &&forward(remove_reference_t<T> &param) {
-  return static_cast<T &&>(param);
+template<class BI1, class SegmentedIterator>
+inline SegmentedIterator _copy_backward_to_segmented(BI1 first, BI1 last,
+                                                     SegmentedIterator result,
+                                                     bidirectional_iterator_tag) {
+  return _copy_backward_segmented(first, last, result, false_type(), false_type());
+}
+
+// 目的端为分段迭代器：按目的段自后向前切块
+template<class RandomAccessIterator, class SegmentedIterator>
+SegmentedIterator _copy_backward_to_segmented(RandomAccessIterator first,
+                                              RandomAccessIterator last,
+                                              SegmentedIterator result,
+                                              random_access_iterator_tag) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto seg = traits::segment(result);
+  auto cur = traits::local(result);
+  while (first != last) {
+    if (cur == traits::begin(seg)) cur = traits::end(--seg);
+    const ptrdiff_t n = TinySTL::min(static_cast<ptrdiff_t>(last - first),
+                                     static_cast<ptrdiff_t>(cur - traits::begin(seg)));
+    cur = TinySTL::copy_backward(last - n, last, cur);
+    last -= n;
+  }
+  return traits::compose(seg, cur);
+}
+
+// 区间 move：具备 trivial assignment 的元素退化为 copy（可走 memmove 及分段路径）
+template<class InputIterator, class OutputIterator>
+inline OutputIterator move(InputIterator first, InputIterator last,
+                           OutputIterator result) {
+  using Trivial = typename type_traits<
+      value_type_t<InputIterator>>::has_trivial_assignment_operator;
+  return _move(first, last, result, Trivial());
+}
+
+template<class InputIterator, class OutputIterator>
+inline OutputIterator _move(InputIterator first, InputIterator last,
+                            OutputIterator result, true_type) {
+  return TinySTL::copy(first, last, result);
+}
+
+template<class InputIterator, class OutputIterator>
+inline OutputIterator _move(InputIterator first, InputIterator last,
+                            OutputIterator result, false_type) {
+  for (; first != last; ++first, ++result) *result = TinySTL::move(*first);
+  return result;
+}
+
+template<class BI1, class BI2>
+inline BI2 move_backward(BI1 first, BI1 last, BI2 result) {
+  using Trivial =
+      typename type_traits<value_type_t<BI1>>::has_trivial_assignment_operator;
+  return _move_backward(first, last, result, Trivial());
+}
+
+template<class BI1, class BI2>
+inline BI2 _move_backward(BI1 first, BI1 last, BI2 result, true_type) {
+  return TinySTL::copy_backward(first, last, result);
+}
+
+template<class BI1, class BI2>
+inline BI2 _move_backward(BI1 first, BI1 last, BI2 result, false_type) {
+  while (first != last) *--result = TinySTL::move(*--last);
+  return result;
 }
 
 }// namespace TinySTL
\ No newline at end of file
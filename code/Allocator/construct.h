@@ -10,17 +10,18 @@
 #pragma once
 #include <new>  // placement new
 
+#include "Iterator/stl_iterator.h"
 #include "Utils/type_traits.h"
 
 namespace TinySTL {
 
 /*
-    将T2类型的初值设到T1类型指针所指的空间上
+    以 args 为构造参数，在T1类型指针所指的空间上构造对象
     只构造，不分配内存
 */
-template<class T1, class T2>
-inline void construct(T1* p, T2 value) {
-    new (p) T1(value);
+template<class T1, class... Args>
+inline void construct(T1* p, Args&&... args) {
+    new (p) T1(TinySTL::forward<Args>(args)...);
 }
 
 /*
@@ -33,10 +34,12 @@ inline void destroy(T* p) {
 
 /*
     利用traits批量析构对象
+    注意应当萃取元素（value_type）的类型，而非迭代器本身的类型
 */
 template<class ForwardIterator>
 inline void destroy(ForwardIterator first, ForwardIterator last) {
-    using is_POD_type = typename type_traits<ForwardIterator>::is_POD_type;
+    using is_POD_type =
+        typename type_traits<value_type_t<ForwardIterator>>::is_POD_type;
     _destroy_aux(first, last, is_POD_type());
 }
 
@@ -46,7 +49,7 @@ inline void destroy(ForwardIterator first, ForwardIterator last) {
 template<class ForwardIterator>
 inline void _destroy_aux(ForwardIterator first, ForwardIterator last,
                         false_type) {
-    for (; first != last; ++ first) destroy(&*first);   //迭代器不是真正的地址
+    _destroy_segmented(first, last, is_segmented_iterator_t<ForwardIterator>());
 }
 
 /*
@@ -57,6 +60,31 @@ template<class ForwardIterator>
 inline void _destroy_aux(ForwardIterator first, ForwardIterator last,
                         true_type) {}
 
+template<class ForwardIterator>
+inline void _destroy_segmented(ForwardIterator first, ForwardIterator last,
+                               false_type) {
+    for (; first != last; ++ first) destroy(&*first);   //迭代器不是真正的地址
+}
+
+/*
+    分段迭代器（如 deque）逐段析构，段内以指针遍历
+*/
+template<class SegmentedIterator>
+void _destroy_segmented(SegmentedIterator first, SegmentedIterator last,
+                        true_type) {
+    using traits = segmented_iterator_traits<SegmentedIterator>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast) {
+        _destroy_segmented(traits::local(first), traits::local(last), false_type());
+        return;
+    }
+    _destroy_segmented(traits::local(first), traits::end(sfirst), false_type());
+    for (++sfirst; sfirst != slast; ++sfirst)
+        _destroy_segmented(traits::begin(sfirst), traits::end(sfirst), false_type());
+    _destroy_segmented(traits::begin(slast), traits::local(last), false_type());
+}
+
 /* 特化 */
 inline void destroy(char*, char*) {}
 inline void destroy(wchar_t*, wchar_t*) {}
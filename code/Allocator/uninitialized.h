@@ -29,11 +29,90 @@ inline ForwardIterator _uninitialized_copy_aux(InputIterator first,
                                                InputIterator last,
                                                ForwardIterator result,
                                                false_type) {
+  return _uninitialized_copy_segmented(
+      first, last, result, is_segmented_iterator_t<InputIterator>(),
+      is_segmented_iterator_t<ForwardIterator>());
+}
+
+template<class InputIterator, class ForwardIterator>
+inline ForwardIterator _uninitialized_copy_segmented(InputIterator first,
+                                                     InputIterator last,
+                                                     ForwardIterator result,
+                                                     false_type, false_type) {
   ForwardIterator cur = result;
   for (; first != last; ++cur, ++first) construct(&*cur, *first);
   return cur;
 }
 
+// 来源为分段迭代器：逐段复制，失败时析构此前各段已构造的元素
+template<class SegmentedIterator, class ForwardIterator, class OutputSegmented>
+ForwardIterator _uninitialized_copy_segmented(SegmentedIterator first,
+                                              SegmentedIterator last,
+                                              ForwardIterator result,
+                                              true_type, OutputSegmented) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast)
+    return TinySTL::uninitialized_copy(traits::local(first),
+                                       traits::local(last), result);
+  ForwardIterator cur = result;
+  try {
+    cur = TinySTL::uninitialized_copy(traits::local(first),
+                                      traits::end(sfirst), cur);
+    for (++sfirst; sfirst != slast; ++sfirst)
+      cur = TinySTL::uninitialized_copy(traits::begin(sfirst),
+                                        traits::end(sfirst), cur);
+    return TinySTL::uninitialized_copy(traits::begin(slast),
+                                       traits::local(last), cur);
+  } catch (std::exception &) {
+    TinySTL::destroy(result, cur);
+    throw;
+  }
+}
+
+template<class InputIterator, class SegmentedIterator>
+inline SegmentedIterator _uninitialized_copy_segmented(InputIterator first,
+                                                       InputIterator last,
+                                                       SegmentedIterator result,
+                                                       false_type, true_type) {
+  return _uninitialized_copy_to_segmented(first, last, result,
+                                          iterator_category_t<InputIterator>());
+}
+
+template<class InputIterator, class SegmentedIterator>
+inline SegmentedIterator _uninitialized_copy_to_segmented(
+    InputIterator first, InputIterator last, SegmentedIterator result,
+    input_iterator_tag) {
+  return _uninitialized_copy_segmented(first, last, result, false_type(),
+                                       false_type());
+}
+
+// 目的端为分段迭代器：按目的段切块
+template<class RandomAccessIterator, class SegmentedIterator>
+SegmentedIterator _uninitialized_copy_to_segmented(RandomAccessIterator first,
+                                                   RandomAccessIterator last,
+                                                   SegmentedIterator result,
+                                                   random_access_iterator_tag) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto seg = traits::segment(result);
+  auto cur = traits::local(result);
+  try {
+    while (first != last) {
+      if (cur == traits::end(seg)) cur = traits::begin(++seg);
+      const ptrdiff_t n =
+          TinySTL::min(static_cast<ptrdiff_t>(last - first),
+                       static_cast<ptrdiff_t>(traits::end(seg) - cur));
+      cur = TinySTL::uninitialized_copy(first, first + n, cur);
+      first += n;
+    }
+  } catch (std::exception &) {
+    TinySTL::destroy(result, traits::compose(seg, cur));
+    throw;
+  }
+  return traits::compose(seg, cur);
+}
+
 //针对char*、wchar_t*存在特化版本 memmove直接移动内存
 inline char *uninitialized_copy(const char *first, const char *last,
                                 char *result) {
@@ -63,12 +142,44 @@ inline void _uninitialized_fill_aux(ForwardIterator first,
 }
 
 template<class ForwardIterator, class T>
-void _uninitialized_fill_aux(ForwardIterator first, ForwardIterator last,
-                             const T &value, false_type) {
+inline void _uninitialized_fill_aux(ForwardIterator first, ForwardIterator last,
+                                    const T &value, false_type) {
+  _uninitialized_fill_segmented(first, last, value,
+                                is_segmented_iterator_t<ForwardIterator>());
+}
+
+template<class ForwardIterator, class T>
+void _uninitialized_fill_segmented(ForwardIterator first, ForwardIterator last,
+                                   const T &value, false_type) {
   ForwardIterator cur = first;
   for (; cur != last; ++cur) construct(&*cur, value);
 }
 
+// 分段迭代器：逐段填充，失败时析构此前各段已构造的元素
+template<class SegmentedIterator, class T>
+void _uninitialized_fill_segmented(SegmentedIterator first,
+                                   SegmentedIterator last, const T &value,
+                                   true_type) {
+  using traits = segmented_iterator_traits<SegmentedIterator>;
+  auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    TinySTL::uninitialized_fill(traits::local(first), traits::local(last), value);
+    return;
+  }
+  auto cur = sfirst;
+  try {
+    TinySTL::uninitialized_fill(traits::local(first), traits::end(cur), value);
+    for (++cur; cur != slast; ++cur)
+      TinySTL::uninitialized_fill(traits::begin(cur), traits::end(cur), value);
+    TinySTL::uninitialized_fill(traits::begin(slast), traits::local(last), value);
+  } catch (std::exception &) {
+    if (cur != sfirst)
+      TinySTL::destroy(first, traits::compose(cur, traits::begin(cur)));
+    throw;
+  }
+}
+
 template<class ForwardIterator, class Size, class T>
 inline ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n,
                                             const T &value) {
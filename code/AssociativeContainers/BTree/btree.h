@@ -0,0 +1,776 @@
+/*
+btree: B 树，btree_map / btree_set 及其 multi 版本的底层结构，接口与 rb_tree 对应
+每个节点约占 256 字节（4 条 cache line），在一个连续数组中保存至多 N 个值：
+    leaf     : {parent, position, count, leaf, values[N]}
+    internal : leaf + children[N + 1]
+与 rb_tree 每个元素一个节点相比，配置次数与指针开销均摊到 N 个元素上，
+一次查找只需经过 log_N(n) 个节点；节点内对算术类型的键做无分支的线性计数（便于编译器向量化），
+其余类型做二分查找。
+
+迭代器由（节点，下标）组成，end() 为（root，root->count）。
+插入会使所有迭代器失效（节点分裂时元素会搬移），删除同样如此；erase 返回指向后继的迭代器。
+*/
+#pragma once
+
+#include "Algorithms/algobase/stl_algobase.h"
+#include "Allocator/allocator.h"
+#include "Allocator/construct.h"
+#include "Function/function_adapter.h"
+#include "Iterator/stl_iterator.h"
+#include "Utils/type_traits.h"
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+
+namespace TinySTL {
+
+// 每个节点约 256 字节，至少容纳 3 个值，count 以 unsigned short 计数
+constexpr size_t _btree_node_values(size_t value_size) {
+  return (256 - 16) / value_size < 3     ? size_t(3)
+         : (256 - 16) / value_size > 255 ? size_t(255)
+                                         : (256 - 16) / value_size;
+}
+
+template<class Value, size_t N>
+struct _btree_node {
+  _btree_node *parent;
+  unsigned short position;// 在父节点 children 中的下标
+  unsigned short count;   // 值的个数
+  bool leaf;
+  alignas(Value) unsigned char storage[sizeof(Value) * N];
+
+  Value *values() { return reinterpret_cast<Value *>(storage); }
+  Value &value(size_t i) { return values()[i]; }
+  _btree_node *&child(size_t i);
+};
+
+template<class Value, size_t N>
+struct _btree_internal_node : _btree_node<Value, N> {
+  _btree_node<Value, N> *children[N + 1];
+};
+
+template<class Value, size_t N>
+inline _btree_node<Value, N> *&_btree_node<Value, N>::child(size_t i) {
+  return static_cast<_btree_internal_node<Value, N> *>(this)->children[i];
+}
+
+template<class Value, size_t N, class Ref, class Ptr>
+struct btree_iterator {
+  using iterator = btree_iterator<Value, N, Value &, Value *>;
+  using const_iterator = btree_iterator<Value, N, const Value &, const Value *>;
+  using self = btree_iterator;
+
+  using iterator_category = bidirectional_iterator_tag;
+  using value_type = Value;
+  using pointer = Ptr;
+  using reference = Ref;
+  using difference_type = ptrdiff_t;
+  using node_ptr = _btree_node<Value, N> *;
+
+  // data member
+  node_ptr node;
+  size_t pos;
+
+  // ctor
+  btree_iterator() : node(nullptr), pos(0) {}
+  btree_iterator(node_ptr x, size_t i) : node(x), pos(i) {}
+  btree_iterator(const iterator &rhs) : node(rhs.node), pos(rhs.pos) {}
+
+  reference operator*() const { return node->value(pos); }
+  pointer operator->() const { return &(operator*()); }
+
+  // 内部节点的后继为右子树的最左值；叶节点走到末尾后上溯到第一个不是最后一个孩子的祖先
+  void increment() {
+    if (!node->leaf) {
+      node = node->child(pos + 1);
+      while (!node->leaf) node = node->child(0);
+      pos = 0;
+      return;
+    }
+    if (++pos < node->count) return;
+    while (pos == node->count && node->parent) {
+      pos = node->position;
+      node = node->parent;
+    }
+  }
+  void decrement() {
+    if (!node->leaf) {
+      node = node->child(pos);
+      while (!node->leaf) node = node->child(node->count);
+      pos = node->count - 1;
+      return;
+    }
+    while (pos == 0 && node->parent) {
+      pos = node->position;
+      node = node->parent;
+    }
+    --pos;
+  }
+
+  self &operator++() {
+    increment();
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    increment();
+    return temp;
+  }
+  self &operator--() {
+    decrement();
+    return *this;
+  }
+  self operator--(int) {
+    self temp = *this;
+    decrement();
+    return temp;
+  }
+};
+
+template<class Value, size_t N, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator==(const btree_iterator<Value, N, RefL, PtrL> &lhs,
+                       const btree_iterator<Value, N, RefR, PtrR> &rhs) {
+  return lhs.node == rhs.node && lhs.pos == rhs.pos;
+}
+
+template<class Value, size_t N, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator!=(const btree_iterator<Value, N, RefL, PtrL> &lhs,
+                       const btree_iterator<Value, N, RefR, PtrR> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare,
+         class Alloc = simpleAlloc<Value>>
+class btree {
+ public:
+  static constexpr size_t node_values = _btree_node_values(sizeof(Value));
+
+ private:
+  static constexpr size_t N = node_values;
+  static constexpr size_t min_values = N / 2;// 非根节点删除后低于此值时合并或借值
+  using node_type = _btree_node<Value, N>;
+  using internal_type = _btree_internal_node<Value, N>;
+  using node_ptr = node_type *;
+  using leaf_allocator = simpleAlloc<node_type>;
+  using internal_allocator = simpleAlloc<internal_type>;
+  // 算术类型的键配合 less/greater 时，节点内做线性计数
+  using linear_search = bool_constant<std::is_arithmetic<Key>::value &&
+                                      (std::is_same<Compare, less<Key>>::value ||
+                                       std::is_same<Compare, greater<Key>>::value)>;
+
+ public:// basic type
+  using key_type = Key;
+  using value_type = Value;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+ public:// iterator
+  using iterator = btree_iterator<Value, N, Value &, Value *>;
+  using const_iterator = btree_iterator<Value, N, const Value &, const Value *>;
+  using reverse_iterator = __reverse_iterator<iterator>;
+  using const_reverse_iterator = __reverse_iterator<const_iterator>;
+
+ private:// data member
+  node_ptr root_;
+  size_type node_count;
+  Compare key_compare;
+
+ private:// operations of node
+  static const Key &key(node_ptr x, size_type i) { return KeyOfValue()(x->value(i)); }
+  static void relocate(Value *src, Value *dst) {
+    TinySTL::construct(dst, TinySTL::move(*src));
+    TinySTL::destroy(src);
+  }
+  static node_ptr new_node(bool leaf, node_ptr parent) {
+    node_ptr x = leaf ? leaf_allocator::allocate()
+                      : static_cast<node_ptr>(internal_allocator::allocate());
+    x->parent = parent;
+    x->position = 0;
+    x->count = 0;
+    x->leaf = leaf;
+    return x;
+  }
+  static void free_node(node_ptr x) {
+    if (x->leaf)
+      leaf_allocator::deallocate(x);
+    else
+      internal_allocator::deallocate(static_cast<internal_type *>(x));
+  }
+  static void set_child(node_ptr x, size_type i, node_ptr c) {
+    x->child(i) = c;
+    c->parent = x;
+    c->position = static_cast<unsigned short>(i);
+  }
+  static void destroy_subtree(node_ptr x) noexcept;
+  node_ptr clone(node_ptr src, node_ptr parent);
+
+ private:// search in node
+  size_type lower_in(node_ptr x, const Key &k) const {
+    if constexpr (linear_search::value) {
+      size_type n = 0;
+      for (size_type i = 0; i < x->count; ++i) n += key_compare(key(x, i), k);
+      return n;
+    } else {
+      size_type lo = 0, hi = x->count;
+      while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (key_compare(key(x, mid), k))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return lo;
+    }
+  }
+  size_type upper_in(node_ptr x, const Key &k) const {
+    if constexpr (linear_search::value) {
+      size_type n = 0;
+      for (size_type i = 0; i < x->count; ++i) n += !key_compare(k, key(x, i));
+      return n;
+    } else {
+      size_type lo = 0, hi = x->count;
+      while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (!key_compare(k, key(x, mid)))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return lo;
+    }
+  }
+  // (x, pos) 越过节点末尾时上溯，得到中序意义下的同一位置
+  static iterator normalize(node_ptr x, size_type pos) {
+    while (pos == x->count && x->parent) {
+      pos = x->position;
+      x = x->parent;
+    }
+    return iterator(x, pos);
+  }
+  node_ptr rightmost_leaf() const {
+    node_ptr x = root_;
+    while (!x->leaf) x = x->child(x->count);
+    return x;
+  }
+
+ private:// aux interface for insert && erase
+  // 节点内 [i, count) 右移一格，内部节点的 children (i, count] 随之右移
+  static void shift_right(node_ptr x, size_type i);
+  // 删去节点内第 i 个值（已析构或已搬走）与 children[i + 1]
+  static void shift_left(node_ptr x, size_type i);
+  node_ptr split(node_ptr x, size_type &pos);
+  template<class... Args>
+  iterator insert_leaf(node_ptr x, size_type pos, Args &&...args);
+  void merge_into_left(node_ptr left, node_ptr x);
+  void borrow_from_right(node_ptr x, node_ptr right, iterator &res);
+  void borrow_from_left(node_ptr x, node_ptr left, iterator &res);
+  iterator rebalance_after_erase(node_ptr x, size_type pos);
+
+ public:// ctor && dtor
+  btree() : root_(nullptr), node_count(0), key_compare() {}
+  explicit btree(const Compare &comp) : root_(nullptr), node_count(0), key_compare(comp) {}
+  btree(const btree &rhs) : root_(nullptr), node_count(0), key_compare(rhs.key_compare) {
+    if (rhs.root_) root_ = clone(rhs.root_, nullptr);
+    node_count = rhs.node_count;
+  }
+  btree(btree &&rhs) noexcept : root_(nullptr), node_count(0), key_compare(rhs.key_compare) {
+    swap(rhs);
+  }
+  btree &operator=(const btree &rhs) {
+    // copy-and-swap
+    btree temp(rhs);
+    swap(temp);
+    return *this;
+  }
+  btree &operator=(btree &&rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+  ~btree() { clear(); }
+
+  void swap(btree &rhs) noexcept {
+    TinySTL::swap(root_, rhs.root_);
+    TinySTL::swap(node_count, rhs.node_count);
+    TinySTL::swap(key_compare, rhs.key_compare);
+  }
+
+ public:// getter
+  const_iterator begin() const noexcept { return const_cast<btree *>(this)->begin(); }
+  const_iterator end() const noexcept { return const_cast<btree *>(this)->end(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+  bool empty() const noexcept { return node_count == 0; }
+  size_type size() const noexcept { return node_count; }
+  size_type max_size() const noexcept { return size_type(-1) / sizeof(Value); }
+  Compare key_comp() const noexcept { return key_compare; }
+
+ public:// setter
+  iterator begin() noexcept {
+    if (!root_) return end();
+    node_ptr x = root_;
+    while (!x->leaf) x = x->child(0);
+    return iterator(x, 0);
+  }
+  iterator end() noexcept { return root_ ? iterator(root_, root_->count) : iterator(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+ public:// insert
+  pair<iterator, bool> insert_unique(const value_type &);
+  // 提示为 end() 且新键大于所有键时直接追加到最右叶节点，其余情况忽略提示
+  iterator insert_unique(iterator, const value_type &);
+  template<class InputIterator>
+  void insert_unique(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) insert_unique(end(), *first);
+  }
+  iterator insert_equal(const value_type &);
+  iterator insert_equal(iterator, const value_type &);
+  template<class InputIterator>
+  void insert_equal(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) insert_equal(end(), *first);
+  }
+
+ public:// erase
+  iterator erase(iterator);
+  size_type erase(const key_type &);
+  iterator erase(iterator, iterator);
+  void clear() noexcept {
+    if (root_) destroy_subtree(root_);
+    root_ = nullptr;
+    node_count = 0;
+  }
+
+ public:// find
+  iterator lower_bound(const key_type &) noexcept;
+  const_iterator lower_bound(const key_type &k) const noexcept {
+    return const_cast<btree *>(this)->lower_bound(k);
+  }
+  iterator upper_bound(const key_type &) noexcept;
+  const_iterator upper_bound(const key_type &k) const noexcept {
+    return const_cast<btree *>(this)->upper_bound(k);
+  }
+  iterator find(const key_type &k) noexcept {
+    iterator it = lower_bound(k);
+    return it == end() || key_compare(k, KeyOfValue()(*it)) ? end() : it;
+  }
+  const_iterator find(const key_type &k) const noexcept {
+    return const_cast<btree *>(this)->find(k);
+  }
+  size_type count(const key_type &k) const noexcept {
+    pair<const_iterator, const_iterator> p = equal_range(k);
+    return TinySTL::distance(p.first, p.second);
+  }
+  pair<iterator, iterator> equal_range(const key_type &k) noexcept {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+  pair<const_iterator, const_iterator> equal_range(const key_type &k) const noexcept {
+    return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+  }
+
+ public:// debug
+  // 检查节点内外的键值次序、父子链接、叶节点等深与元素总数
+  bool verify() const noexcept;
+
+ private:
+  bool verify_node(node_ptr x, const Key *lo, const Key *hi, size_type depth,
+                   size_type &leaf_depth, size_type &n) const noexcept;
+};
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void btree<Key, Value, KeyOfValue, Compare, Alloc>::destroy_subtree(node_ptr x) noexcept {
+  if (!x->leaf)
+    for (size_type i = 0; i <= x->count; ++i) destroy_subtree(x->child(i));
+  TinySTL::destroy(x->values(), x->values() + x->count);
+  free_node(x);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::node_ptr
+btree<Key, Value, KeyOfValue, Compare, Alloc>::clone(node_ptr src, node_ptr parent) {
+  node_ptr x = new_node(src->leaf, parent);
+  x->position = src->position;
+  size_type copied = 0;
+  try {
+    for (; x->count < src->count; ++x->count) TinySTL::construct(&x->value(x->count), src->value(x->count));
+    if (!x->leaf)
+      for (; copied <= src->count; ++copied) x->child(copied) = clone(src->child(copied), x);
+  } catch (std::exception &) {
+    for (size_type i = 0; i < copied; ++i) destroy_subtree(x->child(i));
+    TinySTL::destroy(x->values(), x->values() + x->count);
+    free_node(x);
+    throw;
+  }
+  return x;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void btree<Key, Value, KeyOfValue, Compare, Alloc>::shift_right(node_ptr x, size_type i) {
+  for (size_type j = x->count; j > i; --j) relocate(&x->value(j - 1), &x->value(j));
+  if (!x->leaf)
+    for (size_type j = x->count + 1; j > i + 1; --j) set_child(x, j, x->child(j - 1));
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void btree<Key, Value, KeyOfValue, Compare, Alloc>::shift_left(node_ptr x, size_type i) {
+  for (size_type j = i + 1; j < x->count; ++j) relocate(&x->value(j), &x->value(j - 1));
+  if (!x->leaf)
+    for (size_type j = i + 2; j <= x->count; ++j) set_child(x, j - 1, x->child(j));
+  --x->count;
+}
+
+// x 已满：先确保父节点有空位，再把 x 分裂为 x 与新的右兄弟 y，中值上移至父节点。
+// 按插入位置偏置分裂点：顺序追加时左侧保持满载，逆序插入时右侧保持满载。
+// 返回待插入值所在的节点，并把 pos 修正为其中的下标
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::node_ptr
+btree<Key, Value, KeyOfValue, Compare, Alloc>::split(node_ptr x, size_type &pos) {
+  const size_type keep = pos == N ? N - 1 : pos == 0 ? 0 : N / 2;
+  node_ptr parent = x->parent;
+  if (!parent) {
+    parent = new_node(false, nullptr);
+    set_child(parent, 0, x);
+    root_ = parent;
+  }
+  size_type ppos = x->position;
+  if (parent->count == N) parent = split(parent, ppos);
+
+  node_ptr y = new_node(x->leaf, parent);
+  for (size_type j = keep + 1; j < N; ++j) relocate(&x->value(j), &y->value(j - keep - 1));
+  if (!x->leaf)
+    for (size_type j = keep + 1; j <= N; ++j) set_child(y, j - keep - 1, x->child(j));
+  y->count = static_cast<unsigned short>(N - keep - 1);
+
+  shift_right(parent, ppos);
+  relocate(&x->value(keep), &parent->value(ppos));
+  ++parent->count;
+  set_child(parent, ppos + 1, y);
+  x->count = static_cast<unsigned short>(keep);
+
+  if (pos <= keep) return x;
+  pos -= keep + 1;
+  return y;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class... Args>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::insert_leaf(node_ptr x, size_type pos,
+                                                           Args &&...args) {
+  if (x->count == N) x = split(x, pos);
+  shift_right(x, pos);
+  try {
+    TinySTL::construct(&x->value(pos), TinySTL::forward<Args>(args)...);
+  } catch (std::exception &) {
+    // 构造失败：把空位重新合拢
+    for (size_type j = pos + 1; j <= x->count; ++j) relocate(&x->value(j), &x->value(j - 1));
+    throw;
+  }
+  ++x->count;
+  ++node_count;
+  return iterator(x, pos);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+pair<typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator, bool>
+btree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(const value_type &val) {
+  if (!root_) root_ = new_node(true, nullptr);
+  const Key &k = KeyOfValue()(val);
+  node_ptr x = root_;
+  for (;;) {
+    size_type i = lower_in(x, k);
+    if (i < x->count && !key_compare(k, key(x, i)))// 存在相同键值
+      return pair<iterator, bool>(iterator(x, i), false);
+    if (x->leaf) return pair<iterator, bool>(insert_leaf(x, i, val), true);
+    x = x->child(i);
+  }
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(iterator pos,
+                                                             const value_type &val) {
+  if (pos == end() && root_ && node_count > 0) {
+    node_ptr x = rightmost_leaf();
+    if (key_compare(key(x, x->count - 1), KeyOfValue()(val))) return insert_leaf(x, x->count, val);
+  }
+  return insert_unique(val).first;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(const value_type &val) {
+  if (!root_) root_ = new_node(true, nullptr);
+  const Key &k = KeyOfValue()(val);
+  node_ptr x = root_;
+  for (;;) {
+    size_type i = upper_in(x, k);// 插于等值元素之后
+    if (x->leaf) return insert_leaf(x, i, val);
+    x = x->child(i);
+  }
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(iterator pos,
+                                                            const value_type &val) {
+  if (pos == end() && root_ && node_count > 0) {
+    node_ptr x = rightmost_leaf();
+    if (!key_compare(KeyOfValue()(val), key(x, x->count - 1))) return insert_leaf(x, x->count, val);
+  }
+  return insert_equal(val);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::lower_bound(const key_type &k) noexcept {
+  if (!root_) return end();
+  node_ptr x = root_;
+  size_type i;
+  for (;;) {
+    i = lower_in(x, k);
+    if (x->leaf) break;
+    x = x->child(i);
+  }
+  return normalize(x, i);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::upper_bound(const key_type &k) noexcept {
+  if (!root_) return end();
+  node_ptr x = root_;
+  size_type i;
+  for (;;) {
+    i = upper_in(x, k);
+    if (x->leaf) break;
+    x = x->child(i);
+  }
+  return normalize(x, i);
+}
+
+// 把 x 连同父节点中的分隔值并入其左兄弟 left，释放 x
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void btree<Key, Value, KeyOfValue, Compare, Alloc>::merge_into_left(node_ptr left, node_ptr x) {
+  node_ptr parent = x->parent;
+  const size_type sep = x->position - 1;
+  const size_type base = left->count;
+  relocate(&parent->value(sep), &left->value(base));
+  for (size_type j = 0; j < x->count; ++j) relocate(&x->value(j), &left->value(base + 1 + j));
+  if (!x->leaf)
+    for (size_type j = 0; j <= x->count; ++j) set_child(left, base + 1 + j, x->child(j));
+  left->count = static_cast<unsigned short>(base + 1 + x->count);
+  shift_left(parent, sep);
+  free_node(x);
+}
+
+// 从右兄弟借入若干值，使两者大致均分
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void btree<Key, Value, KeyOfValue, Compare, Alloc>::borrow_from_right(node_ptr x, node_ptr right,
+                                                                      iterator &res) {
+  node_ptr parent = x->parent;
+  const size_type sep = x->position;
+  const size_type base = x->count;
+  const size_type k = (right->count - x->count + 1) / 2;
+  relocate(&parent->value(sep), &x->value(base));
+  for (size_type j = 0; j + 1 < k; ++j) relocate(&right->value(j), &x->value(base + 1 + j));
+  relocate(&right->value(k - 1), &parent->value(sep));
+  for (size_type j = k; j < right->count; ++j) relocate(&right->value(j), &right->value(j - k));
+  if (!x->leaf) {
+    for (size_type j = 0; j < k; ++j) set_child(x, base + 1 + j, right->child(j));
+    for (size_type j = k; j <= right->count; ++j) set_child(right, j - k, right->child(j));
+  }
+  x->count = static_cast<unsigned short>(base + k);
+  right->count = static_cast<unsigned short>(right->count - k);
+  if (res.node == right) {
+    if (res.pos + 1 < k)
+      res = iterator(x, base + 1 + res.pos);
+    else if (res.pos + 1 == k)
+      res = iterator(parent, sep);
+    else
+      res.pos -= k;
+  }
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void btree<Key, Value, KeyOfValue, Compare, Alloc>::borrow_from_left(node_ptr x, node_ptr left,
+                                                                     iterator &res) {
+  node_ptr parent = x->parent;
+  const size_type sep = x->position - 1;
+  const size_type k = (left->count - x->count + 1) / 2;
+  const size_type keep = left->count - k;// 借出后 left 的值个数
+  for (size_type j = x->count; j > 0; --j) relocate(&x->value(j - 1), &x->value(j - 1 + k));
+  if (!x->leaf)
+    for (size_type j = x->count + 1; j > 0; --j) set_child(x, j - 1 + k, x->child(j - 1));
+  relocate(&parent->value(sep), &x->value(k - 1));
+  for (size_type j = keep + 1; j < left->count; ++j) relocate(&left->value(j), &x->value(j - keep - 1));
+  relocate(&left->value(keep), &parent->value(sep));
+  if (!x->leaf)
+    for (size_type j = keep + 1; j <= left->count; ++j) set_child(x, j - keep - 1, left->child(j));
+  if (res.node == x) {
+    res.pos += k;
+  } else if (res.node == left && res.pos >= keep) {
+    res = res.pos == keep ? iterator(parent, sep) : iterator(x, res.pos - keep - 1);
+  }
+  x->count = static_cast<unsigned short>(x->count + k);
+  left->count = static_cast<unsigned short>(keep);
+}
+
+// 自叶节点 x 向上修复不足 min_values 的节点：能与兄弟合并则合并，否则从兄弟借值；
+// res 始终指向被删元素的后继所在（未规范化的）位置
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::rebalance_after_erase(node_ptr x, size_type pos) {
+  iterator res(x, pos);
+  while (x != root_ && x->count < min_values) {
+    node_ptr parent = x->parent;
+    const size_type xp = x->position;
+    node_ptr left = xp > 0 ? parent->child(xp - 1) : nullptr;
+    node_ptr right = xp < parent->count ? parent->child(xp + 1) : nullptr;
+    if (left && size_type(left->count) + 1 + x->count <= N) {
+      if (res.node == x) res = iterator(left, res.pos + left->count + 1);
+      merge_into_left(left, x);
+    } else if (right && size_type(x->count) + 1 + right->count <= N) {
+      if (res.node == right) res = iterator(x, res.pos + x->count + 1);
+      merge_into_left(x, right);
+    } else {
+      if (right)
+        borrow_from_right(x, right, res);
+      else
+        borrow_from_left(x, left, res);
+      break;
+    }
+    x = parent;
+  }
+  if (root_->count == 0) {
+    node_ptr old = root_;
+    if (old->leaf) {
+      root_ = nullptr;
+      free_node(old);
+      return end();
+    }
+    root_ = old->child(0);
+    root_->parent = nullptr;
+    root_->position = 0;
+    free_node(old);
+    if (res.node == old) return end();
+  }
+  return normalize(res.node, res.pos);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::erase(iterator pos) {
+  node_ptr x = pos.node;
+  size_type i = pos.pos;
+  const bool internal_delete = !x->leaf;
+  if (internal_delete) {
+    // 以前驱（左子树的最右值）顶替被删值，转化为删除叶节点中的末尾值
+    node_ptr l = x->child(i);
+    while (!l->leaf) l = l->child(l->count);
+    TinySTL::destroy(&x->value(i));
+    relocate(&l->value(l->count - 1), &x->value(i));
+    --l->count;
+    x = l;
+    i = l->count;
+  } else {
+    TinySTL::destroy(&x->value(i));
+    for (size_type j = i + 1; j < x->count; ++j) relocate(&x->value(j), &x->value(j - 1));
+    --x->count;
+  }
+  --node_count;
+  iterator res = rebalance_after_erase(x, i);
+  // 此时 res 指向顶替者（即被删值的前驱），后继在其之后
+  if (internal_delete) ++res;
+  return res;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+btree<Key, Value, KeyOfValue, Compare, Alloc>::erase(iterator first, iterator last) {
+  if (first == begin() && last == end()) {
+    clear();
+    return end();
+  }
+  // 删除会搬移元素，last 随之失效，因此按个数删除
+  for (size_type n = TinySTL::distance(first, last); n > 0; --n) first = erase(first);
+  return first;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc>::size_type
+btree<Key, Value, KeyOfValue, Compare, Alloc>::erase(const key_type &k) {
+  iterator first = lower_bound(k);
+  size_type n = TinySTL::distance(first, upper_bound(k));
+  for (size_type i = n; i > 0; --i) first = erase(first);
+  return n;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+bool btree<Key, Value, KeyOfValue, Compare, Alloc>::verify_node(
+    node_ptr x, const Key *lo, const Key *hi, size_type depth, size_type &leaf_depth,
+    size_type &n) const noexcept {
+  if (x->count > N || (x != root_ && x->count == 0)) return false;
+  for (size_type i = 0; i < x->count; ++i) {
+    if (i > 0 && key_compare(key(x, i), key(x, i - 1))) return false;
+    if (lo && key_compare(key(x, i), *lo)) return false;
+    if (hi && key_compare(*hi, key(x, i))) return false;
+  }
+  n += x->count;
+  if (x->leaf) {
+    if (leaf_depth == size_type(-1)) leaf_depth = depth;
+    return leaf_depth == depth;
+  }
+  for (size_type i = 0; i <= x->count; ++i) {
+    node_ptr c = x->child(i);
+    if (c->parent != x || c->position != i) return false;
+    const Key *clo = i > 0 ? &key(x, i - 1) : lo;
+    const Key *chi = i < x->count ? &key(x, i) : hi;
+    if (!verify_node(c, clo, chi, depth + 1, leaf_depth, n)) return false;
+  }
+  return true;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+bool btree<Key, Value, KeyOfValue, Compare, Alloc>::verify() const noexcept {
+  if (!root_) return node_count == 0;
+  if (root_->parent) return false;
+  size_type leaf_depth = size_type(-1);
+  size_type n = 0;
+  if (!verify_node(root_, nullptr, nullptr, 0, leaf_depth, n)) return false;
+  return n == node_count && static_cast<size_type>(TinySTL::distance(begin(), end())) == n;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator==(const btree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
+                       const btree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+  return lhs.size() == rhs.size() && TinySTL::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator!=(const btree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
+                       const btree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool operator<(const btree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
+                      const btree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+  return TinySTL::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline void swap(btree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
+                 btree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
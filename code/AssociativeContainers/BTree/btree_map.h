@@ -0,0 +1,256 @@
+/*
+btree_map / btree_multimap: 以 btree 为底层的关联容器，接口与 map 相同。
+与 map 的区别：插入与删除使所有迭代器失效；erase(iterator) 返回指向后继的迭代器。
+*/
+#pragma once
+
+#include "AssociativeContainers/BTree/btree.h"
+#include "Function/function_adapter.h"
+#include <initializer_list>
+
+namespace TinySTL {
+
+template<class Key, class T, class Compare = less<Key>, class Alloc = simpleAlloc<T>>
+class btree_map {
+ public:// value comparator
+  using key_type = Key;
+  using data_type = T;
+  using mapped_type = T;
+  using value_type = pair<const Key, T>;
+  using key_compare = Compare;
+
+  class value_compare : public binary_function<value_type, value_type, bool> {
+    friend class btree_map;
+
+   protected:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+
+   public:
+    bool operator()(const value_type &x, const value_type &y) const {
+      return comp(x.first, y.first);
+    }
+  };
+
+ private:// data member
+  using rep_type = btree<key_type, value_type, select1st<value_type>, key_compare, Alloc>;
+  rep_type t;
+
+ public:// Alias declarations
+  using pointer = typename rep_type::pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ public:// ctor
+  btree_map() : t(key_compare()) {}
+  explicit btree_map(const key_compare &comp) : t(comp) {}
+  template<class InputIterator>
+  btree_map(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+      : t(comp) {
+    t.insert_unique(first, last);
+  }
+  btree_map(std::initializer_list<value_type> ils, const key_compare &comp = key_compare())
+      : t(comp) {
+    t.insert_unique(ils.begin(), ils.end());
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return t.key_comp(); }
+  value_compare value_comp() const noexcept { return value_compare(t.key_comp()); }
+  const_iterator begin() const noexcept { return t.begin(); }
+  const_iterator end() const noexcept { return t.end(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  const_reverse_iterator rbegin() const noexcept { return t.rbegin(); }
+  const_reverse_iterator rend() const noexcept { return t.rend(); }
+  const_reverse_iterator crbegin() const noexcept { return t.rbegin(); }
+  const_reverse_iterator crend() const noexcept { return t.rend(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+  size_type max_size() const noexcept { return t.max_size(); }
+
+ public:// setter
+  iterator begin() noexcept { return t.begin(); }
+  iterator end() noexcept { return t.end(); }
+  reverse_iterator rbegin() noexcept { return t.rbegin(); }
+  reverse_iterator rend() noexcept { return t.rend(); }
+
+  data_type &operator[](const key_type &k) {
+    iterator i = lower_bound(k);
+    if (i == end() || key_comp()(k, (*i).first))
+      i = insert(i, value_type(k, data_type()));
+    return (*i).second;
+  }
+
+ public:// swap
+  void swap(btree_map &x) noexcept { t.swap(x.t); }
+
+ public:// insert && erase
+  pair<iterator, bool> insert(const value_type &x) { return t.insert_unique(x); }
+  iterator insert(iterator pos, const value_type &x) { return t.insert_unique(pos, x); }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_unique(first, last);
+  }
+  iterator erase(iterator pos) { return t.erase(pos); }
+  size_type erase(const key_type &x) { return t.erase(x); }
+  iterator erase(iterator first, iterator last) { return t.erase(first, last); }
+  void clear() noexcept { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &x) noexcept { return t.find(x); }
+  const_iterator find(const key_type &x) const noexcept { return t.find(x); }
+  size_type count(const key_type &x) const noexcept { return t.find(x) == t.end() ? 0 : 1; }
+  iterator lower_bound(const key_type &x) noexcept { return t.lower_bound(x); }
+  const_iterator lower_bound(const key_type &x) const noexcept { return t.lower_bound(x); }
+  iterator upper_bound(const key_type &x) noexcept { return t.upper_bound(x); }
+  const_iterator upper_bound(const key_type &x) const noexcept { return t.upper_bound(x); }
+  pair<iterator, iterator> equal_range(const key_type &x) noexcept { return t.equal_range(x); }
+  pair<const_iterator, const_iterator> equal_range(const key_type &x) const noexcept {
+    return t.equal_range(x);
+  }
+
+ public:// debug
+  bool verify() const noexcept { return t.verify(); }
+
+ public:// compare
+  friend bool operator==(const btree_map &lhs, const btree_map &rhs) { return lhs.t == rhs.t; }
+  friend bool operator!=(const btree_map &lhs, const btree_map &rhs) { return !(lhs.t == rhs.t); }
+  friend bool operator<(const btree_map &lhs, const btree_map &rhs) { return lhs.t < rhs.t; }
+};
+
+template<class Key, class T, class Compare = less<Key>, class Alloc = simpleAlloc<T>>
+class btree_multimap {
+ public:// value comparator
+  using key_type = Key;
+  using data_type = T;
+  using mapped_type = T;
+  using value_type = pair<const Key, T>;
+  using key_compare = Compare;
+
+  class value_compare : public binary_function<value_type, value_type, bool> {
+    friend class btree_multimap;
+
+   protected:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+
+   public:
+    bool operator()(const value_type &x, const value_type &y) const {
+      return comp(x.first, y.first);
+    }
+  };
+
+ private:// data member
+  using rep_type = btree<key_type, value_type, select1st<value_type>, key_compare, Alloc>;
+  rep_type t;
+
+ public:// Alias declarations
+  using pointer = typename rep_type::pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ public:// ctor
+  btree_multimap() : t(key_compare()) {}
+  explicit btree_multimap(const key_compare &comp) : t(comp) {}
+  template<class InputIterator>
+  btree_multimap(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+      : t(comp) {
+    t.insert_equal(first, last);
+  }
+  btree_multimap(std::initializer_list<value_type> ils, const key_compare &comp = key_compare())
+      : t(comp) {
+    t.insert_equal(ils.begin(), ils.end());
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return t.key_comp(); }
+  value_compare value_comp() const noexcept { return value_compare(t.key_comp()); }
+  const_iterator begin() const noexcept { return t.begin(); }
+  const_iterator end() const noexcept { return t.end(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  const_reverse_iterator rbegin() const noexcept { return t.rbegin(); }
+  const_reverse_iterator rend() const noexcept { return t.rend(); }
+  const_reverse_iterator crbegin() const noexcept { return t.rbegin(); }
+  const_reverse_iterator crend() const noexcept { return t.rend(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+  size_type max_size() const noexcept { return t.max_size(); }
+
+ public:// setter
+  iterator begin() noexcept { return t.begin(); }
+  iterator end() noexcept { return t.end(); }
+  reverse_iterator rbegin() noexcept { return t.rbegin(); }
+  reverse_iterator rend() noexcept { return t.rend(); }
+
+ public:// swap
+  void swap(btree_multimap &x) noexcept { t.swap(x.t); }
+
+ public:// insert && erase
+  iterator insert(const value_type &x) { return t.insert_equal(x); }
+  iterator insert(iterator pos, const value_type &x) { return t.insert_equal(pos, x); }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_equal(first, last);
+  }
+  iterator erase(iterator pos) { return t.erase(pos); }
+  size_type erase(const key_type &x) { return t.erase(x); }
+  iterator erase(iterator first, iterator last) { return t.erase(first, last); }
+  void clear() noexcept { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &x) noexcept { return t.find(x); }
+  const_iterator find(const key_type &x) const noexcept { return t.find(x); }
+  size_type count(const key_type &x) const noexcept { return t.count(x); }
+  iterator lower_bound(const key_type &x) noexcept { return t.lower_bound(x); }
+  const_iterator lower_bound(const key_type &x) const noexcept { return t.lower_bound(x); }
+  iterator upper_bound(const key_type &x) noexcept { return t.upper_bound(x); }
+  const_iterator upper_bound(const key_type &x) const noexcept { return t.upper_bound(x); }
+  pair<iterator, iterator> equal_range(const key_type &x) noexcept { return t.equal_range(x); }
+  pair<const_iterator, const_iterator> equal_range(const key_type &x) const noexcept {
+    return t.equal_range(x);
+  }
+
+ public:// debug
+  bool verify() const noexcept { return t.verify(); }
+
+ public:// compare
+  friend bool operator==(const btree_multimap &lhs, const btree_multimap &rhs) {
+    return lhs.t == rhs.t;
+  }
+  friend bool operator!=(const btree_multimap &lhs, const btree_multimap &rhs) {
+    return !(lhs.t == rhs.t);
+  }
+  friend bool operator<(const btree_multimap &lhs, const btree_multimap &rhs) {
+    return lhs.t < rhs.t;
+  }
+};
+
+template<class Key, class T, class Compare, class Alloc>
+inline void swap(btree_map<Key, T, Compare, Alloc> &lhs,
+                 btree_map<Key, T, Compare, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template<class Key, class T, class Compare, class Alloc>
+inline void swap(btree_multimap<Key, T, Compare, Alloc> &lhs,
+                 btree_multimap<Key, T, Compare, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
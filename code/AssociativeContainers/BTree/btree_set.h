@@ -0,0 +1,222 @@
+/*
+btree_set / btree_multiset: 以 btree 为底层的集合，接口与 set 相同。
+与 set 的区别：插入与删除使所有迭代器失效；erase(iterator) 返回指向后继的迭代器。
+*/
+#pragma once
+
+#include "AssociativeContainers/BTree/btree.h"
+#include "Function/function_adapter.h"
+#include <initializer_list>
+
+namespace TinySTL {
+
+template<class Key, class Compare = less<Key>, class Alloc = simpleAlloc<Key>>
+class btree_set {
+ public:// key_type is value_type
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+ private:// data member
+  using rep_type = btree<key_type, value_type, identity<value_type>, Compare, Alloc>;
+  using rep_iterator = typename rep_type::iterator;
+  rep_type t;
+
+ public:
+  // 键值不可修改，迭代器与指针均为 const
+  using pointer = typename rep_type::const_pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::const_reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::const_iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::const_reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ public:// ctor
+  btree_set() : t(key_compare()) {}
+  explicit btree_set(const key_compare &comp) : t(comp) {}
+  template<class InputIterator>
+  btree_set(InputIterator first, InputIterator last, const key_compare &comp = Compare())
+      : t(comp) {
+    t.insert_unique(first, last);
+  }
+  btree_set(std::initializer_list<value_type> ils, const key_compare &comp = Compare())
+      : t(comp) {
+    t.insert_unique(ils.begin(), ils.end());
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return t.key_comp(); }
+  value_compare value_comp() const noexcept { return t.key_comp(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+  size_type max_size() const noexcept { return t.max_size(); }
+  // read only
+  iterator begin() const noexcept { return t.cbegin(); }
+  iterator end() const noexcept { return t.cend(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  reverse_iterator rbegin() const noexcept { return t.rbegin(); }
+  reverse_iterator rend() const noexcept { return t.rend(); }
+  const_reverse_iterator crbegin() const noexcept { return t.crbegin(); }
+  const_reverse_iterator crend() const noexcept { return t.crend(); }
+
+ public:// swap
+  void swap(btree_set &rhs) noexcept { t.swap(rhs.t); }
+
+ public:// insert
+  pair<iterator, bool> insert(const value_type &val) {
+    pair<rep_iterator, bool> p = t.insert_unique(val);
+    return pair<iterator, bool>(p.first, p.second);
+  }
+  iterator insert(const_iterator hint, const value_type &val) {
+    return t.insert_unique(reinterpret_cast<rep_iterator &>(hint), val);
+  }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_unique(first, last);
+  }
+  void insert(std::initializer_list<value_type> ils) { insert(ils.begin(), ils.end()); }
+
+ public:// erase
+  iterator erase(iterator pos) { return t.erase(reinterpret_cast<rep_iterator &>(pos)); }
+  size_type erase(const key_type &val) { return t.erase(val); }
+  iterator erase(iterator first, iterator last) {
+    return t.erase(reinterpret_cast<rep_iterator &>(first), reinterpret_cast<rep_iterator &>(last));
+  }
+  void clear() noexcept { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &key) const noexcept { return t.find(key); }
+  size_type count(const key_type &key) const noexcept { return t.find(key) == t.end() ? 0 : 1; }
+  iterator lower_bound(const key_type &key) const noexcept { return t.lower_bound(key); }
+  iterator upper_bound(const key_type &key) const noexcept { return t.upper_bound(key); }
+  pair<iterator, iterator> equal_range(const key_type &key) const noexcept {
+    return t.equal_range(key);
+  }
+
+ public:// debug
+  bool verify() const noexcept { return t.verify(); }
+
+ public:// compare
+  friend bool operator==(const btree_set &lhs, const btree_set &rhs) { return lhs.t == rhs.t; }
+  friend bool operator!=(const btree_set &lhs, const btree_set &rhs) { return !(lhs.t == rhs.t); }
+  friend bool operator<(const btree_set &lhs, const btree_set &rhs) { return lhs.t < rhs.t; }
+};
+
+template<class Key, class Compare = less<Key>, class Alloc = simpleAlloc<Key>>
+class btree_multiset {
+ public:// key_type is value_type
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+ private:// data member
+  using rep_type = btree<key_type, value_type, identity<value_type>, Compare, Alloc>;
+  using rep_iterator = typename rep_type::iterator;
+  rep_type t;
+
+ public:
+  using pointer = typename rep_type::const_pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::const_reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::const_iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::const_reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ public:// ctor
+  btree_multiset() : t(key_compare()) {}
+  explicit btree_multiset(const key_compare &comp) : t(comp) {}
+  template<class InputIterator>
+  btree_multiset(InputIterator first, InputIterator last, const key_compare &comp = Compare())
+      : t(comp) {
+    t.insert_equal(first, last);
+  }
+  btree_multiset(std::initializer_list<value_type> ils, const key_compare &comp = Compare())
+      : t(comp) {
+    t.insert_equal(ils.begin(), ils.end());
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return t.key_comp(); }
+  value_compare value_comp() const noexcept { return t.key_comp(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+  size_type max_size() const noexcept { return t.max_size(); }
+  // read only
+  iterator begin() const noexcept { return t.cbegin(); }
+  iterator end() const noexcept { return t.cend(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  reverse_iterator rbegin() const noexcept { return t.rbegin(); }
+  reverse_iterator rend() const noexcept { return t.rend(); }
+  const_reverse_iterator crbegin() const noexcept { return t.crbegin(); }
+  const_reverse_iterator crend() const noexcept { return t.crend(); }
+
+ public:// swap
+  void swap(btree_multiset &rhs) noexcept { t.swap(rhs.t); }
+
+ public:// insert
+  iterator insert(const value_type &val) { return t.insert_equal(val); }
+  iterator insert(const_iterator hint, const value_type &val) {
+    return t.insert_equal(reinterpret_cast<rep_iterator &>(hint), val);
+  }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_equal(first, last);
+  }
+  void insert(std::initializer_list<value_type> ils) { insert(ils.begin(), ils.end()); }
+
+ public:// erase
+  iterator erase(iterator pos) { return t.erase(reinterpret_cast<rep_iterator &>(pos)); }
+  size_type erase(const key_type &val) { return t.erase(val); }
+  iterator erase(iterator first, iterator last) {
+    return t.erase(reinterpret_cast<rep_iterator &>(first), reinterpret_cast<rep_iterator &>(last));
+  }
+  void clear() noexcept { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &key) const noexcept { return t.find(key); }
+  size_type count(const key_type &key) const noexcept { return t.count(key); }
+  iterator lower_bound(const key_type &key) const noexcept { return t.lower_bound(key); }
+  iterator upper_bound(const key_type &key) const noexcept { return t.upper_bound(key); }
+  pair<iterator, iterator> equal_range(const key_type &key) const noexcept {
+    return t.equal_range(key);
+  }
+
+ public:// debug
+  bool verify() const noexcept { return t.verify(); }
+
+ public:// compare
+  friend bool operator==(const btree_multiset &lhs, const btree_multiset &rhs) {
+    return lhs.t == rhs.t;
+  }
+  friend bool operator!=(const btree_multiset &lhs, const btree_multiset &rhs) {
+    return !(lhs.t == rhs.t);
+  }
+  friend bool operator<(const btree_multiset &lhs, const btree_multiset &rhs) {
+    return lhs.t < rhs.t;
+  }
+};
+
+template<class Key, class Compare, class Alloc>
+inline void swap(btree_set<Key, Compare, Alloc> &lhs, btree_set<Key, Compare, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template<class Key, class Compare, class Alloc>
+inline void swap(btree_multiset<Key, Compare, Alloc> &lhs,
+                 btree_multiset<Key, Compare, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
@@ -0,0 +1,345 @@
+/*
+flat_map: 以两个有序 vector 实现的关联容器，键与值分开存放：
+    keys   : k0 < k1 < ... < kn-1
+    values : v0   v1   ...   vn-1
+适合一次建立、之后以读为主的场景：查找是对连续键数组的二分，遍历是顺序访问，
+且每个元素没有任何节点开销。单个插入与删除需要搬移元素，为 O(n)；
+区间插入先追加到尾部，对新元素排序后与原有元素归并，为 O(n + m log m)。
+
+迭代器解引用得到 pair<const Key &, T &> 代理，插入与删除使所有迭代器失效。
+*/
+#pragma once
+
+#include "AssociativeContainers/Flat/flat_merge.h"
+#include "Function/function_adapter.h"
+#include "Iterator/stl_iterator.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include "Utils/type_traits.h"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace TinySTL {
+
+template<class Key, class T, class VPtr, class Ref>
+struct _flat_map_iterator {
+  using iterator = _flat_map_iterator<Key, T, T *, pair<const Key &, T &>>;
+  using self = _flat_map_iterator;
+
+  using iterator_category = random_access_iterator_tag;
+  using value_type = pair<Key, T>;
+  using difference_type = ptrdiff_t;
+  using reference = Ref;
+  // operator-> 返回持有代理的临时对象
+  struct pointer {
+    reference ref;
+    reference *operator->() { return &ref; }
+  };
+
+  const Key *k;
+  VPtr v;
+
+  _flat_map_iterator() : k(nullptr), v(nullptr) {}
+  _flat_map_iterator(const Key *key, VPtr val) : k(key), v(val) {}
+  _flat_map_iterator(const iterator &rhs) : k(rhs.k), v(rhs.v) {}
+
+  reference operator*() const { return reference(*k, *v); }
+  pointer operator->() const { return pointer{operator*()}; }
+  reference operator[](difference_type n) const { return reference(k[n], v[n]); }
+
+  self &operator++() {
+    ++k, ++v;
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++*this;
+    return temp;
+  }
+  self &operator--() {
+    --k, --v;
+    return *this;
+  }
+  self operator--(int) {
+    self temp = *this;
+    --*this;
+    return temp;
+  }
+  self &operator+=(difference_type n) {
+    k += n, v += n;
+    return *this;
+  }
+  self &operator-=(difference_type n) { return *this += -n; }
+  self operator+(difference_type n) const { return self(k + n, v + n); }
+  self operator-(difference_type n) const { return self(k - n, v - n); }
+  difference_type operator-(const self &rhs) const { return k - rhs.k; }
+
+  bool operator==(const self &rhs) const { return k == rhs.k; }
+  bool operator!=(const self &rhs) const { return k != rhs.k; }
+  bool operator<(const self &rhs) const { return k < rhs.k; }
+};
+
+template<class Key, class T, class Compare = less<Key>>
+class flat_map {
+ public:// alias declarations
+  using key_type = Key;
+  using mapped_type = T;
+  using data_type = T;
+  using value_type = pair<Key, T>;
+  using key_compare = Compare;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = pair<const Key &, T &>;
+  using const_reference = pair<const Key &, const T &>;
+  using key_container_type = vector<Key>;
+  using mapped_container_type = vector<T>;
+
+  using iterator = _flat_map_iterator<Key, T, T *, reference>;
+  using const_iterator = _flat_map_iterator<Key, T, const T *, const_reference>;
+
+ private:// data member
+  key_container_type keys_;
+  mapped_container_type values_;
+  Compare comp_;
+
+ private:// aux interface
+  template<class K>
+  size_type lower_index(const K &k) const {
+    return std::lower_bound(keys_.begin(), keys_.end(), k, comp_) - keys_.begin();
+  }
+  template<class K>
+  size_type upper_index(const K &k) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), k, comp_) - keys_.begin();
+  }
+  template<class K>
+  size_type find_index(const K &k) const {
+    size_type i = lower_index(k);
+    return i != size() && !comp_(k, keys_[i]) ? i : size();
+  }
+  iterator make_iter(size_type i) noexcept { return iterator(keys_.begin() + i, values_.begin() + i); }
+  const_iterator make_iter(size_type i) const noexcept {
+    return const_iterator(keys_.begin() + i, values_.begin() + i);
+  }
+  // 在下标 i 处插入一对键值，值插入失败时撤销键的插入
+  iterator insert_at(size_type i, const key_type &k, const mapped_type &v) {
+    keys_.insert(keys_.begin() + i, k);
+    try {
+      values_.insert(values_.begin() + i, v);
+    } catch (std::exception &) {
+      keys_.erase(keys_.begin() + i);
+      throw;
+    }
+    return make_iter(i);
+  }
+  void truncate(size_type n) {
+    keys_.erase(keys_.begin() + n, keys_.end());
+    values_.erase(values_.begin() + n, values_.end());
+  }
+  // [0, n) 为原有元素，[n, size()) 为新追加元素：排序新元素并与原有元素归并，键相同时保留先出现者
+  void merge_tail(size_type n);
+
+ public:// ctor
+  flat_map() : comp_() {}
+  explicit flat_map(const key_compare &comp) : comp_(comp) {}
+  template<class InputIterator>
+  flat_map(InputIterator first, InputIterator last, const key_compare &comp = key_compare())
+      : comp_(comp) {
+    insert(first, last);
+  }
+  flat_map(std::initializer_list<value_type> ils, const key_compare &comp = key_compare())
+      : comp_(comp) {
+    insert(ils.begin(), ils.end());
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return comp_; }
+  const_iterator begin() const noexcept { return make_iter(0); }
+  const_iterator end() const noexcept { return make_iter(size()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type capacity() const noexcept { return keys_.capacity(); }
+  // 直接访问底层的有序键数组与值数组
+  const key_container_type &keys() const noexcept { return keys_; }
+  const mapped_container_type &values() const noexcept { return values_; }
+
+ public:// setter
+  iterator begin() noexcept { return make_iter(0); }
+  iterator end() noexcept { return make_iter(size()); }
+  void reserve(size_type n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+
+  mapped_type &operator[](const key_type &k) {
+    size_type i = lower_index(k);
+    if (i == size() || comp_(k, keys_[i])) insert_at(i, k, mapped_type());
+    return values_[i];
+  }
+  mapped_type &at(const key_type &k) {
+    size_type i = find_index(k);
+    if (i == size()) throw std::out_of_range("flat_map::at");
+    return values_[i];
+  }
+  const mapped_type &at(const key_type &k) const {
+    size_type i = find_index(k);
+    if (i == size()) throw std::out_of_range("flat_map::at");
+    return values_[i];
+  }
+
+  // 接管调用者已按键排好序且无重复的两个数组，不做复制与检查
+  void replace(key_container_type &&keys, mapped_container_type &&values) noexcept {
+    keys_ = TinySTL::move(keys);
+    values_ = TinySTL::move(values);
+  }
+
+ public:// swap
+  void swap(flat_map &rhs) noexcept {
+    keys_.swap(rhs.keys_);
+    values_.swap(rhs.values_);
+    TinySTL::swap(comp_, rhs.comp_);
+  }
+
+ public:// insert && erase
+  pair<iterator, bool> insert(const value_type &x) {
+    size_type i = lower_index(x.first);
+    if (i != size() && !comp_(x.first, keys_[i])) return pair<iterator, bool>(make_iter(i), false);
+    return pair<iterator, bool>(insert_at(i, x.first, x.second), true);
+  }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last);
+  iterator erase(const_iterator pos) {
+    size_type i = pos.k - keys_.begin();
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return make_iter(i);
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type i = first.k - keys_.begin(), j = last.k - keys_.begin();
+    keys_.erase(keys_.begin() + i, keys_.begin() + j);
+    values_.erase(values_.begin() + i, values_.begin() + j);
+    return make_iter(i);
+  }
+  size_type erase(const key_type &k) {
+    size_type i = find_index(k);
+    if (i == size()) return 0;
+    erase(make_iter(i));
+    return 1;
+  }
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+ public:// find
+  iterator find(const key_type &k) { return make_iter(find_index(k)); }
+  const_iterator find(const key_type &k) const { return make_iter(find_index(k)); }
+  size_type count(const key_type &k) const { return find_index(k) == size() ? 0 : 1; }
+  bool contains(const key_type &k) const { return find_index(k) != size(); }
+  iterator lower_bound(const key_type &k) { return make_iter(lower_index(k)); }
+  const_iterator lower_bound(const key_type &k) const { return make_iter(lower_index(k)); }
+  iterator upper_bound(const key_type &k) { return make_iter(upper_index(k)); }
+  const_iterator upper_bound(const key_type &k) const { return make_iter(upper_index(k)); }
+  pair<iterator, iterator> equal_range(const key_type &k) {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+  pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+    return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+  }
+
+ public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator find(const K &k) {
+    return make_iter(find_index(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator find(const K &k) const {
+    return make_iter(find_index(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  size_type count(const K &k) const {
+    return find_index(k) == size() ? 0 : 1;
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  bool contains(const K &k) const {
+    return find_index(k) != size();
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator lower_bound(const K &k) {
+    return make_iter(lower_index(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator lower_bound(const K &k) const {
+    return make_iter(lower_index(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator upper_bound(const K &k) {
+    return make_iter(upper_index(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator upper_bound(const K &k) const {
+    return make_iter(upper_index(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<iterator, iterator> equal_range(const K &k) {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<const_iterator, const_iterator> equal_range(const K &k) const {
+    return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+  }
+
+ public:// compare
+  friend bool operator==(const flat_map &lhs, const flat_map &rhs) {
+    return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+  }
+  friend bool operator!=(const flat_map &lhs, const flat_map &rhs) { return !(lhs == rhs); }
+};
+
+template<class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::merge_tail(size_type n) {
+  if (size() == n) return;
+  vector<size_type> order;
+  size_type kept;
+  try {
+    kept = _flat_merge_order(keys_, n, comp_, order);
+  } catch (std::exception &) {
+    truncate(n);// 尚未移动任何元素
+    throw;
+  }
+  vector<size_type> perm(order);
+  _flat_gather(keys_, perm);
+  _flat_gather(values_, order);
+  truncate(kept);
+}
+
+template<class Key, class T, class Compare>
+template<class InputIterator>
+void flat_map<Key, T, Compare>::insert(InputIterator first, InputIterator last) {
+  const size_type n = size();
+  try {
+    for (; first != last; ++first) {
+      keys_.push_back((*first).first);
+      try {
+        values_.push_back((*first).second);
+      } catch (std::exception &) {
+        keys_.pop_back();
+        throw;
+      }
+    }
+  } catch (std::exception &) {
+    truncate(n);
+    throw;
+  }
+  merge_tail(n);
+}
+
+template<class Key, class T, class Compare>
+inline void swap(flat_map<Key, T, Compare> &lhs, flat_map<Key, T, Compare> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
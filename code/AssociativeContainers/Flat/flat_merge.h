@@ -0,0 +1,63 @@
+/*
+flat_map 与 flat_set 区间插入共用的归并步骤：
+新元素追加在有序数组尾部后，先只用下标完成排序、归并与去重（期间只做比较，不移动元素），
+再沿置换环一次性把元素移到位。比较抛出异常时数组尚未改动，截掉追加部分即可复原。
+*/
+#pragma once
+
+#include "SequenceContainers/Vector/stl_vector.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace TinySTL {
+
+// keys 的 [0, n) 为有序无重复的原有元素，[n, keys.size()) 为新追加元素。
+// order 置为归并后的次序，返回保留的个数 kept：order 的前 kept 个即结果，
+// 其后为被淘汰的重复元素；键相同时保留先出现者
+template<class Vec, class Compare>
+size_t _flat_merge_order(const Vec &keys, size_t n, Compare &comp, vector<size_t> &order) {
+  const size_t total = keys.size();
+  vector<size_t> fresh;
+  fresh.reserve(total - n);
+  for (size_t i = n; i < total; ++i) fresh.push_back(i);
+  std::stable_sort(fresh.begin(), fresh.end(),
+                   [&](size_t a, size_t b) { return comp(keys[a], keys[b]); });
+
+  vector<size_t> dropped;
+  order.clear();
+  order.reserve(total);
+  size_t i = 0, j = 0;
+  while (i < n || j < fresh.size()) {
+    // 键相同时原有元素先出，随后的新元素即被淘汰
+    size_t idx = j == fresh.size() || (i < n && !comp(keys[fresh[j]], keys[i])) ? i++ : fresh[j++];
+    if (!order.empty() && !comp(keys[order.back()], keys[idx]))
+      dropped.push_back(idx);
+    else
+      order.push_back(idx);
+  }
+  const size_t kept = order.size();
+  for (size_t d : dropped) order.push_back(d);
+  return kept;
+}
+
+// 按 perm 重排：v'[i] = v[perm[i]]，沿置换环移动元素，不做复制；perm 被改写
+template<class Vec>
+void _flat_gather(Vec &v, vector<size_t> &perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] == i) continue;
+    typename Vec::value_type temp(TinySTL::move(v[i]));
+    size_t j = i;
+    for (;;) {
+      size_t k = perm[j];
+      perm[j] = j;
+      if (k == i) {
+        v[j] = TinySTL::move(temp);
+        break;
+      }
+      v[j] = TinySTL::move(v[k]);
+      j = k;
+    }
+  }
+}
+
+}// namespace TinySTL
@@ -0,0 +1,189 @@
+/*
+flat_set: 以有序 vector 实现的集合，与 flat_map 相同的取舍：
+查找为连续数组上的二分，单个插入删除 O(n)，区间插入为追加、排序、归并后去重。
+插入与删除使所有迭代器失效。
+*/
+#pragma once
+
+#include "Algorithms/algobase/stl_algobase.h"
+#include "AssociativeContainers/Flat/flat_merge.h"
+#include "Function/function_adapter.h"
+#include "Iterator/stl_iterator.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include "Utils/type_traits.h"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+
+namespace TinySTL {
+
+template<class Key, class Compare = less<Key>>
+class flat_set {
+ public:// key_type is value_type
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using container_type = vector<Key>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  // 键值不可修改，迭代器与指针均为 const
+  using pointer = const Key *;
+  using const_pointer = const Key *;
+  using reference = const Key &;
+  using const_reference = const Key &;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using reverse_iterator = __reverse_iterator<const_iterator>;
+  using const_reverse_iterator = __reverse_iterator<const_iterator>;
+
+ private:// data member
+  container_type keys_;
+  Compare comp_;
+
+ private:// aux interface
+  template<class K>
+  iterator find_aux(const K &k) const {
+    iterator i = std::lower_bound(keys_.begin(), keys_.end(), k, comp_);
+    return i != keys_.end() && !comp_(k, *i) ? i : keys_.end();
+  }
+  typename container_type::iterator mutable_iter(iterator pos) {
+    return keys_.begin() + (pos - keys_.begin());
+  }
+
+ public:// ctor
+  flat_set() : comp_() {}
+  explicit flat_set(const key_compare &comp) : comp_(comp) {}
+  template<class InputIterator>
+  flat_set(InputIterator first, InputIterator last, const key_compare &comp = Compare())
+      : comp_(comp) {
+    insert(first, last);
+  }
+  flat_set(std::initializer_list<value_type> ils, const key_compare &comp = Compare())
+      : comp_(comp) {
+    insert(ils.begin(), ils.end());
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return comp_; }
+  value_compare value_comp() const noexcept { return comp_; }
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type capacity() const noexcept { return keys_.capacity(); }
+  iterator begin() const noexcept { return keys_.begin(); }
+  iterator end() const noexcept { return keys_.end(); }
+  const_iterator cbegin() const noexcept { return keys_.begin(); }
+  const_iterator cend() const noexcept { return keys_.end(); }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+  // 直接访问底层有序数组
+  const container_type &keys() const noexcept { return keys_; }
+
+ public:// setter
+  void reserve(size_type n) { keys_.reserve(n); }
+  // 接管调用者已排好序且无重复的数组，不做复制与检查
+  void replace(container_type &&keys) noexcept { keys_ = TinySTL::move(keys); }
+  void swap(flat_set &rhs) noexcept {
+    keys_.swap(rhs.keys_);
+    TinySTL::swap(comp_, rhs.comp_);
+  }
+
+ public:// insert
+  pair<iterator, bool> insert(const value_type &val) {
+    iterator i = std::lower_bound(keys_.begin(), keys_.end(), val, comp_);
+    if (i != keys_.end() && !comp_(val, *i)) return pair<iterator, bool>(i, false);
+    return pair<iterator, bool>(keys_.insert(mutable_iter(i), val), true);
+  }
+  // 追加到尾部，以下标完成排序、归并与去重（保留原有元素），再把元素移到位
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    const size_type n = size();
+    try {
+      for (; first != last; ++first) keys_.push_back(*first);
+    } catch (std::exception &) {
+      keys_.erase(keys_.begin() + n, keys_.end());
+      throw;
+    }
+    if (size() == n) return;
+    vector<size_type> order;
+    size_type kept;
+    try {
+      kept = _flat_merge_order(keys_, n, comp_, order);
+    } catch (std::exception &) {
+      keys_.erase(keys_.begin() + n, keys_.end());// 尚未移动任何元素
+      throw;
+    }
+    _flat_gather(keys_, order);
+    keys_.erase(keys_.begin() + kept, keys_.end());
+  }
+  void insert(std::initializer_list<value_type> ils) { insert(ils.begin(), ils.end()); }
+
+ public:// erase
+  iterator erase(iterator pos) { return keys_.erase(mutable_iter(pos)); }
+  iterator erase(iterator first, iterator last) {
+    return keys_.erase(mutable_iter(first), mutable_iter(last));
+  }
+  size_type erase(const key_type &k) {
+    iterator i = find_aux(k);
+    if (i == end()) return 0;
+    erase(i);
+    return 1;
+  }
+  void clear() noexcept { keys_.clear(); }
+
+ public:// find
+  iterator find(const key_type &k) const { return find_aux(k); }
+  size_type count(const key_type &k) const { return find_aux(k) == end() ? 0 : 1; }
+  bool contains(const key_type &k) const { return find_aux(k) != end(); }
+  iterator lower_bound(const key_type &k) const {
+    return std::lower_bound(keys_.begin(), keys_.end(), k, comp_);
+  }
+  iterator upper_bound(const key_type &k) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), k, comp_);
+  }
+  pair<iterator, iterator> equal_range(const key_type &k) const {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+
+ public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator find(const K &k) const {
+    return find_aux(k);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  size_type count(const K &k) const {
+    return find_aux(k) == end() ? 0 : 1;
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  bool contains(const K &k) const {
+    return find_aux(k) != end();
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator lower_bound(const K &k) const {
+    return std::lower_bound(keys_.begin(), keys_.end(), k, comp_);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator upper_bound(const K &k) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), k, comp_);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<iterator, iterator> equal_range(const K &k) const {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+
+ public:// compare
+  friend bool operator==(const flat_set &lhs, const flat_set &rhs) { return lhs.keys_ == rhs.keys_; }
+  friend bool operator!=(const flat_set &lhs, const flat_set &rhs) { return !(lhs == rhs); }
+  friend bool operator<(const flat_set &lhs, const flat_set &rhs) {
+    return TinySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+};
+
+template<class Key, class Compare>
+inline void swap(flat_set<Key, Compare> &lhs, flat_set<Key, Compare> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
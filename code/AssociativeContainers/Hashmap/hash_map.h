@@ -48,9 +48,9 @@ class hash_map {
     return rep.elems_in_bucket(n);
   }
 
-  iterator begin() const noexcept { return rep.cbegin(); }
-  iterator end() const noexcept { return rep.cend(); }
-  const_iterator cbgein() const noexcept { return rep.cbegin(); }
+  const_iterator begin() const noexcept { return rep.cbegin(); }
+  const_iterator end() const noexcept { return rep.cend(); }
+  const_iterator cbegin() const noexcept { return rep.cbegin(); }
   const_iterator cend() const noexcept { return rep.cend(); }
 
  public:// ctor
@@ -98,9 +98,48 @@ class hash_map {
   void insert(InputIterator first, InputIterator last) {
     rep.insert_unique(first, last);
   }
-  data_type &operator[](const key_type &key) {
-    return rep.find_or_insert(value_type(key, data_type())).second;// 见Effective STL Item24
+  // 命中时既不构造 data_type 也不检查扩容，见Effective STL Item24
+  data_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+
+ public:// emplace
+  template<class... Args>
+  pair<iterator, bool> emplace(Args &&...args) {
+    return rep.emplace_unique(TinySTL::forward<Args>(args)...);
+  }
+  // 仅当 key 不存在时才以 args 构造 mapped 值并检查扩容
+  template<class... Args>
+  pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return rep.try_emplace_unique(key, _pair_emplace, key, TinySTL::forward<Args>(args)...);
+  }
+  template<class... Args>
+  pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return rep.try_emplace_unique(key, _pair_emplace, TinySTL::move(key),
+                                  TinySTL::forward<Args>(args)...);
+  }
+  // key 存在时赋值，否则插入；返回值的 second 表示是否插入
+  template<class M>
+  pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+    pair<iterator, bool> r =
+        rep.try_emplace_unique(key, _pair_emplace, key, TinySTL::forward<M>(obj));
+    if (!r.second) r.first->second = TinySTL::forward<M>(obj);
+    return r;
   }
+  template<class M>
+  pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj) {
+    pair<iterator, bool> r = rep.try_emplace_unique(key, _pair_emplace, TinySTL::move(key),
+                                                    TinySTL::forward<M>(obj));
+    if (!r.second) r.first->second = TinySTL::forward<M>(obj);
+    return r;
+  }
+
+ public:// node handle
+  using node_type = typename ht::node_type;
+  using insert_return_type = typename ht::insert_return_type;
+  node_type extract(iterator it) noexcept { return rep.extract(it); }
+  node_type extract(const key_type &key) { return rep.extract(key); }
+  insert_return_type insert(node_type &&nh) { return rep.insert_unique(TinySTL::move(nh)); }
+  // 移入 src 中键值不重复的元素，只重新链接节点
+  void merge(hash_map &src) { rep.merge_unique(src.rep); }
 
  public:// erase
   size_type erase(const key_type &key) { return rep.erase(key); }
@@ -112,6 +151,17 @@ class hash_map {
   iterator find(const key_type &key) { return rep.find(key); }
   const_iterator find(const key_type &key) const { return rep.find(key); }
   size_type count(const key_type &key) const { return rep.count(key); }
+
+ public:// heterogeneous find，仅当 HashFcn 与 EqualKey 均有 is_transparent 时可用
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  iterator find(const K &key) { return rep.find(key); }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  const_iterator find(const K &key) const { return rep.find(key); }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  size_type count(const K &key) const { return rep.count(key); }
 };
 
 template<class Key, class Value, class HashFcn, class EqualKey, class Alloc>
@@ -86,6 +86,18 @@ class hash_set {
     rep.insert_unique(first, last);
   }
 
+ public:// node handle
+  using node_type = typename ht::node_type;
+  using insert_return_type = node_insert_return<iterator, node_type>;
+  node_type extract(iterator it) noexcept { return rep.extract(it); }
+  node_type extract(const key_type &key) { return rep.extract(key); }
+  insert_return_type insert(node_type &&nh) {
+    typename ht::insert_return_type r = rep.insert_unique(TinySTL::move(nh));
+    return insert_return_type{r.position, r.inserted, TinySTL::move(r.node)};
+  }
+  // 移入 src 中键值不重复的元素，只重新链接节点
+  void merge(hash_set &src) { rep.merge_unique(src.rep); }
+
  public:// erase
   size_type erase(const key_type &key) { return rep.erase(key); }
   void erase(iterator it) { rep.erase(it); }
@@ -95,6 +107,14 @@ class hash_set {
  public:// find
   iterator find(const key_type &key) const { return rep.find(key); }
   size_type count(const key_type &key) const { return rep.count(key); }
+
+ public:// heterogeneous find，仅当 HashFcn 与 EqualKey 均有 is_transparent 时可用
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  iterator find(const K &key) const { return rep.find(key); }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  size_type count(const K &key) const { return rep.count(key); }
 };
 
 template<class Value, class HashFcn, class EqualKey, class Alloc>
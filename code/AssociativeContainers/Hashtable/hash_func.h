@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstring>
 #include <string>
+#include <string_view>
 
 namespace TinySTL {
 
@@ -18,6 +20,13 @@ inline size_t _stl_hash_string(const char *s) {
   return static_cast<size_t>(h);
 }
 
+// 指定长度的版本，与上者对不含 '\0' 的字符串结果相同
+inline size_t _stl_hash_string(const char *s, size_t n) {
+  unsigned long h = 0;
+  for (size_t i = 0; i < n; ++i) h = 5 * h + s[i];
+  return static_cast<size_t>(h);
+}
+
 template<>
 struct hash<char *> {
   size_t operator()(const char *s) const noexcept {
@@ -40,6 +49,21 @@ struct hash<std::string> {
   }
 };
 
+// 透明的字符串哈希：std::string、std::string_view 与 const char* 得到相同结果，
+// 配合 equal_to<void> 可在 hash_map<std::string, T> 中直接以后两者查找
+struct string_hash {
+  using is_transparent = void;
+  size_t operator()(std::string_view s) const noexcept {
+    return _stl_hash_string(s.data(), s.size());
+  }
+  size_t operator()(const std::string &s) const noexcept {
+    return _stl_hash_string(s.data(), s.size());
+  }
+  size_t operator()(const char *s) const noexcept {
+    return _stl_hash_string(s, std::strlen(s));
+  }
+};
+
 template<>
 struct hash<char> {
   size_t operator()(char x) const noexcept { return x; }
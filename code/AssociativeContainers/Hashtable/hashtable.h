@@ -10,6 +10,7 @@ hashtable的几乎所有操作，核心都是:
 #include "algobase/stl_algobase.h"
 #include "allocator.h"
 #include "stl_iterator.h"
+#include "Utils/node_handle.h"
 #include <cstddef>
 #include <algorithm>
 
@@ -155,6 +156,20 @@ class hashtable {
       hashtable_const_iterator<Value, Key, HashFcn, ExtractKey, EqualKey,
                                Alloc>;
 
+ private:// node handle
+  struct node_traits {
+    using node_pointer = hashtable_node<Value> *;
+    static value_type &value(node_pointer p) { return p->val; }
+    static void destroy(node_pointer p) {
+      TinySTL::destroy(&p->val);
+      simpleAlloc<hashtable_node<Value>>::deallocate(p);
+    }
+  };
+
+ public:
+  using node_type = node_handle<value_type, node_traits>;
+  using insert_return_type = node_insert_return<iterator, node_type>;
+
  private:// data member
   // function object
   hasher hash;
@@ -168,14 +183,16 @@ class hashtable {
   size_type num_elements;
 
  private:// allocate && deallocate
-  node *new_node(const value_type &obj) {
+  template<class... Args>
+  node *new_node(Args &&...args) {
     node *n = node_allocator::allocate();
+    n->next = nullptr;// copy_from 依赖新节点的 next 为空
     try {
-      construct(&n->val, obj);
+      construct(&n->val, TinySTL::forward<Args>(args)...);
       return n;
     } catch (std::exception &) {
       node_allocator::deallocate(n);
-      return nullptr;
+      throw;
     }
   }
 
@@ -193,25 +210,85 @@ class hashtable {
     num_elements = 0;
   }
 
-  size_type bkt_num_key(const key_type &key) const noexcept {
+  // K 为 key_type 或透明哈希下的任意类型
+  template<class K>
+  size_type bkt_num_key(const K &key) const noexcept {
     return bkt_num_key(key, buckets.size());
   }
   size_type bkt_num(const value_type &obj) const noexcept {
     return bkt_num_key(get_key(obj));
   }
-  size_type bkt_num_key(const key_type &key, size_t n) const noexcept {
+  template<class K>
+  size_type bkt_num_key(const K &key, size_t n) const noexcept {
     return hash(key) % n;
   }
   size_type bkt_num(const value_type &obj, size_type n) const noexcept {
     return bkt_num_key(get_key(obj), n);
   }
 
+  // 确定要插入后才检查扩容；表格重建时重新计算 key 所在的 bucket
+  template<class K>
+  size_type grow_for_insert(const K &key, size_type n) {
+    const size_type old_n = buckets.size();
+    resize(num_elements + 1);
+    return buckets.size() == old_n ? n : bkt_num_key(key);
+  }
+
   void erase_bucket(size_type n, node *first, node *last);
   void erase_bucket(size_type n, node *last);
 
+ private:// aux interface for find
+  template<class K>
+  node *find_node(const K &key) const noexcept {
+    return find_node(key, bkt_num_key(key));
+  }
+  // 在已知的第 n 个 bucket 中查找，省去重复计算哈希
+  template<class K>
+  node *find_node(const K &key, size_type n) const noexcept {
+    node *first = buckets[n];
+    while (first && !equals(get_key(first->val), key)) first = first->next;
+    return first;
+  }
+  template<class K>
+  size_type count_node(const K &key) const noexcept {
+    size_type result = 0;
+    for (const node *cur = buckets[bkt_num_key(key)]; cur; cur = cur->next)
+      if (equals(get_key(cur->val), key)) ++result;
+    return result;
+  }
+  // 与 key 相等的一段节点 [first, last)，last 可能位于后续 bucket，不存在时均为空
+  template<class K>
+  pair<node *, node *> equal_range_node(const K &key) const noexcept {
+    using pnn = pair<node *, node *>;
+    const size_type n = bkt_num_key(key);
+    for (node *first = buckets[n]; first; first = first->next)
+      if (equals(get_key(first->val), key)) {
+        for (node *cur = first->next; cur; cur = cur->next)
+          if (!equals(get_key(cur->val), key)) return pnn(first, cur);
+        for (size_type m = n + 1; m < buckets.size(); ++m)
+          if (buckets[m]) return pnn(first, buckets[m]);
+        return pnn(first, nullptr);
+      }
+    return pnn(nullptr, nullptr);
+  }
+
  private:// aux interface
   pair<iterator, bool> insert_unique_noreseize(const value_type &);
   iterator insert_equal_noresize(const value_type &);
+  // 将已构造的节点 p 链入第 n 个 bucket：prev 非空时置于其后（使相同键值相邻），否则作为头部
+  iterator link_node(size_type n, node *prev, node *p) noexcept {
+    if (prev) {
+      p->next = prev->next;
+      prev->next = p;
+    } else {
+      p->next = buckets[n];
+      buckets[n] = p;
+    }
+    ++num_elements;
+    return iterator(p, this);
+  }
+  // 将节点自其 bucket 中摘除但不销毁，不在表中时返回 nullptr
+  node *unlink_node(node *p) noexcept;
   void copy_from(const hashtable &);
 
  public:// ctor && dtor
@@ -267,6 +344,16 @@ class hashtable {
   template<class ForwardIterator>
   void insert_equal(ForwardIterator, ForwardIterator, forward_iterator_tag);
 
+ public:// emplace
+  // 先以 args 构造节点再查找，键值重复时销毁该节点
+  template<class... Args>
+  pair<iterator, bool> emplace_unique(Args &&...args);
+  template<class... Args>
+  iterator emplace_equal(Args &&...args);
+  // 键值 key 不存在时才以 args 构造元素（其键值须与 key 相等），命中时既不构造也不扩容
+  template<class... Args>
+  pair<iterator, bool> try_emplace_unique(const key_type &key, Args &&...args);
+
  public:                                       // find
   reference find_or_insert(const value_type &);// interface for map
   iterator find(const key_type &);
@@ -275,6 +362,36 @@ class hashtable {
   pair<iterator, iterator> equal_range(const key_type &);
   pair<const_iterator, const_iterator> equal_range(const key_type &) const;
 
+ public:// heterogeneous find，仅当 HashFcn 与 EqualKey 均有 is_transparent 时可用
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  iterator find(const K &key) {
+    return iterator(find_node(key), this);
+  }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  const_iterator find(const K &key) const {
+    return const_iterator(find_node(key), this);
+  }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  size_type count(const K &key) const {
+    return count_node(key);
+  }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  pair<iterator, iterator> equal_range(const K &key) {
+    pair<node *, node *> p = equal_range_node(key);
+    return pair<iterator, iterator>(iterator(p.first, this), iterator(p.second, this));
+  }
+  template<class K, class H = HashFcn, class E = EqualKey,
+           class = enable_if_t<has_is_transparent<H>::value && has_is_transparent<E>::value>>
+  pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    pair<node *, node *> p = equal_range_node(key);
+    return pair<const_iterator, const_iterator>(const_iterator(p.first, this),
+                                                const_iterator(p.second, this));
+  }
+
  public:// insert
   pair<iterator, bool> insert_unique(const value_type &);
   iterator insert_equal(const value_type &);
@@ -287,6 +404,21 @@ class hashtable {
     insert_equal(first, last, iterator_category_t<InputIterator>());
   }
 
+ public:// node handle：节点在表间转移时只重新链接，不分配、不复制
+  node_type extract(const iterator &pos) noexcept {
+    return node_type(pos.cur ? unlink_node(pos.cur) : nullptr);
+  }
+  node_type extract(const const_iterator &pos) noexcept {
+    return extract(iterator(const_cast<node *>(pos.cur), this));
+  }
+  node_type extract(const key_type &key) { return extract(find(key)); }
+  // 键值重复时插入失败，节点留在返回值的 node 中
+  insert_return_type insert_unique(node_type &&);
+  iterator insert_equal(node_type &&);
+  // 将 src 的节点移入本表；unique 版本中与本表键值重复的节点留在 src
+  void merge_unique(hashtable &src);
+  void merge_equal(hashtable &src);
+
  public:// erase
   size_type erase(const key_type &);
   void erase(const iterator &);
@@ -453,17 +585,10 @@ inline pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
           Alloc>::insert_unique_noreseize(const value_type &obj) {
   const size_type n = bkt_num(obj);// 决定位于哪个bucket
-  node *first = buckets[n];
-  for (node *cur = first; cur; cur = cur->next) {
-    if (equals(get_key(cur->val), get_key(obj)))// 存在相同键值，拒绝插入
-      return pair<iterator, bool>(iterator(cur, this), false);
-  }
-  // 当前已离开循环或根本未进入循环,创造新节点并将其作为bucket的头部
-  node *temp = new_node(obj);
-  temp->next = first;
-  buckets[n] = temp;
-  ++num_elements;
-  return pair<iterator, bool>(iterator(temp, this), true);
+  if (node *cur = find_node(get_key(obj), n))// 存在相同键值，拒绝插入
+    return pair<iterator, bool>(iterator(cur, this), false);
+  // 创造新节点并将其作为bucket的头部
+  return pair<iterator, bool>(link_node(n, nullptr, new_node(obj)), true);
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -472,21 +597,8 @@ typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
           Alloc>::insert_equal_noresize(const value_type &obj) {
   const size_type n = bkt_num(obj);
-  node *first = buckets[n];
-  for (node *cur = first; cur; cur = cur->next) {
-    if (equals(get_key(cur->val), get_key(obj))) {
-      node *temp = new_node(obj);
-      temp->next = cur->next;
-      cur->next = temp;
-      ++num_elements;
-      return iterator(temp, this);
-    }
-  }
-  node *temp = new_node(obj);
-  temp->next = first;
-  buckets[n] = temp;
-  ++num_elements;
-  return iterator(temp, this);
+  // 若存在相同键值，新节点紧随其后
+  return link_node(n, find_node(get_key(obj), n), new_node(obj));
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -494,19 +606,10 @@ template<class Value, class Key, class HashFcn, class ExtractKey,
 typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::reference
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::find_or_insert(
     const value_type &obj) {
-  resize(num_elements + 1);
-
   size_type n = bkt_num(obj);
-  node *first = buckets[n];
-
-  for (node *cur = first; cur; cur = cur->next)
-    if (equals(get_key(cur->val), get_key(obj))) return cur->val;
-
-  node *temp = new_node(obj);
-  temp->next = first;
-  buckets[n] = temp;
-  ++num_elements;
-  return temp->val;
+  if (node *cur = find_node(get_key(obj), n)) return cur->val;
+  n = grow_for_insert(get_key(obj), n);
+  return link_node(n, nullptr, new_node(obj)).cur->val;
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -514,12 +617,7 @@ template<class Value, class Key, class HashFcn, class ExtractKey,
 typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::find(
     const key_type &key) {
-  size_type n = bkt_num_key(key);
-  node *first;
-  for (first = buckets[n]; first && !equals(get_key(first->val), key);
-       first = first->next) {
-  }
-  return iterator(first, this);
+  return iterator(find_node(key), this);
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -528,12 +626,7 @@ typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
                    Alloc>::const_iterator
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::find(
     const key_type &key) const {
-  size_type n = bkt_num_key(key);
-  node *first;
-  for (first = buckets[n]; first && !equals(get_key(first->val), key);
-       first = first->next) {
-  }
-  return const_iterator(first, this);
+  return const_iterator(find_node(key), this);
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -541,11 +634,7 @@ template<class Value, class Key, class HashFcn, class ExtractKey,
 typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::size_type
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::count(
     const key_type &key) const {
-  const size_type n = bkt_num_key(key);
-  size_type result = 0;
-  for (const node *cur = buckets[n]; cur; cur = cur->next)
-    if (equals(get_key(cur->val), key)) ++result;
-  return result;
+  return count_node(key);
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -556,20 +645,8 @@ pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
                         Alloc>::iterator>
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::equal_range(
     const key_type &key) {
-  using pii = pair<iterator, iterator>;
-  const size_type n = bkt_num_key(key);
-
-  for (node *first = buckets[n]; first; first = first->next)
-    if (equals(get_key(first->val), key)) {
-      for (node *cur = first->next; cur; cur = cur->next)
-        if (!equals(get_key(cur->val), key))
-          return pii(iterator(first, this), iterator(cur, this));
-      for (size_type m = n + 1; m < buckets.size(); ++m)
-        if (buckets[m])
-          return pii(iterator(first, this), iterator(buckets[m], this));
-      return pii(iterator(first, this), end());
-    }
-  return pii(end(), end());
+  pair<node *, node *> p = equal_range_node(key);
+  return pair<iterator, iterator>(iterator(p.first, this), iterator(p.second, this));
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -580,21 +657,9 @@ pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
                         Alloc>::const_iterator>
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::equal_range(
     const key_type &key) const {
-  using pii = pair<const_iterator, const_iterator>;
-  const size_type n = bkt_num_key(key);
-
-  for (const node *first = buckets[n]; first; first = first->next)
-    if (equals(get_key(first->val), key)) {
-      for (const node *cur = first->next; cur; cur = cur->next)
-        if (!equals(get_key(cur->val), key))
-          return pii(const_iterator(first, this),
-                     const_iterator(cur, this));
-      for (size_type m = n + 1; m < buckets.size(); ++m)
-        if (buckets[m])
-          return pii(const_iterator(first, this), const_iterator(buckets[m], this));
-      return pii(const_iterator(first, this), cend());
-    }
-  return pii(cend(), cend());
+  pair<node *, node *> p = equal_range_node(key);
+  return pair<const_iterator, const_iterator>(const_iterator(p.first, this),
+                                              const_iterator(p.second, this));
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -604,8 +669,11 @@ inline pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey,
             bool>
 hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::insert_unique(
     const value_type &obj) {
-  resize(num_elements + 1);// 判断是否需要扩充
-  return insert_unique_noreseize(obj);
+  size_type n = bkt_num(obj);
+  if (node *cur = find_node(get_key(obj), n))// 键值重复时不触发扩容
+    return pair<iterator, bool>(iterator(cur, this), false);
+  n = grow_for_insert(get_key(obj), n);
+  return pair<iterator, bool>(link_node(n, nullptr, new_node(obj)), true);
 }
 
 template<class Value, class Key, class HashFcn, class ExtractKey,
@@ -689,34 +757,144 @@ hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::erase(
 }
 template<class Value, class Key, class HashFcn, class ExtractKey,
          class EqualKey, class Alloc>
-void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::erase(
-    const iterator &pos) {
-  node *p = pos.cur;
-  if (p) {
-    const size_type n = bkt_num(p->val);
-    node *cur = buckets[n];
+typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::node *
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::unlink_node(node *p) noexcept {
+  const size_type n = bkt_num(p->val);
+  node *cur = buckets[n];
+  if (cur == p) {
+    buckets[n] = cur->next;
+  } else {
+    while (cur && cur->next != p) cur = cur->next;
+    if (!cur) return nullptr;
+    cur->next = p->next;
+  }
+  --num_elements;
+  return p;
+}
 
-    if (cur == p) {
-      buckets[n] = cur->next;
-      delete_node(cur);
-      --num_elements;
-    } else {
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::insert_return_type
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::insert_unique(node_type &&nh) {
+  if (nh.empty()) return insert_return_type{end(), false, node_type()};
+  size_type n = bkt_num(nh.ptr->val);
+  if (node *cur = find_node(get_key(nh.ptr->val), n))
+    return insert_return_type{iterator(cur, this), false, TinySTL::move(nh)};
+  n = grow_for_insert(get_key(nh.ptr->val), n);
+  return insert_return_type{link_node(n, nullptr, nh.release()), true, node_type()};
+}
+
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::insert_equal(node_type &&nh) {
+  if (nh.empty()) return end();
+  resize(num_elements + 1);
+  const size_type n = bkt_num(nh.ptr->val);
+  return link_node(n, find_node(get_key(nh.ptr->val), n), nh.release());
+}
+
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+template<class... Args>
+pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator, bool>
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::emplace_unique(Args &&...args) {
+  node *p = new_node(TinySTL::forward<Args>(args)...);
+  size_type n;
+  try {
+    n = bkt_num(p->val);
+    if (node *cur = find_node(get_key(p->val), n)) {
+      delete_node(p);
+      return pair<iterator, bool>(iterator(cur, this), false);
+    }
+    n = grow_for_insert(get_key(p->val), n);
+  } catch (std::exception &) {
+    delete_node(p);
+    throw;
+  }
+  return pair<iterator, bool>(link_node(n, nullptr, p), true);
+}
+
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+template<class... Args>
+typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::emplace_equal(Args &&...args) {
+  node *p = new_node(TinySTL::forward<Args>(args)...);
+  try {
+    resize(num_elements + 1);
+  } catch (std::exception &) {
+    delete_node(p);
+    throw;
+  }
+  const size_type n = bkt_num(p->val);
+  return link_node(n, find_node(get_key(p->val), n), p);
+}
+
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+template<class... Args>
+pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator, bool>
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::try_emplace_unique(
+    const key_type &key, Args &&...args) {
+  size_type n = bkt_num_key(key);
+  if (node *cur = find_node(key, n)) return pair<iterator, bool>(iterator(cur, this), false);
+  n = grow_for_insert(key, n);
+  return pair<iterator, bool>(link_node(n, nullptr, new_node(TinySTL::forward<Args>(args)...)), true);
+}
+
+// 逐个 bucket 摘取 src 的节点，借助前驱指针 O(1) 摘除
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::merge_unique(hashtable &src) {
+  if (&src == this) return;
+  for (size_type b = 0; b < src.buckets.size(); ++b) {
+    node *prev = nullptr;
+    node *cur = src.buckets[b];
+    while (cur) {
       node *next = cur->next;
-      while (next) {
-        if (next == p) {
-          cur->next = next->next;
-          delete_node(next);
-          --num_elements;
-          break;
-        } else {
-          cur = next;
-          next = cur->next;
-        }
+      if (find_node(get_key(cur->val))) {
+        prev = cur;// 重复，留在 src
+      } else {
+        // 先扩容：resize 抛出异常时节点仍留在 src
+        resize(num_elements + 1);
+        (prev ? prev->next : src.buckets[b]) = next;
+        --src.num_elements;
+        link_node(bkt_num(cur->val), nullptr, cur);
       }
+      cur = next;
     }
   }
 }
 
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::merge_equal(hashtable &src) {
+  if (&src == this) return;
+  resize(num_elements + src.num_elements);
+  for (size_type b = 0; b < src.buckets.size(); ++b) {
+    node *cur = src.buckets[b];
+    src.buckets[b] = nullptr;
+    while (cur) {
+      node *next = cur->next;
+      const size_type n = bkt_num(cur->val);
+      link_node(n, find_node(get_key(cur->val), n), cur);
+      cur = next;
+    }
+  }
+  src.num_elements = 0;
+}
+
+template<class Value, class Key, class HashFcn, class ExtractKey,
+         class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::erase(
+    const iterator &pos) {
+  if (pos.cur) {
+    node *p = unlink_node(pos.cur);
+    if (p) delete_node(p);
+  }
+}
+
 template<class Value, class Key, class HashFcn, class ExtractKey,
          class EqualKey, class Alloc>
 void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::erase(
@@ -0,0 +1,285 @@
+/*
+intrusive_hashtable: 侵入式哈希表
+与 hashtable 相同的开链法与质数表，但 bucket 中串起的是用户对象内嵌的 intrusive_hash_hook，
+而非 hashtable_node。插入与删除不配置任何节点，唯一的配置来自 bucket 数组扩容（可用构造参数预留）。
+钩子中缓存了元素的哈希值，扩容重排与迭代器跨 bucket 前进时无需再次调用哈希函数。
+容器不拥有元素，元素析构前必须先从容器中移除。
+*/
+#pragma once
+
+#include "AssociativeContainers/Hashtable/hash_func.h"
+#include "AssociativeContainers/Hashtable/hashtable.h"
+#include "Function/function_adapter.h"
+#include "SequenceContainers/IntrusiveList/stl_intrusive_list.h"
+#include <cstddef>
+
+namespace TinySTL {
+
+struct intrusive_hash_hook {
+  intrusive_hash_hook *next;
+  size_t hash_code;// 缓存的哈希值
+
+  intrusive_hash_hook() noexcept : next(nullptr), hash_code(0) {}
+  intrusive_hash_hook(const intrusive_hash_hook &) noexcept : next(nullptr), hash_code(0) {}
+  intrusive_hash_hook &operator=(const intrusive_hash_hook &) noexcept { return *this; }
+};
+
+template<class T, class Key, intrusive_hash_hook T::*Member, class ExtractKey,
+         class HashFcn, class EqualKey>
+class intrusive_hashtable;
+
+template<class T, class Key, intrusive_hash_hook T::*Member, class ExtractKey,
+         class HashFcn, class EqualKey, class Ref, class Ptr>
+struct _intrusive_hashtable_iterator {
+  using _hashtable = intrusive_hashtable<T, Key, Member, ExtractKey, HashFcn, EqualKey>;
+  using iterator = _intrusive_hashtable_iterator<T, Key, Member, ExtractKey, HashFcn,
+                                                 EqualKey, T &, T *>;
+  using self = _intrusive_hashtable_iterator;
+
+  using iterator_category = forward_iterator_tag;
+  using value_type = T;
+  using difference_type = ptrdiff_t;
+  using size_type = size_t;
+  using reference = Ref;
+  using pointer = Ptr;
+
+  intrusive_hash_hook *cur;
+  const _hashtable *ht;
+
+  _intrusive_hashtable_iterator() : cur(nullptr), ht(nullptr) {}
+  _intrusive_hashtable_iterator(intrusive_hash_hook *n, const _hashtable *tab) : cur(n), ht(tab) {}
+  _intrusive_hashtable_iterator(const iterator &rhs) : cur(rhs.cur), ht(rhs.ht) {}
+
+  reference operator*() const { return *_intrusive_owner<T, intrusive_hash_hook, Member>(cur); }
+  pointer operator->() const { return &(operator*()); }
+
+  self &operator++() {
+    intrusive_hash_hook *old = cur;
+    cur = cur->next;
+    if (!cur) {
+      // 根据缓存的哈希值定位下一个 bucket
+      size_type bucket = old->hash_code % ht->buckets.size();
+      while (!cur && ++bucket < ht->buckets.size()) cur = ht->buckets[bucket];
+    }
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++*this;
+    return temp;
+  }
+
+  bool operator==(const self &rhs) const { return cur == rhs.cur; }
+  bool operator!=(const self &rhs) const { return cur != rhs.cur; }
+};
+
+template<class T, class Key, intrusive_hash_hook T::*Member, class ExtractKey,
+         class HashFcn = hash<Key>, class EqualKey = equal_to<Key>>
+class intrusive_hashtable {
+  friend struct _intrusive_hashtable_iterator<T, Key, Member, ExtractKey, HashFcn, EqualKey,
+                                              T &, T *>;
+  friend struct _intrusive_hashtable_iterator<T, Key, Member, ExtractKey, HashFcn, EqualKey,
+                                              const T &, const T *>;
+
+ public:// alias declarations
+  using hasher = HashFcn;
+  using key_equal = EqualKey;
+  using size_type = size_t;
+  using value_type = T;
+  using key_type = Key;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+
+  using iterator = _intrusive_hashtable_iterator<T, Key, Member, ExtractKey, HashFcn,
+                                                 EqualKey, T &, T *>;
+  using const_iterator = _intrusive_hashtable_iterator<T, Key, Member, ExtractKey, HashFcn,
+                                                       EqualKey, const T &, const T *>;
+
+ private:// data member
+  hasher hash;
+  key_equal equals;
+  ExtractKey get_key;
+
+  using node = intrusive_hash_hook;
+
+  vector<node *> buckets;
+  size_type num_elements;
+
+ private:// aux interface
+  static node *hook_of(T &x) noexcept { return &(x.*Member); }
+  static T &owner(node *n) noexcept { return *_intrusive_owner<T, node, Member>(n); }
+  const key_type &key_of(node *n) const { return get_key(owner(n)); }
+
+  void initialize_buckets(size_type n) {
+    const size_type n_buckets = _stl_next_prime(n);
+    buckets.reserve(n_buckets);
+    buckets.insert(buckets.end(), n_buckets, static_cast<node *>(nullptr));
+    num_elements = 0;
+  }
+  size_type bkt_num_code(size_t code) const noexcept { return code % buckets.size(); }
+
+  // 在 bucket 中寻找与 x 等值的钩子；先比较缓存的哈希值，相同时才比较键
+  node *find_in_bucket(size_type n, size_t code, const key_type &key) const {
+    for (node *cur = buckets[n]; cur; cur = cur->next)
+      if (cur->hash_code == code && equals(key_of(cur), key)) return cur;
+    return nullptr;
+  }
+  // 从 bucket 中摘下 p
+  void unlink(node *p) noexcept {
+    node **link = &buckets[bkt_num_code(p->hash_code)];
+    while (*link != p) link = &(*link)->next;
+    *link = p->next;
+    p->next = nullptr;
+    --num_elements;
+  }
+
+ public:// ctor && dtor
+  explicit intrusive_hashtable(size_type n = 53, const hasher &hf = hasher(),
+                               const key_equal &eql = key_equal(),
+                               const ExtractKey &ext = ExtractKey())
+      : hash(hf), equals(eql), get_key(ext), num_elements(0) {
+    initialize_buckets(n);
+  }
+  intrusive_hashtable(const intrusive_hashtable &) = delete;
+  intrusive_hashtable &operator=(const intrusive_hashtable &) = delete;
+  ~intrusive_hashtable() { clear(); }
+
+ public:// getter
+  hasher hash_func() const noexcept { return hash; }
+  key_equal key_eq() const noexcept { return equals; }
+  size_type bucket_count() const noexcept { return buckets.size(); }
+  size_type size() const noexcept { return num_elements; }
+  bool empty() const noexcept { return size() == 0; }
+
+  const_iterator begin() const noexcept {
+    for (size_type n = 0; n < buckets.size(); ++n)
+      if (buckets[n]) return const_iterator(buckets[n], this);
+    return end();
+  }
+  const_iterator end() const noexcept { return const_iterator(nullptr, this); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+ public:// setter
+  iterator begin() noexcept {
+    for (size_type n = 0; n < buckets.size(); ++n)
+      if (buckets[n]) return iterator(buckets[n], this);
+    return end();
+  }
+  iterator end() noexcept { return iterator(nullptr, this); }
+
+  iterator iterator_to(reference x) noexcept { return iterator(hook_of(x), this); }
+
+  // 与 hashtable::resize 相同的原则：元素个数超过 bucket 数时扩容至下一个质数；
+  // 直接使用缓存的哈希值重排，不调用哈希函数
+  void resize(size_type num_elements_hint) {
+    const size_type old_n = buckets.size();
+    if (num_elements_hint <= old_n) return;
+    const size_type n = _stl_next_prime(num_elements_hint);
+    if (n <= old_n) return;
+    vector<node *> temp(n, static_cast<node *>(nullptr));
+    for (size_type bucket = 0; bucket < old_n; ++bucket) {
+      node *first = buckets[bucket];
+      while (first) {
+        size_type new_bucket = first->hash_code % n;
+        buckets[bucket] = first->next;
+        first->next = temp[new_bucket];
+        temp[new_bucket] = first;
+        first = buckets[bucket];
+      }
+    }
+    buckets.swap(temp);
+  }
+
+ public:// find
+  iterator find(const key_type &key) {
+    size_t code = hash(key);
+    return iterator(find_in_bucket(bkt_num_code(code), code, key), this);
+  }
+  const_iterator find(const key_type &key) const {
+    size_t code = hash(key);
+    return const_iterator(find_in_bucket(bkt_num_code(code), code, key), this);
+  }
+  size_type count(const key_type &key) const {
+    size_t code = hash(key);
+    size_type result = 0;
+    for (node *cur = buckets[bkt_num_code(code)]; cur; cur = cur->next)
+      if (cur->hash_code == code && equals(key_of(cur), key)) ++result;
+    return result;
+  }
+
+ public:// insert，要求 x 的钩子尚未链入任何容器
+  pair<iterator, bool> insert_unique(reference x) {
+    resize(num_elements + 1);
+    node *h = hook_of(x);
+    h->hash_code = hash(get_key(x));
+    const size_type n = bkt_num_code(h->hash_code);
+    if (node *same = find_in_bucket(n, h->hash_code, get_key(x)))
+      return pair<iterator, bool>(iterator(same, this), false);
+    h->next = buckets[n];
+    buckets[n] = h;
+    ++num_elements;
+    return pair<iterator, bool>(iterator(h, this), true);
+  }
+  // 等值元素相邻存放，与 hashtable::insert_equal 一致
+  iterator insert_equal(reference x) {
+    resize(num_elements + 1);
+    node *h = hook_of(x);
+    h->hash_code = hash(get_key(x));
+    const size_type n = bkt_num_code(h->hash_code);
+    if (node *same = find_in_bucket(n, h->hash_code, get_key(x))) {
+      h->next = same->next;
+      same->next = h;
+    } else {
+      h->next = buckets[n];
+      buckets[n] = h;
+    }
+    ++num_elements;
+    return iterator(h, this);
+  }
+
+ public:// erase，只摘链，不析构
+  void erase(const_iterator pos) noexcept { unlink(pos.cur); }
+  // 要求 x 位于本容器中
+  void remove(reference x) noexcept { unlink(hook_of(x)); }
+  size_type erase(const key_type &key) {
+    size_t code = hash(key);
+    size_type erased = 0;
+    node **link = &buckets[bkt_num_code(code)];
+    while (*link) {
+      node *cur = *link;
+      if (cur->hash_code == code && equals(key_of(cur), key)) {
+        *link = cur->next;
+        cur->next = nullptr;
+        ++erased;
+      } else {
+        link = &cur->next;
+      }
+    }
+    num_elements -= erased;
+    return erased;
+  }
+  void clear() noexcept {
+    for (size_type i = 0; i != buckets.size(); ++i) {
+      node *cur = buckets[i];
+      while (cur) {
+        node *next = cur->next;
+        cur->next = nullptr;
+        cur = next;
+      }
+      buckets[i] = nullptr;
+    }
+    num_elements = 0;
+  }
+
+  void swap(intrusive_hashtable &rhs) noexcept {
+    TinySTL::swap(hash, rhs.hash);
+    TinySTL::swap(equals, rhs.equals);
+    TinySTL::swap(get_key, rhs.get_key);
+    buckets.swap(rhs.buckets);
+    TinySTL::swap(num_elements, rhs.num_elements);
+  }
+};
+
+}// namespace TinySTL
@@ -0,0 +1,171 @@
+/*
+interval_map: 以半开区间 [lo, hi) 为键的有序多重映射，允许相同或相互重叠的区间。
+底层为按 (lo, hi) 排序的 rb_tree，每个节点附加其子树中最大的右端点 hi。
+重叠查询跳过最大右端点不超过查询左端的子树，并在区间左端到达查询右端后停止，
+因此只访问结果所在的路径：O(log n + k)，最坏情况 O(k log n)，k 为结果数。
+*/
+#pragma once
+
+#include "AssociativeContainers/RB-Tree/rb_tree.h"
+#include "Function/function_adapter.h"
+
+namespace TinySTL {
+
+// Compare 须可默认构造且无状态（附加数据在旋转中以静态方式更新）
+template<class Key, class T, class Compare = less<Key>, class Alloc = simpleAlloc<T>>
+class interval_map {
+ public:
+  using point_type = Key;
+  using key_type = pair<Key, Key>;// [first, second)
+  using interval_type = key_type;
+  using data_type = T;
+  using value_type = pair<const key_type, T>;
+  using point_compare = Compare;
+
+  // 先比较左端点，再比较右端点
+  struct key_compare {
+    bool operator()(const key_type &x, const key_type &y) const {
+      Compare comp;
+      return comp(x.first, y.first) || (!comp(y.first, x.first) && comp(x.second, y.second));
+    }
+  };
+
+ private:// data member
+  struct high_of {
+    const Key &operator()(const value_type &v) const { return v.first.second; }
+  };
+  using augment = rb_tree_max_augment<Key, high_of, Compare>;
+  using rep_type = rb_tree<key_type, value_type, select1st<value_type>, key_compare,
+                           Alloc, augment>;
+  rep_type t;
+
+ public:// Alias declarations
+  using pointer = typename rep_type::pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ private:// aux interface
+  // 对与 [lo, hi) 相交的每个元素调用 f，f 返回 false 时停止
+  template<class Tree, class F>
+  static void visit_overlap(Tree &tree, const Key &lo, const Key &hi, F f) {
+    Compare comp;
+    if (!comp(lo, hi)) return;
+    tree.augmented_visit(
+        [&](const Key &max_hi) { return !comp(lo, max_hi); },
+        [&](auto it) {
+          if (!comp(it->first.first, hi)) return false;
+          return !comp(lo, it->first.second) || f(it);
+        });
+  }
+  // 对包含点 p 的每个元素调用 f
+  template<class Tree, class F>
+  static void visit_containing(Tree &tree, const Key &p, F f) {
+    Compare comp;
+    tree.augmented_visit(
+        [&](const Key &max_hi) { return !comp(p, max_hi); },
+        [&](auto it) {
+          if (comp(p, it->first.first)) return false;
+          if (comp(p, it->first.second)) f(it);
+          return true;
+        });
+  }
+
+ public:// ctor
+  interval_map() : t(key_compare()) {}
+  template<class InputIterator>
+  interval_map(InputIterator first, InputIterator last) : t(key_compare()) {
+    t.insert_equal(first, last);
+  }
+  interval_map(const interval_map &rhs) : t(rhs.t) {}
+  interval_map &operator=(const interval_map &rhs) {
+    t = rhs.t;
+    return *this;
+  }
+
+ public:// getter
+  iterator begin() noexcept { return t.begin(); }
+  iterator end() noexcept { return t.end(); }
+  const_iterator begin() const noexcept { return t.begin(); }
+  const_iterator end() const noexcept { return t.end(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  reverse_iterator rbegin() noexcept { return t.rbegin(); }
+  reverse_iterator rend() noexcept { return t.rend(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+  // 所有区间右端点的最大值，要求非空
+  const Key &max_high() const noexcept { return t.aggregate(); }
+
+ public:// swap
+  void swap(interval_map &rhs) noexcept { t.swap(rhs.t); }
+
+ public:// insert && erase
+  iterator insert(const value_type &val) { return t.insert_equal(val); }
+  iterator insert(const Key &lo, const Key &hi, const T &val) {
+    return t.insert_equal(value_type(key_type(lo, hi), val));
+  }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_equal(first, last);
+  }
+  void erase(iterator pos) { t.erase(pos); }
+  size_type erase(const key_type &k) { return t.erase(k); }
+  void clear() { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &k) noexcept { return t.find(k); }
+  const_iterator find(const key_type &k) const noexcept { return t.find(k); }
+  size_type count(const key_type &k) const noexcept { return t.count(k); }
+
+ public:// interval query
+  // 是否存在与 [lo, hi) 相交的区间，O(log n)
+  bool overlaps(const Key &lo, const Key &hi) const {
+    bool found = false;
+    visit_overlap(t, lo, hi, [&](const_iterator) {
+      found = true;
+      return false;
+    });
+    return found;
+  }
+  // 按区间次序对每个与 [lo, hi) 相交的元素调用 f(iterator)
+  template<class F>
+  void for_each_overlap(const Key &lo, const Key &hi, F f) {
+    visit_overlap(t, lo, hi, [&](iterator it) { f(it); return true; });
+  }
+  template<class F>
+  void for_each_overlap(const Key &lo, const Key &hi, F f) const {
+    visit_overlap(t, lo, hi, [&](const_iterator it) { f(it); return true; });
+  }
+  // 按区间次序对每个包含点 p 的元素调用 f(iterator)
+  template<class F>
+  void for_each_containing(const Key &p, F f) {
+    visit_containing(t, p, f);
+  }
+  template<class F>
+  void for_each_containing(const Key &p, F f) const {
+    visit_containing(t, p, f);
+  }
+
+ public:// compare
+  friend bool operator==(const interval_map &lhs, const interval_map &rhs) {
+    return lhs.t == rhs.t;
+  }
+  friend bool operator!=(const interval_map &lhs, const interval_map &rhs) {
+    return !(lhs == rhs);
+  }
+};
+
+template<class Key, class T, class Compare, class Alloc>
+inline void swap(interval_map<Key, T, Compare, Alloc> &lhs,
+                 interval_map<Key, T, Compare, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
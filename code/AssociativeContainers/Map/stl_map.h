@@ -7,27 +7,33 @@ namespace TinySTL {
 
 // Forward declarations of operators == and <, needed for friend declarations.
 
-template<class Key, class T, class Compare, class Alloc>
+template<class Key, class T, class Compare, class Alloc, class Augment>
 class map;
 
-template<class Key, class T, class Compare, class Alloc>
-inline bool operator==(const map<Key, T, Compare, Alloc> &lhs,
-                       const map<Key, T, Compare, Alloc> &rhs);
+template<class Key, class T, class Compare, class Alloc, class Augment>
+inline bool operator==(const map<Key, T, Compare, Alloc, Augment> &lhs,
+                       const map<Key, T, Compare, Alloc, Augment> &rhs);
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator<(const map<Key, Tp, Compare, Alloc> &lhs,
-                      const map<Key, Tp, Compare, Alloc> &rhs);
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator<(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                      const map<Key, Tp, Compare, Alloc, Augment> &rhs);
+
+template<class Key, class T, class Compare, class Alloc, class Augment>
+class multimap;
 
 template<class Key, class T, class Compare = less<Key>,
-         class Alloc = simpleAlloc<T>>
+         class Alloc = simpleAlloc<T>, class Augment = rb_tree_no_augment>
 class map {
   // friend declarations
-  template<class _Key, class _T, class _Compare, class _Alloc>
-  friend bool operator==(const map<_Key, _T, _Compare, _Alloc> &lhs,
-                         const map<_Key, _T, _Compare, _Alloc> &rhs);
-  template<class _Key, class _T, class _Compare, class _Alloc>
-  friend bool operator<(const map<_Key, _T, _Compare, _Alloc> &lhs,
-                        const map<_Key, _T, _Compare, _Alloc> &rhs);
+  template<class _Key, class _T, class _Compare, class _Alloc, class _Augment>
+  friend bool operator==(const map<_Key, _T, _Compare, _Alloc, _Augment> &lhs,
+                         const map<_Key, _T, _Compare, _Alloc, _Augment> &rhs);
+  template<class _Key, class _T, class _Compare, class _Alloc, class _Augment>
+  friend bool operator<(const map<_Key, _T, _Compare, _Alloc, _Augment> &lhs,
+                        const map<_Key, _T, _Compare, _Alloc, _Augment> &rhs);
+  // merge 需访问同参数 multimap 的底层红黑树
+  template<class, class, class, class, class>
+  friend class multimap;
 
  public:// value comparator
   using key_type = Key;
@@ -36,7 +42,7 @@ class map {
   using key_compare = Compare;
 
   class value_compare : public binary_function<value_type, value_type, bool> {
-    friend class map<Key, T, Compare, Alloc>;
+    friend class map<Key, T, Compare, Alloc, Augment>;
 
    protected:
     Compare comp;
@@ -51,7 +57,7 @@ class map {
  private:// data member
   // select1st为SGI扩充。是一个函数对象模板类，用以返回pair的第一个元素的引用
   using rep_type = rb_tree<key_type, value_type, select1st<value_type>,
-                           key_compare, Alloc>;
+                           key_compare, Alloc, Augment>;
   rep_type t;// 底层红黑树
 
  public:// Alias declarations
@@ -78,7 +84,14 @@ class map {
       : t(comp) {
     t.insert_unique(first, last);
   }
-  map(const map<Key, T, Compare, Alloc> &rhs) : t(rhs.t) {}
+  // 调用者保证 [first, last) 已按键值有序，O(n) 建树
+  template<class InputIterator>
+  map(assign_sorted_t, InputIterator first, InputIterator last,
+      const key_compare &comp = key_compare())
+      : t(comp) {
+    t.assign_sorted_unique(first, last);
+  }
+  map(const map<Key, T, Compare, Alloc, Augment> &rhs) : t(rhs.t) {}
 
  public:// copy operation
   map &operator=(const map &rhs) {
@@ -86,6 +99,13 @@ class map {
     return *this;
   }
 
+ public:// move operation
+  map(map &&rhs) noexcept : t(TinySTL::move(rhs.t)) {}
+  map &operator=(map &&rhs) noexcept {
+    t = TinySTL::move(rhs.t);
+    return *this;
+  }
+
  public:// getter
   key_compare key_comp() const noexcept { return t.key_comp(); }
   value_compare value_comp() const noexcept {
@@ -110,16 +130,11 @@ class map {
   reverse_iterator rend() noexcept { return t.rend(); }
 
   // map的operator[]具备插入功能
-  data_type &operator[](const key_type &k) {
-    iterator i = lower_bound(k);
-    if (i == end() || key_comp()(k, (*i).first))
-      i = insert(i, value_type(k, data_type()));
-    return (*i).second;
-  }
+  data_type &operator[](const key_type &k) { return try_emplace(k).first->second; }
 
  public:// swap
   //调用rb-tree接口
-  void swap(map<Key, T, Compare, Alloc> &x) noexcept { t.swap(x.t); }
+  void swap(map<Key, T, Compare, Alloc, Augment> &x) noexcept { t.swap(x.t); }
 
  public:// insert && erase
   pair<iterator, bool> insert(const value_type &x) {
@@ -132,6 +147,79 @@ class map {
   void insert(InputIterator first, InputIterator last) {
     t.insert_unique(first, last);
   }
+
+ public:// emplace
+  template<class... Args>
+  pair<iterator, bool> emplace(Args &&...args) {
+    return t.emplace_unique(TinySTL::forward<Args>(args)...);
+  }
+  // 仅当 k 不存在时才以 args 构造 mapped 值，命中时不构造任何对象
+  template<class... Args>
+  pair<iterator, bool> try_emplace(const key_type &k, Args &&...args) {
+    return t.try_emplace_unique(k, _pair_emplace, k, TinySTL::forward<Args>(args)...);
+  }
+  template<class... Args>
+  pair<iterator, bool> try_emplace(key_type &&k, Args &&...args) {
+    return t.try_emplace_unique(k, _pair_emplace, TinySTL::move(k),
+                                TinySTL::forward<Args>(args)...);
+  }
+  // k 存在时赋值，否则插入；返回值的 second 表示是否插入
+  template<class M>
+  pair<iterator, bool> insert_or_assign(const key_type &k, M &&obj) {
+    pair<iterator, bool> r =
+        t.try_emplace_unique(k, _pair_emplace, k, TinySTL::forward<M>(obj));
+    if (!r.second) r.first->second = TinySTL::forward<M>(obj);
+    return r;
+  }
+  template<class M>
+  pair<iterator, bool> insert_or_assign(key_type &&k, M &&obj) {
+    pair<iterator, bool> r = t.try_emplace_unique(k, _pair_emplace, TinySTL::move(k),
+                                                  TinySTL::forward<M>(obj));
+    if (!r.second) r.first->second = TinySTL::forward<M>(obj);
+    return r;
+  }
+
+ public:// node handle
+  using node_type = typename rep_type::node_type;
+  using insert_return_type = typename rep_type::insert_return_type;
+  node_type extract(iterator pos) noexcept { return t.extract(pos); }
+  node_type extract(const key_type &x) { return t.extract(x); }
+  insert_return_type insert(node_type &&nh) { return t.insert_unique(TinySTL::move(nh)); }
+  // 移入 src 中键值不重复的元素，只重新链接节点
+  void merge(map &src) { t.merge_unique(src.t); }
+  void merge(multimap<Key, T, Compare, Alloc, Augment> &src) { t.merge_unique(src.t); }
+
+ public:// set algebra，按键值运算，基于 split / join，O(m log(n/m + 1))，只重新链接节点
+  // 右值版本直接取用 other 的节点，other 被清空；键值重复时保留本 map 的元素
+  void union_with(map &&other) noexcept { t.union_with(TinySTL::move(other.t)); }
+  void union_with(const map &other) { t.union_with(other.t); }
+  void intersect_with(const map &other) noexcept { t.intersect_with(other.t); }
+  void difference_with(const map &other) noexcept { t.difference_with(other.t); }
+  // 并行版本，Pool 须提供 parallel_invoke（如 thread_pool）
+  template<class Pool>
+  void parallel_union_with(map &&other, Pool &pool, size_type grain = 4096) noexcept {
+    t.parallel_union_with(TinySTL::move(other.t), pool, grain);
+  }
+  template<class Pool>
+  void parallel_intersect_with(const map &other, Pool &pool, size_type grain = 4096) noexcept {
+    t.parallel_intersect_with(other.t, pool, grain);
+  }
+  template<class Pool>
+  void parallel_difference_with(const map &other, Pool &pool, size_type grain = 4096) noexcept {
+    t.parallel_difference_with(other.t, pool, grain);
+  }
+
+ public:// split && join
+  // 键值不小于 k 的元素移入返回的 map，见 rb_tree::split
+  map split(const key_type &k) {
+    map r(t.key_comp());
+    r.t = t.split(k);
+    return r;
+  }
+  // 将键值均大于本 map 的 right 接在其后，right 被清空，O(log n)
+  void join(map &&right) noexcept { t.join(TinySTL::move(right.t)); }
+
+ public:// erase
   void erase(iterator pos) { t.erase(pos); }
   size_type erase(const key_type &x) { return t.erase(x); }
   void erase(iterator first, iterator last) { t.erase(first, last); }
@@ -162,48 +250,102 @@ class map {
       noexcept {
     return t.equal_range(x);
   }
+
+ public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator find(const K &x) noexcept {
+    return t.find(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator find(const K &x) const noexcept {
+    return t.find(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  size_type count(const K &x) const noexcept {
+    return t.count(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator lower_bound(const K &x) noexcept {
+    return t.lower_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator lower_bound(const K &x) const noexcept {
+    return t.lower_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator upper_bound(const K &x) noexcept {
+    return t.upper_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator upper_bound(const K &x) const noexcept {
+    return t.upper_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<iterator, iterator> equal_range(const K &x) noexcept {
+    return t.equal_range(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<const_iterator, const_iterator> equal_range(const K &x) const noexcept {
+    return t.equal_range(x);
+  }
+
+ public:// order statistic，要求 Augment 维护子树大小（如 rb_tree_size_augment）
+  iterator nth(size_type k) noexcept { return t.nth(k); }
+  const_iterator nth(size_type k) const noexcept { return t.nth(k); }
+  size_type rank(const key_type &x) const noexcept { return t.rank(x); }
+  size_type count_range(const key_type &lo, const key_type &hi) const noexcept {
+    return t.count_range(lo, hi);
+  }
 };
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator==(const map<Key, Tp, Compare, Alloc> &lhs,
-                       const map<Key, Tp, Compare, Alloc> &rhs) {
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator==(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const map<Key, Tp, Compare, Alloc, Augment> &rhs) {
   return lhs.t == rhs.t;
 }
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator!=(const map<Key, Tp, Compare, Alloc> &lhs,
-                       const map<Key, Tp, Compare, Alloc> &rhs) {
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator!=(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const map<Key, Tp, Compare, Alloc, Augment> &rhs) {
   return !(lhs.t == rhs.t);
 }
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator<(const map<Key, Tp, Compare, Alloc> &lhs,
-                      const map<Key, Tp, Compare, Alloc> &rhs) {
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator<(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                      const map<Key, Tp, Compare, Alloc, Augment> &rhs) {
   return lhs.t < rhs.t;
 }
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator>(const map<Key, Tp, Compare, Alloc> &lhs,
-                      const map<Key, Tp, Compare, Alloc> &rhs) {
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator>(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                      const map<Key, Tp, Compare, Alloc, Augment> &rhs) {
   return rhs < lhs;
 }
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator<=(const map<Key, Tp, Compare, Alloc> &lhs,
-                       const map<Key, Tp, Compare, Alloc> &rhs) {
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator<=(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const map<Key, Tp, Compare, Alloc, Augment> &rhs) {
   return !(rhs < lhs);
 }
 
-template<class Key, class Tp, class Compare, class Alloc>
-inline bool operator>=(const map<Key, Tp, Compare, Alloc> &lhs,
-                       const map<Key, Tp, Compare, Alloc> &rhs) {
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator>=(const map<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const map<Key, Tp, Compare, Alloc, Augment> &rhs) {
   return !(lhs < rhs);
 }
 
-template<class Key, class Tp, class Compare, class Alloc>
+// 连接两个键值范围有序的 map：left 的键值均小于 right
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline map<Key, Tp, Compare, Alloc, Augment> join(map<Key, Tp, Compare, Alloc, Augment> &&left,
+                                                  map<Key, Tp, Compare, Alloc, Augment> &&right) {
+  left.join(TinySTL::move(right));
+  return TinySTL::move(left);
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
 inline void swap(
-    map<Key, Tp, Compare, Alloc> &lhs,
-    map<Key, Tp, Compare, Alloc> &rhs) noexcept {
+    map<Key, Tp, Compare, Alloc, Augment> &lhs,
+    map<Key, Tp, Compare, Alloc, Augment> &rhs) noexcept {
   lhs.swap(rhs);
 }
 
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "AssociativeContainers/Map/stl_map.h"
+#include "AssociativeContainers/RB-Tree/rb_tree.h"
+#include "Function/function_adapter.h"
+
+namespace TinySTL {
+
+// Forward declarations of operators == and <, needed for friend declarations.
+
+template<class Key, class T, class Compare, class Alloc, class Augment>
+class multimap;
+
+template<class Key, class T, class Compare, class Alloc, class Augment>
+inline bool operator==(const multimap<Key, T, Compare, Alloc, Augment> &lhs,
+                       const multimap<Key, T, Compare, Alloc, Augment> &rhs);
+
+template<class Key, class T, class Compare, class Alloc, class Augment>
+inline bool operator<(const multimap<Key, T, Compare, Alloc, Augment> &lhs,
+                      const multimap<Key, T, Compare, Alloc, Augment> &rhs);
+
+// 与 map 的区别：插入使用 rb_tree::insert_equal，允许键值重复，且不提供 operator[]
+template<class Key, class T, class Compare = less<Key>,
+         class Alloc = simpleAlloc<T>, class Augment = rb_tree_no_augment>
+class multimap {
+  // friend declarations
+  template<class _Key, class _T, class _Compare, class _Alloc, class _Augment>
+  friend bool operator==(const multimap<_Key, _T, _Compare, _Alloc, _Augment> &lhs,
+                         const multimap<_Key, _T, _Compare, _Alloc, _Augment> &rhs);
+  template<class _Key, class _T, class _Compare, class _Alloc, class _Augment>
+  friend bool operator<(const multimap<_Key, _T, _Compare, _Alloc, _Augment> &lhs,
+                        const multimap<_Key, _T, _Compare, _Alloc, _Augment> &rhs);
+  // merge 需访问同参数 map 的底层红黑树
+  template<class, class, class, class, class>
+  friend class map;
+
+ public:// value comparator
+  using key_type = Key;
+  using data_type = T;
+  using value_type = pair<const Key, T>;
+  using key_compare = Compare;
+
+  class value_compare : public binary_function<value_type, value_type, bool> {
+    friend class multimap;
+
+   protected:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+
+   public:
+    bool operator()(const value_type &x, const value_type &y) const {
+      return comp(x.first, y.first);
+    }
+  };
+
+ private:// data member
+  using rep_type = rb_tree<key_type, value_type, select1st<value_type>,
+                           key_compare, Alloc, Augment>;
+  rep_type t;// 底层红黑树
+
+ public:// Alias declarations
+  using pointer = typename rep_type::pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ public:// ctor
+  multimap() : t(key_compare()) {}
+  explicit multimap(const key_compare &comp) : t(comp) {}
+  template<class InputIterator>
+  multimap(InputIterator first, InputIterator last,
+           const key_compare &comp = key_compare())
+      : t(comp) {
+    t.insert_equal(first, last);
+  }
+  // 调用者保证 [first, last) 已按键值有序，O(n) 建树
+  template<class InputIterator>
+  multimap(assign_sorted_t, InputIterator first, InputIterator last,
+           const key_compare &comp = key_compare())
+      : t(comp) {
+    t.assign_sorted_equal(first, last);
+  }
+  multimap(const multimap &rhs) : t(rhs.t) {}
+
+ public:// copy operation
+  multimap &operator=(const multimap &rhs) {
+    t = rhs.t;
+    return *this;
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return t.key_comp(); }
+  value_compare value_comp() const noexcept {
+    return value_compare(t.key_comp());
+  }
+  const_iterator begin() const noexcept { return t.begin(); }
+  const_iterator end() const noexcept { return t.end(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  const_reverse_iterator rbegin() const noexcept { return t.rbegin(); }
+  const_reverse_iterator rend() const noexcept { return t.rend(); }
+  const_reverse_iterator crbegin() const noexcept { return t.rbegin(); }
+  const_reverse_iterator crend() const noexcept { return t.rend(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+
+ public:// setter
+  iterator begin() noexcept { return t.begin(); }
+  iterator end() noexcept { return t.end(); }
+  reverse_iterator rbegin() noexcept { return t.rbegin(); }
+  reverse_iterator rend() noexcept { return t.rend(); }
+
+ public:// swap
+  void swap(multimap &x) noexcept { t.swap(x.t); }
+
+ public:// insert && erase
+  iterator insert(const value_type &x) { return t.insert_equal(x); }
+  iterator insert(iterator pos, const value_type &x) {
+    return t.insert_equal(pos, x);
+  }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_equal(first, last);
+  }
+
+ public:// emplace
+  template<class... Args>
+  iterator emplace(Args &&...args) {
+    return t.emplace_equal(TinySTL::forward<Args>(args)...);
+  }
+
+ public:// node handle
+  using node_type = typename rep_type::node_type;
+  node_type extract(iterator pos) noexcept { return t.extract(pos); }
+  node_type extract(const key_type &x) { return t.extract(x); }
+  iterator insert(node_type &&nh) { return t.insert_equal(TinySTL::move(nh)); }
+  // 移入 src 的全部元素，只重新链接节点
+  void merge(multimap &src) { t.merge_equal(src.t); }
+  void merge(map<Key, T, Compare, Alloc, Augment> &src) { t.merge_equal(src.t); }
+
+ public:// erase
+  void erase(iterator pos) { t.erase(pos); }
+  size_type erase(const key_type &x) { return t.erase(x); }
+  void erase(iterator first, iterator last) { t.erase(first, last); }
+  void clear() { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &x) noexcept { return t.find(x); }
+  const_iterator find(const key_type &x) const noexcept { return t.find(x); }
+  size_type count(const key_type &x) const noexcept { return t.count(x); }
+  iterator lower_bound(const key_type &x) noexcept {
+    return t.lower_bound(x);
+  }
+  const_iterator lower_bound(const key_type &x) const noexcept {
+    return t.lower_bound(x);
+  }
+  iterator upper_bound(const key_type &x) noexcept {
+    return t.upper_bound(x);
+  }
+  const_iterator upper_bound(const key_type &x) const noexcept {
+    return t.upper_bound(x);
+  }
+  pair<iterator, iterator> equal_range(const key_type &x) noexcept {
+    return t.equal_range(x);
+  }
+  pair<const_iterator, const_iterator> equal_range(const key_type &x) const
+      noexcept {
+    return t.equal_range(x);
+  }
+
+ public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator find(const K &x) noexcept {
+    return t.find(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator find(const K &x) const noexcept {
+    return t.find(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  size_type count(const K &x) const noexcept {
+    return t.count(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator lower_bound(const K &x) noexcept {
+    return t.lower_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator lower_bound(const K &x) const noexcept {
+    return t.lower_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator upper_bound(const K &x) noexcept {
+    return t.upper_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator upper_bound(const K &x) const noexcept {
+    return t.upper_bound(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<iterator, iterator> equal_range(const K &x) noexcept {
+    return t.equal_range(x);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<const_iterator, const_iterator> equal_range(const K &x) const noexcept {
+    return t.equal_range(x);
+  }
+
+ public:// order statistic，要求 Augment 维护子树大小（如 rb_tree_size_augment）
+  iterator nth(size_type k) noexcept { return t.nth(k); }
+  const_iterator nth(size_type k) const noexcept { return t.nth(k); }
+  size_type rank(const key_type &x) const noexcept { return t.rank(x); }
+  size_type count_range(const key_type &lo, const key_type &hi) const noexcept {
+    return t.count_range(lo, hi);
+  }
+};
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator==(const multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const multimap<Key, Tp, Compare, Alloc, Augment> &rhs) {
+  return lhs.t == rhs.t;
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator!=(const multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const multimap<Key, Tp, Compare, Alloc, Augment> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator<(const multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                      const multimap<Key, Tp, Compare, Alloc, Augment> &rhs) {
+  return lhs.t < rhs.t;
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator>(const multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                      const multimap<Key, Tp, Compare, Alloc, Augment> &rhs) {
+  return rhs < lhs;
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator<=(const multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const multimap<Key, Tp, Compare, Alloc, Augment> &rhs) {
+  return !(rhs < lhs);
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline bool operator>=(const multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                       const multimap<Key, Tp, Compare, Alloc, Augment> &rhs) {
+  return !(lhs < rhs);
+}
+
+template<class Key, class Tp, class Compare, class Alloc, class Augment>
+inline void swap(multimap<Key, Tp, Compare, Alloc, Augment> &lhs,
+                 multimap<Key, Tp, Compare, Alloc, Augment> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
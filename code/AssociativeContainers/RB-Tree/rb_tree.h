@@ -2,20 +2,28 @@
 
 #include "Algorithms/algobase/stl_algobase.h"
 #include "Allocator/allocator.h"
+#include "AssociativeContainers/RB-Tree/rb_tree_augment.h"
 #include "AssociativeContainers/RB-Tree/rb_tree_node.h"
 #include "Function/function_adapter.h"
+#include "Utils/node_handle.h"
 #include "rb_tree_iterator.h"
 #include <cstddef>
 #include <exception>
 
 namespace TinySTL {
 
+// 标记输入区间已按键值有序，容器据此以 O(n) 直接建树
+struct assign_sorted_t {
+  explicit assign_sorted_t() = default;
+};
+inline constexpr assign_sorted_t assign_sorted{};
+
 template<class Key, class Value, class KeyOfValue, class Compare,
-         class Alloc = simpleAlloc<Value>>
+         class Alloc = simpleAlloc<Value>, class Augment = rb_tree_no_augment>
 class rb_tree {
 private:
     using base_ptr = _rb_tree_node_base *;
-    using rb_tree_node = _rb_tree_node<Value>;
+    using rb_tree_node = typename _rb_tree_node_type<Value, Augment>::type;
     using rb_tree_node_allocator = simpleAlloc<rb_tree_node>;
     using color_type = rb_tree_color_type;
 
@@ -37,21 +45,38 @@ public:// iterator
     using reverse_iterator = __reverse_iterator<iterator>;
     using const_reverse_iterator = __reverse_iterator<const_iterator>;
 
+private:// node handle
+    struct node_traits {
+        using node_pointer = link_type;
+        static value_type &value(link_type p) { return p->value_field; }
+        static void destroy(link_type p) {
+            TinySTL::destroy(&p->value_field);
+            rb_tree_node_allocator::deallocate(p);
+        }
+    };
+
+public:
+    using node_type = node_handle<value_type, node_traits>;
+    using insert_return_type = node_insert_return<iterator, node_type>;
+
 private:// operations of node
     link_type get_node() { return rb_tree_node_allocator::allocate(); }
     void put_node(link_type p) { rb_tree_node_allocator::deallocate(p); }
-    link_type create_node(const value_type &value) {
+    template<class... Args>
+    link_type create_node(Args &&...args) {
         link_type temp = get_node();
         try {
-            TinySTL::construct(&temp->value_field, value);
+            TinySTL::construct(&temp->value_field, TinySTL::forward<Args>(args)...);
         } catch(std::exception &) {
             put_node(temp);
+            throw;
         }
         return temp;
     }
     link_type clone_node(link_type p) {
         link_type temp = create_node(p->value_field);
         temp->color = p->color;
+        if constexpr (augmented) temp->aug = p->aug;
         temp->left = nullptr;
         temp->right = nullptr;
         return temp;
@@ -62,6 +87,25 @@ private:// operations of node
         put_node(p);
     }
 
+private:// augmentation
+    static constexpr bool augmented = _rb_tree_is_augmented<Augment>::value;
+    // 由左右子树重新计算 x 的附加数据
+    static void augment_update(base_ptr x) {
+        if constexpr (augmented) {
+            link_type p = reinterpret_cast<link_type>(x);
+            Augment::update(p->aug, p->value_field, p->left ? &left(p)->aug : nullptr,
+                            p->right ? &right(p)->aug : nullptr);
+        }
+    }
+    // 自 x 上溯至 root，逐个更新
+    void augment_update_path(base_ptr x) {
+        if constexpr (augmented)
+            for (; x != header; x = x->parent) augment_update(x);
+    }
+    static size_type subtree_size(base_ptr x) noexcept {
+        return x ? Augment::subtree_size(reinterpret_cast<link_type>(x)->aug) : 0;
+    }
+
 private:// data member
     size_type node_count; // 树大小 == 节点数量
     link_type header; // root的父亲
@@ -131,7 +175,8 @@ private:// aux interface
 private:// rotate && reblance
     void rb_tree_rotate_left(base_ptr, base_ptr &);
     void rb_tree_rotate_right(base_ptr, base_ptr &);
-    void rb_tree_rebalance(base_ptr, base_ptr &);
+    // 返回整棵树的黑高是否因此增加
+    bool rb_tree_rebalance(base_ptr, base_ptr &);
     base_ptr rb_tree_rebalance_for_erase(base_ptr, base_ptr &, base_ptr &,
                                         base_ptr &);
 
@@ -152,7 +197,12 @@ public:// copy
         else {
             header = get_node();
             color(header) = rb_tree_red;
-            root() = copy(rhs.root(), header);
+            try {
+                root() = copy(rhs.root(), header);
+            } catch (std::exception &) {
+                put_node(header);
+                throw;
+            }
             leftmost() = minimum(root());
             rightmost() = maximum(root());
         }
@@ -161,7 +211,7 @@ public:// copy
     rb_tree &operator=(const rb_tree &);
 
 public:// move
-    rb_tree(rb_tree &&rhs) noexcept {
+    rb_tree(rb_tree &&rhs) noexcept : node_count(0), key_compare(rhs.key_compare) {
         empty_initialize();
         swap(rhs);
     }
@@ -201,6 +251,32 @@ public:// setter
 
 private:// aux interface for inset
     iterator insert_aux(base_ptr, base_ptr, const value_type &);
+    // 将已构造的节点 z 链接为 y 的子节点并重新平衡，x 的含义同 insert_aux
+    iterator link_node(base_ptr, base_ptr, link_type) noexcept;
+    // 键值 k 的插入点之父；second 为 false 时 first 为与 k 重复的节点
+    pair<link_type, bool> get_insert_unique_pos(const key_type &);
+    link_type get_insert_equal_pos(const key_type &);
+    // 将节点自树中摘除但不销毁
+    link_type unlink_node(base_ptr) noexcept;
+    template<class InputIterator>
+    void insert_unique_range(InputIterator, InputIterator, input_iterator_tag);
+    template<class ForwardIterator>
+    void insert_unique_range(ForwardIterator, ForwardIterator, forward_iterator_tag);
+    template<class InputIterator>
+    void insert_equal_range(InputIterator, InputIterator, input_iterator_tag);
+    template<class ForwardIterator>
+    void insert_equal_range(ForwardIterator, ForwardIterator, forward_iterator_tag);
+
+private:// aux interface for linear build
+    // 区间是否有序（unique 时允许相邻重复，建树时跳过），n 返回建树所需的节点数
+    template<class ForwardIterator>
+    bool sorted_input(ForwardIterator, ForwardIterator, bool unique, size_type &n) const;
+    // 以 [first, last) 中的 n 个元素重建整棵树，要求树为空
+    template<class ForwardIterator>
+    void build_sorted(ForwardIterator first, ForwardIterator last, size_type n, bool unique);
+    template<class ForwardIterator>
+    link_type build_subtree(ForwardIterator &first, ForwardIterator last, size_type n,
+                            size_type depth, size_type red_depth, bool unique);
 
 public:// insert
     pair<iterator, bool> insert_unique(const value_type &);
@@ -211,9 +287,165 @@ public:// insert
     iterator insert_equal(const value_type &);
     template<class InputIterator>
     void insert_equal(InputIterator, InputIterator);
+    // 以有序区间替换全部内容：前向迭代器为 O(n)，单趟输入迭代器退化为逐个带提示插入
+    template<class InputIterator>
+    void assign_sorted_unique(InputIterator, InputIterator);
+    template<class InputIterator>
+    void assign_sorted_equal(InputIterator, InputIterator);
+
+public:// emplace
+    // 先以 args 构造节点再定位，键值重复时销毁该节点
+    template<class... Args>
+    pair<iterator, bool> emplace_unique(Args &&...args);
+    template<class... Args>
+    iterator emplace_equal(Args &&...args);
+    // 键值 k 不存在时才以 args 构造元素（其键值须与 k 等价），命中时不构造任何对象
+    template<class... Args>
+    pair<iterator, bool> try_emplace_unique(const key_type &k, Args &&...args);
 
 private:// aux interface for erase
-    void erase_aux(link_type) noexcept;
+    // 销毁以 x 为根的子树，返回销毁的节点数
+    size_type erase_aux(link_type) noexcept;
+
+public:// node handle：节点在树间转移时只重新链接，不分配、不复制
+    node_type extract(iterator pos) noexcept { return node_type(unlink_node(pos.node)); }
+    node_type extract(const key_type &k) {
+        iterator i = find(k);
+        return i == end() ? node_type() : extract(i);
+    }
+    // 键值重复时插入失败，节点留在返回值的 node 中
+    insert_return_type insert_unique(node_type &&);
+    iterator insert_equal(node_type &&);
+    // 将 src 的节点移入本树；unique 版本中与本树键值重复的节点留在 src
+    void merge_unique(rb_tree &src);
+    void merge_equal(rb_tree &src);
+
+private:// split && join，作用于不含 header 的子树
+    // 子树的根无父节点且为黑色，bh 为根到空指针路径上的黑节点数（空树为 0）
+    struct subtree {
+        link_type root;
+        size_type bh;
+    };
+    // 待销毁的子树，以根的 parent 指针串联；并行递归期间只收集，结束后统一销毁
+    struct node_list {
+        link_type head = nullptr;
+        link_type tail = nullptr;
+    };
+    // 将黑高为 bh 的子树 x 自其父节点摘下，红根涂黑
+    static subtree detach(link_type x, size_type bh) noexcept {
+        if (!x) return subtree{nullptr, 0};
+        x->parent = nullptr;
+        if (color(x) == rb_tree_red) {
+            color(x) = rb_tree_black;
+            ++bh;
+        }
+        return subtree{x, bh};
+    }
+    static void list_push(node_list &l, link_type x) noexcept {
+        x->parent = nullptr;
+        if (l.tail) l.tail->parent = x;
+        else l.head = x;
+        l.tail = x;
+    }
+    static void list_splice(node_list &l, node_list &r) noexcept {
+        if (!r.head) return;
+        if (l.tail) l.tail->parent = r.head;
+        else l.head = r.head;
+        l.tail = r.tail;
+    }
+    size_type destroy_list(node_list &l) noexcept {
+        size_type n = 0;
+        for (link_type x = l.head; x;) {
+            link_type next = parent(x);
+            n += erase_aux(x);
+            x = next;
+        }
+        return n;
+    }
+    // 取下整棵树（header 随之置空），及以子树替换整棵树
+    subtree take_root() noexcept;
+    void reset_root(subtree t, size_type n) noexcept;
+    // l 中键值均小于 k，r 中均大于 k；O(|bh(l) - bh(r)| + 1)
+    subtree join_aux(subtree l, link_type k, subtree r) noexcept;
+    subtree join_right(subtree l, link_type k, subtree r) noexcept;
+    subtree join_left(subtree l, link_type k, subtree r) noexcept;
+    subtree join2_aux(subtree l, subtree r) noexcept;
+    // 摘下 t 中的最大节点
+    link_type split_last(subtree &t) noexcept;
+    // 将 t 分为键值小于 k 的 l 与不小于 k 的 r；eq 非空时与 k 等价的节点单独存于 *eq（要求唯一键）
+    void split_aux(subtree t, const key_type &k, subtree &l, subtree &r, link_type *eq) noexcept;
+
+private:// set algebra，x 为另一棵树中黑高为 bh 的子树，invoke(bh, f1, f2) 决定两侧递归是否并行
+    template<class Invoke>
+    subtree union_aux(subtree t, link_type x, size_type bh, node_list &garbage, Invoke &invoke) noexcept;
+    template<class Invoke>
+    subtree intersect_aux(subtree t, link_type x, size_type bh, node_list &garbage, Invoke &invoke) noexcept;
+    template<class Invoke>
+    subtree difference_aux(subtree t, link_type x, size_type bh, node_list &garbage, Invoke &invoke) noexcept;
+    template<class Invoke>
+    void union_with_aux(rb_tree &other, Invoke invoke) noexcept;
+    template<class Invoke>
+    void intersect_with_aux(const rb_tree &other, Invoke invoke) noexcept;
+    template<class Invoke>
+    void difference_with_aux(const rb_tree &other, Invoke invoke) noexcept;
+    // 串行执行两侧递归
+    struct serial_invoke {
+        template<class F1, class F2>
+        void operator()(size_type, F1 &f1, F2 &f2) const { f1(); f2(); }
+    };
+    // other 中黑高为 bh 的子树至少含 2^bh - 1 个节点，超过 grain 时派生任务
+    template<class Pool>
+    struct parallel_invoke {
+        Pool &pool;
+        size_type grain;
+        template<class F1, class F2>
+        void operator()(size_type bh, F1 &f1, F2 &f2) const {
+            if (bh < 8 * sizeof(size_type) && (size_type(1) << bh) <= grain) {
+                f1();
+                f2();
+            } else {
+                pool.parallel_invoke(f1, f2);
+            }
+        }
+    };
+
+public:// set algebra：基于 split / join，O(m log(n/m + 1))，m、n 为两树中较小与较大者的规模
+    // 要求唯一键且比较函数不抛出异常，只重新链接节点，不复制也不分配
+    // 并入 other 的全部节点，键值重复时保留本树的元素；other 被清空
+    void union_with(rb_tree &&other) noexcept {
+        union_with_aux(other, serial_invoke());
+    }
+    // 先复制 other，复制失败时本树不变
+    void union_with(const rb_tree &other) { union_with(rb_tree(other)); }
+    // 只保留键值在 other 中出现的元素
+    void intersect_with(const rb_tree &other) noexcept {
+        intersect_with_aux(other, serial_invoke());
+    }
+    // 删除键值在 other 中出现的元素
+    void difference_with(const rb_tree &other) noexcept {
+        difference_with_aux(other, serial_invoke());
+    }
+    // 并行版本：分裂出的两侧子问题互不相交，经 pool.parallel_invoke 并行递归，
+    // 规模不超过 grain 的子问题串行；被删除的元素在全部任务结束后于调用线程销毁
+    template<class Pool>
+    void parallel_union_with(rb_tree &&other, Pool &pool, size_type grain = 4096) noexcept {
+        union_with_aux(other, parallel_invoke<Pool>{pool, grain});
+    }
+    template<class Pool>
+    void parallel_intersect_with(const rb_tree &other, Pool &pool, size_type grain = 4096) noexcept {
+        intersect_with_aux(other, parallel_invoke<Pool>{pool, grain});
+    }
+    template<class Pool>
+    void parallel_difference_with(const rb_tree &other, Pool &pool, size_type grain = 4096) noexcept {
+        difference_with_aux(other, parallel_invoke<Pool>{pool, grain});
+    }
+
+public:// split && join：只重新链接节点，header 的 leftmost / rightmost 随之更新
+    // 键值不小于 k 的元素移入返回的树，本树保留小于 k 的部分；
+    // Augment 维护子树大小时 O(log n)，否则还需 O(min(两侧规模)) 重新计数
+    rb_tree split(const key_type &k);
+    // 将 right 接在本树之后，要求 right 的键值均不小于本树（唯一键时均大于）；right 被清空，O(log n)
+    void join(rb_tree &&right) noexcept;
 
 public:// erase
     void erase(iterator);
@@ -233,8 +465,91 @@ public:// find
     pair<const_iterator, const_iterator> equal_range(const key_type &) const
         noexcept;
 
+public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用，不构造 key_type
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    iterator find(const K &k) noexcept { return iterator(find_node(k)); }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    const_iterator find(const K &k) const noexcept { return const_iterator(find_node(k)); }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    size_type count(const K &k) const noexcept {
+        return TinySTL::distance(const_iterator(lower_bound_node(k)),
+                                 const_iterator(upper_bound_node(k)));
+    }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    iterator lower_bound(const K &k) noexcept { return iterator(lower_bound_node(k)); }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    const_iterator lower_bound(const K &k) const noexcept {
+        return const_iterator(lower_bound_node(k));
+    }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    iterator upper_bound(const K &k) noexcept { return iterator(upper_bound_node(k)); }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    const_iterator upper_bound(const K &k) const noexcept {
+        return const_iterator(upper_bound_node(k));
+    }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    pair<iterator, iterator> equal_range(const K &k) noexcept {
+        return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+    pair<const_iterator, const_iterator> equal_range(const K &k) const noexcept {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+
+private:// aux interface for find，K 为 key_type 或透明比较下可与之比较的类型
+    template<class K>
+    link_type lower_bound_node(const K &) const noexcept;
+    template<class K>
+    link_type upper_bound_node(const K &) const noexcept;
+    // 未找到时返回 header
+    template<class K>
+    link_type find_node(const K &) const noexcept;
+
+public:// order statistic，要求 Augment 提供 subtree_size
+    // 第 k 小（自 0 起）的元素，k >= size() 时返回 end()
+    iterator nth(size_type) noexcept;
+    const_iterator nth(size_type k) const noexcept {
+        return const_cast<rb_tree *>(this)->nth(k);
+    }
+    // 键值小于 k 的元素个数，即 lower_bound(k) 的下标
+    size_type rank(const key_type &) const noexcept;
+    // 键值位于 [lo, hi) 的元素个数
+    size_type count_range(const key_type &lo, const key_type &hi) const noexcept {
+        return key_compare(lo, hi) ? rank(hi) - rank(lo) : 0;
+    }
+
+public:// augmented query，要求 Augment 提供 data_type
+    // 整棵树的聚合值，要求树非空
+    template<class A = Augment>
+    const typename A::data_type &aggregate() const noexcept {
+        return root()->aug;
+    }
+    // 中序访问各节点，跳过 prune(子树附加数据) 为真的整棵子树；
+    // visit(iterator) 返回 false 时立即停止，此时返回 false
+    template<class Prune, class Visit>
+    bool augmented_visit(Prune prune, Visit visit) {
+        return augmented_visit_aux<iterator>(root(), prune, visit);
+    }
+    template<class Prune, class Visit>
+    bool augmented_visit(Prune prune, Visit visit) const {
+        return augmented_visit_aux<const_iterator>(root(), prune, visit);
+    }
+
+private:
+    template<class Iter, class Prune, class Visit>
+    static bool augmented_visit_aux(link_type x, Prune &prune, Visit &visit) {
+        static_assert(augmented, "augmented_visit requires an Augment with data_type");
+        if (!x || prune(static_cast<const rb_tree_node *>(x)->aug)) return true;
+        return augmented_visit_aux<Iter>(left(x), prune, visit) && visit(Iter(x)) &&
+               augmented_visit_aux<Iter>(right(x), prune, visit);
+    }
+
+public:// debug
+    // 检查红黑树性质、键值次序、header 的 leftmost/rightmost 与子树大小
+    bool rb_verify() const noexcept;
+
 public:// swap
-    void swap(rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs) noexcept {
+    void swap(rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs) noexcept {
         // swap data members
         TinySTL::swap(header, lhs.header);
         TinySTL::swap(node_count, lhs.node_count);
@@ -242,16 +557,23 @@ public:// swap
     }
 };
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_aux(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_aux(
     base_ptr x_, base_ptr y_, const value_type &val) {
+  return link_node(x_, y_, create_node(val));
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_node(
+    base_ptr x_, base_ptr y_, link_type z) noexcept {
   link_type x = reinterpret_cast<link_type>(x_);
   link_type y = reinterpret_cast<link_type>(y_);
-  link_type z;
-  if (y == header || x || key_compare(KeyOfValue()(val), key(y))) {
+  if (y == header || x || key_compare(key(z), key(y))) {
     // 待插入节点之父为header||待插入节点自身并不为nullptr(何时触发？）||父节点明确大于待插入值
-    z = create_node(val);
     left(y) = z;// 若y为header，此时leftmost==z
     if (y == header) {
       root() = z;
@@ -261,32 +583,49 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_aux(
     }
   } else {
     // 此时必成为y右子
-    z = create_node(val);
     right(y) = z;
     if (y == rightmost()) rightmost() = z;
   }
   parent(z) = y;
   left(z) = nullptr;
   right(z) = nullptr;
+  augment_update_path(z);
   rb_tree_rebalance(z, header->parent);
   ++node_count;
   return iterator(z);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase_aux(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::unlink_node(
+    base_ptr z) noexcept {
+  link_type y = reinterpret_cast<link_type>(rb_tree_rebalance_for_erase(
+      z, header->parent, header->left, header->right));
+  --node_count;
+  return y;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::erase_aux(
     link_type x) noexcept {
+  size_type n = 0;
   while (x) {
     // 递归式删除
-    erase_aux(right(x));
+    n += erase_aux(right(x));
     link_type y = left(x);
     destroy_node(x);
     x = y;
+    ++n;
   }
+  return n;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree_rebalance(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+bool rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::rb_tree_rebalance(
     base_ptr x, base_ptr &root) {
   x->color = rb_tree_red;
   while (x != root && x->parent->color == rb_tree_red) {// 当前父节点为红
@@ -324,12 +663,15 @@ void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree_rebalance(
       }
     }
   }
-  root->color = rb_tree_black;// root永远为黑色
+  const bool grew = root->color == rb_tree_red;// 红色已上溯至root
+  root->color = rb_tree_black;                 // root永远为黑色
+  return grew;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-inline typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::base_ptr
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree_rebalance_for_erase(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+inline typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::rb_tree_rebalance_for_erase(
     base_ptr z, base_ptr &root, base_ptr &leftmost, base_ptr &rightmost) {
   base_ptr y = z;
   base_ptr x = nullptr;
@@ -389,9 +731,11 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree_rebalance_for_erase(
       }
     }
   }
+  // 摘除后自实际删除位置上溯更新附加数据，之后的旋转只做局部修正
+  augment_update_path(x_parent);
   if (y->color != rb_tree_red) {
     while (x != root && (!x || x->color == rb_tree_black))
-      if (x == x->parent->left) {
+      if (x == x_parent->left) {// x 可能为空，以 x_parent 判断
         base_ptr w = x_parent->right;
         if (w->color == rb_tree_red) {
           w->color = rb_tree_black;
@@ -412,7 +756,7 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree_rebalance_for_erase(
           }
           w->color = x_parent->color;
           x_parent->color = rb_tree_black;
-          if (x->right) w->right->color = rb_tree_black;
+          if (w->right) w->right->color = rb_tree_black;
           rb_tree_rotate_left(x_parent, root);
           break;
         }
@@ -448,9 +792,10 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree_rebalance_for_erase(
 }
 
 // 将x的右子树绕x逆时针旋转，其右子的左子变为了x，而原本的左子变为了x的右子
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline void rb_tree<Key, Value, KeyOfValue, Compare,
-                    Alloc>::rb_tree_rotate_left(base_ptr x, base_ptr &root) {
+                    Alloc, Augment>::rb_tree_rotate_left(base_ptr x, base_ptr &root) {
   base_ptr y = x->right;// 旋转点右子
   x->right = y->left;   // 将x的右子树替换为y的左子树
   if (y->left)          // 若存在，则确立新的父子关系
@@ -466,12 +811,15 @@ inline void rb_tree<Key, Value, KeyOfValue, Compare,
     x->parent->right = y;
   y->left = x;
   x->parent = y;
+  augment_update(x);
+  augment_update(y);
 }
 
 // 右旋与左旋相对称
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline void rb_tree<Key, Value, KeyOfValue, Compare,
-                    Alloc>::rb_tree_rotate_right(base_ptr x, base_ptr &root) {
+                    Alloc, Augment>::rb_tree_rotate_right(base_ptr x, base_ptr &root) {
   base_ptr y = x->left;
   x->left = y->right;
   if (y->right) y->right->parent = x;
@@ -484,11 +832,16 @@ inline void rb_tree<Key, Value, KeyOfValue, Compare,
     x->parent->left = y;
   y->right = x;
   x->parent = y;
+  augment_update(x);
+  augment_update(y);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator rb_tree<
-    Key, Value, KeyOfValue, Compare, Alloc>::find(const key_type &k) noexcept {
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class K>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::lower_bound_node(
+    const K &k) const noexcept {
   link_type y = header;// 最后一个不小于k的node
   link_type x = root();// 当前node
   while (x)
@@ -496,115 +849,117 @@ typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator rb_tree<
       y = x, x = left(x);
     else
       x = right(x);
-  iterator j = iterator(y);
-  // 没找到存在两种可能
-  // 1.k比最大值还大，j已经指向了end
-  // 2.已经寻至叶子，但此时发现k仍然小于key(j.node) 若找到应有k==key(j.node)
-  return (j == end()) || key_compare(k, key(j.node)) ? end() : j;
+  return y;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::const_iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::find(const key_type &k) const
-    noexcept {
-  link_type y = header;// 最后一个不小于k的node
-  link_type x = root();// 当前node
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class K>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::upper_bound_node(
+    const K &k) const noexcept {
+  link_type y = header;// 最后一个大于k的node
+  link_type x = root();
   while (x)
-    if (!key_compare(key(x), k))// x的键值不小于k
+    if (key_compare(k, key(x)))
       y = x, x = left(x);
     else
       x = right(x);
-  const_iterator j = const_iterator(y);
+  return y;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class K>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::find_node(
+    const K &k) const noexcept {
+  link_type j = lower_bound_node(k);
   // 没找到存在两种可能
   // 1.k比最大值还大，j已经指向了end
-  // 2.已经寻至叶子，但此时发现k仍然小于key(j.node) 若找到应有k==key(j.node)
-  return (j == end()) || key_compare(k, key(j.node)) ? end() : j;
+  // 2.已经寻至叶子，但此时发现k仍然小于key(j) 若找到应有k==key(j)
+  return j == header || key_compare(k, key(j)) ? header : j;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator rb_tree<
+    Key, Value, KeyOfValue, Compare, Alloc, Augment>::find(const key_type &k) noexcept {
+  return iterator(find_node(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-inline typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::size_type
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::count(const key_type &k) const
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::find(const key_type &k) const
+    noexcept {
+  return const_iterator(find_node(k));
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+inline typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::count(const key_type &k) const
     noexcept {
   pair<const_iterator, const_iterator> p = equal_range(k);
   return TinySTL::distance(p.first, p.second);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::lower_bound(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::lower_bound(
     const key_type &k) noexcept {
-  link_type y = header;
-  link_type x = root();
-  while (x)
-    if (!key_compare(key(x), k))
-      y = x, x = left(x);
-    else
-      x = right(x);
-  return iterator(y);
+  return iterator(lower_bound_node(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::const_iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::lower_bound(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::lower_bound(
     const key_type &k) const noexcept {
-  link_type y = header;
-  link_type x = root();
-  while (x)
-    if (!key_compare(key(x), k))
-      y = x, x = left(x);
-    else
-      x = right(x);
-  return const_iterator(y);
+  return const_iterator(lower_bound_node(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::upper_bound(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::upper_bound(
     const key_type &k) noexcept {
-  link_type y = header;
-  link_type x = root();
-  while (x)
-    if (key_compare(k, key(x)))
-      y = x, x = left(x);
-    else
-      x = right(x);
-  return iterator(y);
+  return iterator(upper_bound_node(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::const_iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::upper_bound(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::upper_bound(
     const key_type &k) const noexcept {
-  link_type y = header;
-  link_type x = root();
-  while (x)
-    if (key_compare(k, key(x)))
-      y = x, x = left(x);
-    else
-      x = right(x);
-  return const_iterator(y);
+  return const_iterator(upper_bound_node(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-inline pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator,
-            typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator>
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::equal_range(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+inline pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator,
+            typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::equal_range(
     const key_type &k) noexcept {
   return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline pair<
-    typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::const_iterator,
-    typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::const_iterator>
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::equal_range(
+    typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator,
+    typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::equal_range(
     const key_type &k) const noexcept {
   return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-inline rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::operator=(const rb_tree &rhs) {
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+inline rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::operator=(const rb_tree &rhs) {
   if (this != &rhs) {
     clear();
     node_count = 0;
@@ -623,36 +978,94 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::operator=(const rb_tree &rhs) {
   return *this;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator, bool>
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique(
     const value_type &val) {
+  pair<link_type, bool> p = get_insert_unique_pos(KeyOfValue()(val));
+  if (p.second) return pair<iterator, bool>(insert_aux(nullptr, p.first, val), true);
+  return pair<iterator, bool>(iterator(p.first), false);// 当前value为重复值
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class... Args>
+pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::emplace_unique(Args &&...args) {
+  link_type z = create_node(TinySTL::forward<Args>(args)...);
+  pair<link_type, bool> p;
+  try {
+    p = get_insert_unique_pos(key(z));
+  } catch (std::exception &) {
+    destroy_node(z);
+    throw;
+  }
+  if (p.second) return pair<iterator, bool>(link_node(nullptr, p.first, z), true);
+  destroy_node(z);
+  return pair<iterator, bool>(iterator(p.first), false);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class... Args>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::emplace_equal(Args &&...args) {
+  link_type z = create_node(TinySTL::forward<Args>(args)...);
+  link_type y;
+  try {
+    y = get_insert_equal_pos(key(z));
+  } catch (std::exception &) {
+    destroy_node(z);
+    throw;
+  }
+  return link_node(nullptr, y, z);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class... Args>
+pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::try_emplace_unique(
+    const key_type &k, Args &&...args) {
+  pair<link_type, bool> p = get_insert_unique_pos(k);
+  if (!p.second) return pair<iterator, bool>(iterator(p.first), false);
+  return pair<iterator, bool>(
+      link_node(nullptr, p.first, create_node(TinySTL::forward<Args>(args)...)), true);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::get_insert_unique_pos(
+    const key_type &k) {
   link_type y = header;
   link_type x = root();
   bool comp = true;
   while (x) {
     y = x;
-    comp = key_compare(KeyOfValue()(val), key(x));// value是否小于x的键值
+    comp = key_compare(k, key(x));// k是否小于x的键值
     x = comp ? left(x) : right(x);
   }
   // 此时y必为待插入点的父节点（也必为叶节点）
   iterator j(y);
-  if (comp) {          // y键值大于value键值，插于左侧
+  if (comp) {          // y键值大于k，插于左侧
     if (j == begin()) {//待插入点之父为最左节点
-      return pair<iterator, bool>(insert_aux(x, y, val), true);
+      return pair<link_type, bool>(y, true);
     } else {
       --j;// 调整j准备完成测试（可能与某键值重复）
     }
   }
-  if (key_compare(key(j.node), KeyOfValue()(val)))
+  if (key_compare(key(j.node), k))
     // 新键值不与旧有键值重复，放心插入
-    return pair<iterator, bool>(insert_aux(x, y, val), true);
-  return pair<iterator, bool>(j, false);// 当前value为重复值
+    return pair<link_type, bool>(y, true);
+  return pair<link_type, bool>(reinterpret_cast<link_type>(j.node), false);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique(
     iterator pos, const value_type &val) {
   if (pos.node == header->left) {// begin()
     if (size() > 0 && key_compare(KeyOfValue()(val), key(pos.node)))
@@ -677,38 +1090,79 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(
   }
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 template<class InputIterator>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique(
     InputIterator first, InputIterator last) {
-  for (; first != last; ++first) insert_unique(*first);
+  insert_unique_range(first, last, iterator_category_t<InputIterator>());
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(
+// 以 end() 为提示逐个插入：递增输入时每次只需与 rightmost 比较一次
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class InputIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique_range(
+    InputIterator first, InputIterator last, input_iterator_tag) {
+  for (; first != last; ++first) insert_unique(end(), *first);
+}
+
+// 空树且输入有序时线性建树，否则逐个插入
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class ForwardIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique_range(
+    ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+  size_type n = 0;
+  if (empty() && sorted_input(first, last, true, n))
+    build_sorted(first, last, n, true);
+  else
+    insert_unique_range(first, last, input_iterator_tag());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class InputIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::assign_sorted_unique(
+    InputIterator first, InputIterator last) {
+  clear();
+  insert_unique_range(first, last, iterator_category_t<InputIterator>());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_equal(
     const value_type &val) {
+  return insert_aux(nullptr, get_insert_equal_pos(KeyOfValue()(val)), val);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::get_insert_equal_pos(
+    const key_type &k) {
   link_type y = header;
   link_type x = root();
   while (x) {
     y = x;
-    x = key_compare(KeyOfValue()(val), key(x)) ? left(x)
-                                               : right(x);// 大则向左
+    x = key_compare(k, key(x)) ? left(x) : right(x);// 大则向左
   }
-  return insert_aux(x, y, val);// x为新值插入点，y为其父
+  return y;// y为新值插入点之父
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_equal(
     iterator pos, const value_type &val) {
   if (pos.node == header->left) {// begin()
     if (size() > 0 && !key_compare(key(pos.node), KeyOfValue()(val)))
-      return insert_aux(pos.node, pos.node, value);
+      return insert_aux(pos.node, pos.node, val);
     else
       return insert_equal(val);
   } else if (pos.node == header) {// end()
-    if (!key_compare(KeyOfValue()(val)), key(rightmost()))
+    if (!key_compare(KeyOfValue()(val), key(rightmost())))
       return insert_aux(nullptr, rightmost(), val);
     else
       return insert_equal(val);
@@ -725,32 +1179,177 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(
   }
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 template<class InputIterator>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_equal(
     InputIterator first, InputIterator last) {
-  for (; first != last; ++first) insert_equal(*first);
+  insert_equal_range(first, last, iterator_category_t<InputIterator>());
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(iterator pos) {
-  link_type y = reinterpret_cast<link_type>(rb_tree_rebalance_for_erase(
-      pos.node, header->parent, header->left, header->right));
-  destroy_node(y);
-  --node_count;
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class InputIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_equal_range(
+    InputIterator first, InputIterator last, input_iterator_tag) {
+  for (; first != last; ++first) insert_equal(end(), *first);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class ForwardIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_equal_range(
+    ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+  size_type n = 0;
+  if (empty() && sorted_input(first, last, false, n))
+    build_sorted(first, last, n, false);
+  else
+    insert_equal_range(first, last, input_iterator_tag());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class InputIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::assign_sorted_equal(
+    InputIterator first, InputIterator last) {
+  clear();
+  insert_equal_range(first, last, iterator_category_t<InputIterator>());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class ForwardIterator>
+bool rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::sorted_input(
+    ForwardIterator first, ForwardIterator last, bool unique, size_type &n) const {
+  n = 0;
+  if (first == last) return true;
+  n = 1;
+  for (ForwardIterator next = first; ++next != last; first = next) {
+    if (key_compare(KeyOfValue()(*next), KeyOfValue()(*first))) return false;
+    if (!unique || key_compare(KeyOfValue()(*first), KeyOfValue()(*next))) ++n;
+  }
+  return true;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class ForwardIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::build_sorted(
+    ForwardIterator first, ForwardIterator last, size_type n, bool unique) {
+  if (n == 0) return;
+  // 左右子树大小至多相差 1，除最底层外各层全满；
+  // 深度 < floor(log2(n + 1)) 的节点涂黑，最底层（若不满）涂红，各路径黑高相同
+  size_type red_depth = 0;
+  for (size_type m = n + 1; m > 1; m >>= 1) ++red_depth;
+  link_type r = build_subtree(first, last, n, 0, red_depth, unique);
+  r->parent = header;
+  root() = r;
+  leftmost() = minimum(r);
+  rightmost() = maximum(r);
+  node_count = n;
+}
+
+// 中序消耗输入：先建左子树，再建当前节点，最后建右子树；异常时释放已建部分
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class ForwardIterator>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::build_subtree(
+    ForwardIterator &first, ForwardIterator last, size_type n, size_type depth,
+    size_type red_depth, bool unique) {
+  if (n == 0) return nullptr;
+  const size_type left_n = (n - 1) / 2;
+  link_type l = build_subtree(first, last, left_n, depth + 1, red_depth, unique);
+  link_type x;
+  try {
+    x = create_node(*first);
+  } catch (std::exception &) {
+    erase_aux(l);
+    throw;
+  }
+  x->color = depth < red_depth ? rb_tree_black : rb_tree_red;
+  x->left = l;
+  x->right = nullptr;
+  if (l) l->parent = x;
+  ++first;
+  if (unique)
+    while (first != last && !key_compare(key(x), KeyOfValue()(*first))) ++first;
+  try {
+    link_type r = build_subtree(first, last, n - 1 - left_n, depth + 1, red_depth, unique);
+    x->right = r;
+    if (r) r->parent = x;
+  } catch (std::exception &) {
+    erase_aux(x);
+    throw;
+  }
+  augment_update(x);
+  return x;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_return_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique(
+    node_type &&nh) {
+  if (nh.empty()) return insert_return_type{end(), false, node_type()};
+  pair<link_type, bool> p = get_insert_unique_pos(key(nh.ptr));
+  if (!p.second) return insert_return_type{iterator(p.first), false, TinySTL::move(nh)};
+  return insert_return_type{link_node(nullptr, p.first, nh.release()), true, node_type()};
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_equal(
+    node_type &&nh) {
+  if (nh.empty()) return end();
+  link_type y = get_insert_equal_pos(key(nh.ptr));
+  return link_node(nullptr, y, nh.release());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::merge_unique(
+    rb_tree &src) {
+  if (&src == this) return;
+  for (iterator i = src.begin(); i != src.end();) {
+    pair<link_type, bool> p = get_insert_unique_pos(key(i.node));
+    base_ptr z = (i++).node;// 摘除前先前进，后继节点不受影响
+    if (p.second) link_node(nullptr, p.first, src.unlink_node(z));
+  }
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::merge_equal(
+    rb_tree &src) {
+  if (&src == this) return;
+  for (iterator i = src.begin(); i != src.end();) {
+    link_type y = get_insert_equal_pos(key(i.node));
+    base_ptr z = (i++).node;
+    link_node(nullptr, y, src.unlink_node(z));
+  }
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::erase(iterator pos) {
+  destroy_node(unlink_node(pos.node));
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::size_type
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(const key_type &k) {
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::erase(const key_type &k) {
   pair<iterator, iterator> p = equal_range(k);
   size_type n = TinySTL::distance(p.first, p.second);
   erase(p.first, p.second);
   return n;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(iterator first,
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::erase(iterator first,
                                                             iterator last) {
   if (first == begin() && last == end())
     clear();
@@ -758,8 +1357,9 @@ void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(iterator first,
     while (first != last) erase(first++);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::clear() noexcept {
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::clear() noexcept {
   if (node_count) {
     erase_aux(root());
     leftmost() = header;
@@ -769,9 +1369,10 @@ void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::clear() noexcept {
   }
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::link_type
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::copy(link_type x,
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::copy(link_type x,
                                                       link_type y) {
   link_type top = clone_node(x);
   top->parent = y;
@@ -789,57 +1390,441 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::copy(link_type x,
     }
   } catch (std::exception &) {
     erase_aux(top);
+    throw;
   }
   return top;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::take_root() noexcept {
+  size_type bh = 0;
+  for (link_type x = root(); x; x = left(x))
+    if (color(x) == rb_tree_black) ++bh;
+  subtree t{root(), bh};
+  if (t.root) t.root->parent = nullptr;
+  root() = nullptr;
+  leftmost() = header;
+  rightmost() = header;
+  node_count = 0;
+  return t;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::reset_root(subtree t, size_type n) noexcept {
+  root() = t.root;
+  node_count = n;
+  if (t.root) {
+    t.root->parent = header;
+    leftmost() = minimum(t.root);
+    rightmost() = maximum(t.root);
+  } else {
+    leftmost() = header;
+    rightmost() = header;
+  }
+}
+
+// 黑高相同时 k 作为黑色新根；否则沿较高一侧的边缘下降至黑高相同的黑节点处接入红色的 k，
+// 再按插入的方式重新平衡，红色可能上溯至根使黑高加一
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::join_aux(subtree l, link_type k, subtree r) noexcept {
+  if (l.bh > r.bh) return join_right(l, k, r);
+  if (l.bh < r.bh) return join_left(l, k, r);
+  color(k) = rb_tree_black;
+  k->parent = nullptr;
+  k->left = l.root;
+  k->right = r.root;
+  if (l.root) l.root->parent = k;
+  if (r.root) r.root->parent = k;
+  augment_update(k);
+  return subtree{k, l.bh + 1};
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::join_right(subtree l, link_type k, subtree r) noexcept {
+  link_type p = nullptr;
+  link_type c = l.root;
+  size_type h = l.bh;// c 的黑高
+  while (h > r.bh || (c && color(c) == rb_tree_red)) {
+    if (color(c) == rb_tree_black) --h;
+    p = c;
+    c = right(c);
+  }
+  k->left = c;
+  if (c) c->parent = k;
+  k->right = r.root;
+  if (r.root) r.root->parent = k;
+  k->parent = p;
+  p->right = k;
+  if constexpr (augmented)
+    for (base_ptr x = k; x; x = x->parent) augment_update(x);
+  base_ptr top = l.root;
+  const bool grew = rb_tree_rebalance(k, top);
+  return subtree{reinterpret_cast<link_type>(top), l.bh + grew};
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::join_left(subtree l, link_type k, subtree r) noexcept {
+  link_type p = nullptr;
+  link_type c = r.root;
+  size_type h = r.bh;
+  while (h > l.bh || (c && color(c) == rb_tree_red)) {
+    if (color(c) == rb_tree_black) --h;
+    p = c;
+    c = left(c);
+  }
+  k->right = c;
+  if (c) c->parent = k;
+  k->left = l.root;
+  if (l.root) l.root->parent = k;
+  k->parent = p;
+  p->left = k;
+  if constexpr (augmented)
+    for (base_ptr x = k; x; x = x->parent) augment_update(x);
+  base_ptr top = r.root;
+  const bool grew = rb_tree_rebalance(k, top);
+  return subtree{reinterpret_cast<link_type>(top), r.bh + grew};
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::join2_aux(subtree l, subtree r) noexcept {
+  if (!l.root) return r;
+  if (!r.root) return l;
+  link_type k = split_last(l);
+  return join_aux(l, k, r);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::split_last(subtree &t) noexcept {
+  link_type x = t.root;
+  subtree l = detach(left(x), t.bh - 1);
+  if (!x->right) {
+    t = l;
+    return x;
+  }
+  subtree r = detach(right(x), t.bh - 1);
+  link_type last = split_last(r);
+  t = join_aux(l, x, r);
+  return last;
+}
+
+// 沿查找路径下降，回溯时把路径两侧的子树依次 join，总代价 O(log n)
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::split_aux(subtree t, const key_type &k, subtree &l, subtree &r,
+                                                           link_type *eq) noexcept {
+  if (!t.root) {
+    l = r = subtree{nullptr, 0};
+    return;
+  }
+  link_type x = t.root;
+  subtree xl = detach(left(x), t.bh - 1);
+  subtree xr = detach(right(x), t.bh - 1);
+  if (key_compare(key(x), k)) {
+    subtree m;
+    split_aux(xr, k, m, r, eq);
+    l = join_aux(xl, x, m);
+  } else if (eq && !key_compare(k, key(x))) {
+    l = xl;
+    r = xr;
+    *eq = x;
+  } else {
+    subtree m;
+    split_aux(xl, k, l, m, eq);
+    r = join_aux(m, x, xr);
+  }
+}
+
+// 以 x 的键值划分 t，两侧分别与 x 的左右子树递归求并，再以 x（或 t 中的等价节点）join
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class Invoke>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::union_aux(subtree t, link_type x, size_type bh, node_list &garbage,
+                                                            Invoke &invoke) noexcept {
+  if (!x) return t;
+  if (!t.root) return detach(x, bh);
+  link_type xl = left(x), xr = right(x);
+  const size_type child_bh = bh - (color(x) == rb_tree_black);
+  subtree l, r;
+  link_type eq = nullptr;
+  split_aux(t, key(x), l, r, &eq);
+  node_list rg;
+  auto f1 = [&] { l = union_aux(l, xl, child_bh, garbage, invoke); };
+  auto f2 = [&] { r = union_aux(r, xr, child_bh, rg, invoke); };
+  invoke(bh, f1, f2);
+  list_splice(garbage, rg);
+  if (eq) {// 保留本树的元素
+    x->left = x->right = nullptr;
+    list_push(garbage, x);
+    x = eq;
+  }
+  return join_aux(l, x, r);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class Invoke>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::intersect_aux(subtree t, link_type x, size_type bh, node_list &garbage,
+                                                                Invoke &invoke) noexcept {
+  if (!t.root) return t;
+  if (!x) {
+    list_push(garbage, t.root);
+    return subtree{nullptr, 0};
+  }
+  const size_type child_bh = bh - (color(x) == rb_tree_black);
+  subtree l, r;
+  link_type eq = nullptr;
+  split_aux(t, key(x), l, r, &eq);
+  node_list rg;
+  auto f1 = [&] { l = intersect_aux(l, left(x), child_bh, garbage, invoke); };
+  auto f2 = [&] { r = intersect_aux(r, right(x), child_bh, rg, invoke); };
+  invoke(bh, f1, f2);
+  list_splice(garbage, rg);
+  return eq ? join_aux(l, eq, r) : join2_aux(l, r);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class Invoke>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::difference_aux(subtree t, link_type x, size_type bh, node_list &garbage,
+                                                                 Invoke &invoke) noexcept {
+  if (!t.root || !x) return t;
+  const size_type child_bh = bh - (color(x) == rb_tree_black);
+  subtree l, r;
+  link_type eq = nullptr;
+  split_aux(t, key(x), l, r, &eq);
+  node_list rg;
+  auto f1 = [&] { l = difference_aux(l, left(x), child_bh, garbage, invoke); };
+  auto f2 = [&] { r = difference_aux(r, right(x), child_bh, rg, invoke); };
+  invoke(bh, f1, f2);
+  list_splice(garbage, rg);
+  if (eq) {
+    eq->left = eq->right = nullptr;
+    list_push(garbage, eq);
+  }
+  return join2_aux(l, r);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class Invoke>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::union_with_aux(rb_tree &other, Invoke invoke) noexcept {
+  if (&other == this) return;
+  const size_type n = node_count + other.node_count;
+  subtree a = take_root();
+  subtree b = other.take_root();
+  node_list garbage;
+  subtree t = union_aux(a, b.root, b.bh, garbage, invoke);
+  reset_root(t, n - destroy_list(garbage));
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class Invoke>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::intersect_with_aux(const rb_tree &other, Invoke invoke) noexcept {
+  if (&other == this) return;
+  size_type bh = 0;
+  for (link_type x = other.root(); x; x = left(x))
+    if (color(x) == rb_tree_black) ++bh;
+  const size_type n = node_count;
+  node_list garbage;
+  subtree t = intersect_aux(take_root(), other.root(), bh, garbage, invoke);
+  reset_root(t, n - destroy_list(garbage));
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+template<class Invoke>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::difference_with_aux(const rb_tree &other, Invoke invoke) noexcept {
+  if (&other == this) {
+    clear();
+    return;
+  }
+  size_type bh = 0;
+  for (link_type x = other.root(); x; x = left(x))
+    if (color(x) == rb_tree_black) ++bh;
+  const size_type n = node_count;
+  node_list garbage;
+  subtree t = difference_aux(take_root(), other.root(), bh, garbage, invoke);
+  reset_root(t, n - destroy_list(garbage));
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::split(const key_type &k) {
+  rb_tree r(key_compare);
+  const size_type n = node_count;
+  subtree l, g;
+  split_aux(take_root(), k, l, g, nullptr);
+  size_type nl;
+  if constexpr (_rb_tree_has_size<Augment>::value) {
+    nl = subtree_size(l.root);
+    reset_root(l, nl);
+  } else {
+    // 两侧交替前进，先走完的一侧即为较小者
+    reset_root(l, 0);
+    r.reset_root(g, 0);
+    const_iterator i = cbegin(), j = r.cbegin();
+    size_type c = 0;
+    for (; i != cend() && j != r.cend(); ++i, ++j) ++c;
+    nl = i == cend() ? c : n - c;
+    node_count = nl;
+  }
+  r.reset_root(g, n - nl);
+  return r;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::join(rb_tree &&right) noexcept {
+  if (&right == this) return;
+  const size_type n = node_count + right.node_count;
+  subtree t = join2_aux(take_root(), right.take_root());
+  reset_root(t, n);
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::nth(size_type k) noexcept {
+  static_assert(_rb_tree_has_size<Augment>::value, "nth requires a size-maintaining Augment");
+  link_type x = root();
+  while (x) {
+    const size_type l = subtree_size(x->left);
+    if (k < l) {
+      x = left(x);
+    } else if (k == l) {
+      return iterator(x);
+    } else {
+      k -= l + 1;
+      x = right(x);
+    }
+  }
+  return end();
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::rank(const key_type &k) const noexcept {
+  static_assert(_rb_tree_has_size<Augment>::value, "rank requires a size-maintaining Augment");
+  size_type r = 0;
+  link_type x = root();
+  while (x) {
+    if (!key_compare(key(x), k)) {
+      x = left(x);
+    } else {
+      r += subtree_size(x->left) + 1;
+      x = right(x);
+    }
+  }
+  return r;
+}
+
+// 从 node 上溯至 root 途经的黑节点数
+inline int _rb_tree_black_count(_rb_tree_node_base *node, _rb_tree_node_base *root) {
+  int sum = 0;
+  for (; node; node = node->parent) {
+    if (node->color == rb_tree_black) ++sum;
+    if (node == root) break;
+  }
+  return sum;
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
+bool rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::rb_verify() const noexcept {
+  if (node_count == 0 || !root())
+    return node_count == 0 && !root() && leftmost() == header && rightmost() == header;
+  if (root()->color != rb_tree_black || root()->parent != header) return false;
+  const int len = _rb_tree_black_count(leftmost(), root());
+  size_type n = 0;
+  for (const_iterator it = begin(); it != end(); ++it, ++n) {
+    base_ptr x = it.node;
+    base_ptr l = x->left;
+    base_ptr r = x->right;
+    if (x->color == rb_tree_red &&
+        ((l && l->color == rb_tree_red) || (r && r->color == rb_tree_red)))
+      return false;
+    if (l && (l->parent != x || key_compare(key(x), key(l)))) return false;
+    if (r && (r->parent != x || key_compare(key(r), key(x)))) return false;
+    if ((!l || !r) && _rb_tree_black_count(x, root()) != len) return false;
+    if constexpr (_rb_tree_has_size<Augment>::value)
+      if (subtree_size(x) != 1 + subtree_size(l) + subtree_size(r)) return false;
+  }
+  return n == node_count && leftmost() == minimum(root()) && rightmost() == maximum(root());
+}
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline bool operator==(
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) {
   return lhs.size() == rhs.size() && TinySTL::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline bool operator!=(
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) {
   return !(lhs == rhs);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline bool operator<(
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) {
   return TinySTL::lexicographical_compare(lhs.cbegin(), lhs.cend(),
                                           rhs.cbegin(), rhs.cend());
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline bool operator>(
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) {
   return rhs < lhs;
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline bool operator<=(
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) {
   return !(rhs < lhs);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline bool operator>=(
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) {
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) {
   return !(lhs < rhs);
 }
 
-template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc,
+         class Augment>
 inline void swap(
-    rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs,
-    rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) noexcept {
+    rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &lhs,
+    rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> &rhs) noexcept {
   lhs.swap(rhs);
 }
 
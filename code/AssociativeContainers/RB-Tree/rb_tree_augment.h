@@ -0,0 +1,104 @@
+/*
+rb_tree 的节点附加数据（augmentation）策略。
+
+策略类型 Augment 需提供：
+    using data_type = ...;                   // 每个节点附加的数据
+    template<class Value>
+    static void update(data_type &x, const Value &v,
+                       const data_type *l, const data_type *r);
+                                             // 由自身值与左右子树（可为空）的数据重新计算 x
+rb_tree 在插入、删除后沿路径上溯调用 update，旋转时依次更新下沉与上浮的两个节点，
+因此每个节点的附加数据始终是其整棵子树的聚合。
+提供 static size_t subtree_size(const data_type &) 的策略可支持 nth / rank / count_range。
+通用聚合 rb_tree_aggregate_augment 以投影 Project 取出节点上的量，再以可结合的 Combine
+按中序合并左子树、自身与右子树，sum / min / max 均为其特例。
+*/
+#pragma once
+
+#include "AssociativeContainers/RB-Tree/rb_tree_node.h"
+#include "Function/function_adapter.h"
+#include "Utils/type_traits.h"
+#include <cstddef>
+
+namespace TinySTL {
+
+// 不附加任何数据（默认）
+struct rb_tree_no_augment {};
+
+// 附加子树大小，支持 O(log n) 的按序访问与排名
+struct rb_tree_size_augment {
+    using data_type = size_t;
+
+    template<class Value>
+    static void update(data_type &x, const Value &, const data_type *l, const data_type *r) {
+        x = 1 + (l ? *l : 0) + (r ? *r : 0);
+    }
+    static size_t subtree_size(const data_type &x) { return x; }
+};
+
+// 子树聚合：x = Combine(Combine(l, Project(v)), r)，Combine 须满足结合律
+// Project 与 Combine 须可默认构造且无状态
+template<class Data, class Project, class Combine>
+struct rb_tree_aggregate_augment {
+    using data_type = Data;
+
+    template<class Value>
+    static void update(data_type &x, const Value &v, const data_type *l, const data_type *r) {
+        Combine op;
+        x = Project()(v);
+        if (l) x = op(*l, x);
+        if (r) x = op(x, *r);
+    }
+};
+
+// 按 Compare 取较小 / 较大者
+template<class T, class Compare = less<T>>
+struct rb_tree_min_of {
+    const T &operator()(const T &x, const T &y) const { return Compare()(y, x) ? y : x; }
+};
+
+template<class T, class Compare = less<T>>
+struct rb_tree_max_of {
+    const T &operator()(const T &x, const T &y) const { return Compare()(x, y) ? y : x; }
+};
+
+template<class Data, class Project>
+using rb_tree_sum_augment = rb_tree_aggregate_augment<Data, Project, plus<Data>>;
+
+template<class Data, class Project, class Compare = less<Data>>
+using rb_tree_min_augment = rb_tree_aggregate_augment<Data, Project, rb_tree_min_of<Data, Compare>>;
+
+template<class Data, class Project, class Compare = less<Data>>
+using rb_tree_max_augment = rb_tree_aggregate_augment<Data, Project, rb_tree_max_of<Data, Compare>>;
+
+// 带附加数据的节点，value_field 的偏移与 _rb_tree_node 相同，迭代器无需区分
+template<class T, class Data>
+struct _rb_tree_aug_node : public _rb_tree_node<T> {
+    Data aug;
+};
+
+template<class Augment, class = void>
+struct _rb_tree_is_augmented : false_type {};
+
+template<class Augment>
+struct _rb_tree_is_augmented<Augment, void_t<typename Augment::data_type>> : true_type {};
+
+template<class Augment, class = void>
+struct _rb_tree_has_size : false_type {};
+
+template<class Augment>
+struct _rb_tree_has_size<
+    Augment, void_t<decltype(Augment::subtree_size(declval<const typename Augment::data_type &>()))>>
+    : true_type {};
+
+template<class Value, class Augment, bool = _rb_tree_is_augmented<Augment>::value>
+struct _rb_tree_node_type {
+    using type = _rb_tree_node<Value>;
+};
+
+template<class Value, class Augment>
+struct _rb_tree_node_type<Value, Augment, true> {
+    using type = _rb_tree_aug_node<Value, typename Augment::data_type>;
+};
+
+}// namespace TinySTL
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "AssociativeContainers/RB-Tree/rb_tree.h"
+#include "AssociativeContainers/Set/stl_set.h"
+
+namespace TinySTL {
+// Forward declarations of operators == and <, needed for friend declarations.
+template<class Key, class Compare, class Alloc, class Augment>
+class multiset;
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator==(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                       const multiset<Key, Compare, Alloc, Augment> &rhs);
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator<(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                      const multiset<Key, Compare, Alloc, Augment> &rhs);
+
+// 与 set 的唯一区别：插入使用 rb_tree::insert_equal，允许键值重复
+template<class Key, class Compare = less<Key>, class Alloc = simpleAlloc<Key>,
+         class Augment = rb_tree_no_augment>
+class multiset {
+  // friend declarations
+  template<class _Key, class _Compare, class _Alloc, class _Augment>
+  friend bool operator==(const multiset<_Key, _Compare, _Alloc, _Augment> &lhs,
+                         const multiset<_Key, _Compare, _Alloc, _Augment> &rhs);
+  template<class _Key, class _Compare, class _Alloc, class _Augment>
+  friend bool operator<(const multiset<_Key, _Compare, _Alloc, _Augment> &lhs,
+                        const multiset<_Key, _Compare, _Alloc, _Augment> &rhs);
+  // merge 需访问同参数 set 的底层红黑树
+  template<class, class, class, class>
+  friend class set;
+
+ public:// key_type is value_type
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+ private:// data member
+  using rep_type =
+      rb_tree<key_type, value_type, identity<value_type>, Compare, Alloc, Augment>;
+  rep_type t;
+
+ public:
+  // 键值不可修改，迭代器与指针均为const
+  using pointer = typename rep_type::const_pointer;
+  using const_pointer = typename rep_type::const_pointer;
+  using reference = typename rep_type::const_reference;
+  using const_reference = typename rep_type::const_reference;
+  using iterator = typename rep_type::const_iterator;
+  using const_iterator = typename rep_type::const_iterator;
+  using reverse_iterator = typename rep_type::const_reverse_iterator;
+  using const_reverse_iterator = typename rep_type::const_reverse_iterator;
+  using size_type = typename rep_type::size_type;
+  using difference_type = typename rep_type::difference_type;
+
+ public:// ctor
+  // use insert_equal
+  multiset() : t(key_compare()) {}
+  explicit multiset(const key_compare &comp) : t(comp) {}
+  template<class InputIterator>
+  multiset(InputIterator first, InputIterator last,
+           const key_compare &comp = Compare())
+      : t(comp) {
+    t.insert_equal(first, last);
+  }
+  multiset(std::initializer_list<value_type> ils,
+           const key_compare &comp = Compare())
+      : t(comp) {
+    t.insert_equal(ils.begin(), ils.end());
+  }
+  // 调用者保证 [first, last) 已有序，O(n) 建树
+  template<class InputIterator>
+  multiset(assign_sorted_t, InputIterator first, InputIterator last,
+           const key_compare &comp = Compare())
+      : t(comp) {
+    t.assign_sorted_equal(first, last);
+  }
+
+ public:// copy operations
+  multiset(const multiset &rhs) : t(rhs.t) {}
+  multiset &operator=(const multiset &rhs) {
+    t = rhs.t;
+    return *this;
+  }
+  multiset &operator=(std::initializer_list<value_type> ils) {
+    clear();
+    insert(ils.begin(), ils.end());
+    return *this;
+  }
+
+ public:// move operation
+  multiset(multiset &&rhs) noexcept : t(TinySTL::move(rhs.t)) {}
+  multiset &operator=(multiset &&rhs) noexcept {
+    t = TinySTL::move(rhs.t);
+    return *this;
+  }
+
+ public:// getter
+  key_compare key_comp() const noexcept { return t.key_comp(); }
+  value_compare value_comp() const noexcept { return t.key_comp(); }
+  bool empty() const noexcept { return t.empty(); }
+  size_type size() const noexcept { return t.size(); }
+  // read only
+  iterator begin() const noexcept { return t.cbegin(); }
+  iterator end() const noexcept { return t.cend(); }
+  const_iterator cbegin() const noexcept { return t.cbegin(); }
+  const_iterator cend() const noexcept { return t.cend(); }
+  reverse_iterator rbegin() const noexcept { return t.rbegin(); }
+  reverse_iterator rend() const noexcept { return t.rend(); }
+  const_reverse_iterator crbegin() const noexcept { return t.crbegin(); }
+  const_reverse_iterator crend() const noexcept { return t.crend(); }
+
+ public:// swap
+  void swap(multiset &rhs) noexcept { t.swap(rhs.t); }
+
+ public:// insert
+  iterator insert(const value_type &val) { return t.insert_equal(val); }
+  iterator insert(const_iterator hint, const value_type &val) {
+    using rep_iterator = typename rep_type::iterator;
+    return t.insert_equal(reinterpret_cast<rep_iterator &>(hint), val);
+  }
+  template<class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    t.insert_equal(first, last);
+  }
+  void insert(std::initializer_list<value_type> ils) {
+    insert(ils.begin(), ils.end());
+  }
+
+ public:// node handle
+  using node_type = typename rep_type::node_type;
+  node_type extract(const_iterator pos) noexcept {
+    using rep_iterator = typename rep_type::iterator;
+    return t.extract(reinterpret_cast<rep_iterator &>(pos));
+  }
+  node_type extract(const key_type &key) { return t.extract(key); }
+  iterator insert(node_type &&nh) { return t.insert_equal(TinySTL::move(nh)); }
+  // 移入 src 的全部元素，只重新链接节点
+  void merge(multiset &src) { t.merge_equal(src.t); }
+  void merge(set<Key, Compare, Alloc, Augment> &src) { t.merge_equal(src.t); }
+
+ public:// erase
+  void erase(iterator pos) {
+    using rep_iterator = typename rep_type::iterator;
+    t.erase(reinterpret_cast<rep_iterator &>(pos));
+  }
+  size_type erase(const key_type &val) { return t.erase(val); }
+  void erase(iterator first, iterator last) {
+    using rep_iterator = typename rep_type::iterator;
+    t.erase(reinterpret_cast<rep_iterator &>(first),
+            reinterpret_cast<rep_iterator &>(last));
+  }
+  void clear() noexcept { t.clear(); }
+
+ public:// find
+  iterator find(const key_type &key) const noexcept { return t.find(key); }
+  size_type count(const key_type &key) const noexcept { return t.count(key); }
+  iterator lower_bound(const key_type &key) const noexcept {
+    return t.lower_bound(key);
+  }
+  iterator upper_bound(const key_type &key) const noexcept {
+    return t.upper_bound(key);
+  }
+  pair<iterator, iterator> equal_range(const key_type &key) const noexcept {
+    return t.equal_range(key);
+  }
+
+ public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator find(const K &key) const noexcept {
+    return t.find(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  size_type count(const K &key) const noexcept {
+    return t.count(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator lower_bound(const K &key) const noexcept {
+    return t.lower_bound(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator upper_bound(const K &key) const noexcept {
+    return t.upper_bound(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<iterator, iterator> equal_range(const K &key) const noexcept {
+    return t.equal_range(key);
+  }
+
+ public:// order statistic，要求 Augment 维护子树大小（如 rb_tree_size_augment）
+  iterator nth(size_type k) const noexcept { return t.nth(k); }
+  size_type rank(const key_type &key) const noexcept { return t.rank(key); }
+  size_type count_range(const key_type &lo, const key_type &hi) const noexcept {
+    return t.count_range(lo, hi);
+  }
+};
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator==(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                       const multiset<Key, Compare, Alloc, Augment> &rhs) {
+  return lhs.t == rhs.t;
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator!=(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                       const multiset<Key, Compare, Alloc, Augment> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator<(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                      const multiset<Key, Compare, Alloc, Augment> &rhs) {
+  return lhs.t < rhs.t;
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator>(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                      const multiset<Key, Compare, Alloc, Augment> &rhs) {
+  return rhs < lhs;
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator<=(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                       const multiset<Key, Compare, Alloc, Augment> &rhs) {
+  return !(rhs < lhs);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator>=(const multiset<Key, Compare, Alloc, Augment> &lhs,
+                       const multiset<Key, Compare, Alloc, Augment> &rhs) {
+  return !(lhs < rhs);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline void swap(multiset<Key, Compare, Alloc, Augment> &lhs,
+                 multiset<Key, Compare, Alloc, Augment> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
@@ -4,26 +4,33 @@
 
 namespace TinySTL {
 // Forward declarations of operators == and <, needed for friend declarations.
-template<class Key, class Compare, class Alloc>
+template<class Key, class Compare, class Alloc, class Augment>
 class set;
 
-template<class Key, class Compare, class Alloc>
-inline bool operator==(const set<Key, Compare, Alloc> &lhs,
-                       const set<Key, Compare, Alloc> &rhs);
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator==(const set<Key, Compare, Alloc, Augment> &lhs,
+                       const set<Key, Compare, Alloc, Augment> &rhs);
 
-template<class Key, class Compare, class Alloc>
-inline bool operator<(const set<Key, Compare, Alloc> &lhs,
-                      const set<Key, Compare, Alloc> &rhs);
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator<(const set<Key, Compare, Alloc, Augment> &lhs,
+                      const set<Key, Compare, Alloc, Augment> &rhs);
 
-template<class Key, class Compare = less<Key>, class Alloc = simpleAlloc<Key>>
+template<class Key, class Compare, class Alloc, class Augment>
+class multiset;
+
+template<class Key, class Compare = less<Key>, class Alloc = simpleAlloc<Key>,
+         class Augment = rb_tree_no_augment>
 class set {
   // friend declarations
-  template<class _Key, class _Compare, class _Alloc>
-  friend bool operator==(const set<_Key, _Compare, _Alloc> &lhs,
-                         const set<_Key, _Compare, _Alloc> &rhs);
-  template<class _Key, class _Compare, class _Alloc>
-  friend bool operator<(const set<_Key, _Compare, _Alloc> &lhs,
-                        const set<_Key, _Compare, _Alloc> &rhs);
+  template<class _Key, class _Compare, class _Alloc, class _Augment>
+  friend bool operator==(const set<_Key, _Compare, _Alloc, _Augment> &lhs,
+                         const set<_Key, _Compare, _Alloc, _Augment> &rhs);
+  template<class _Key, class _Compare, class _Alloc, class _Augment>
+  friend bool operator<(const set<_Key, _Compare, _Alloc, _Augment> &lhs,
+                        const set<_Key, _Compare, _Alloc, _Augment> &rhs);
+  // merge 需访问同参数 multiset 的底层红黑树
+  template<class, class, class, class>
+  friend class multiset;
 
  public:// key_type is value_type
   using key_type = Key;
@@ -33,7 +40,7 @@ class set {
 
  private:// data member
   using rep_type =
-      rb_tree<key_type, value_type, identity<value_type>, Compare, Alloc>;
+      rb_tree<key_type, value_type, identity<value_type>, Compare, Alloc, Augment>;
   rep_type t;
 
  public:
@@ -64,6 +71,13 @@ class set {
       : t(comp) {
     t.insert_unique(ils.begin(), ils.end());
   }
+  // 调用者保证 [first, last) 已有序，O(n) 建树
+  template<class InputIterator>
+  set(assign_sorted_t, InputIterator first, InputIterator last,
+      const key_compare &comp = Compare())
+      : t(comp) {
+    t.assign_sorted_unique(first, last);
+  }
 
  public:// copy operations
   set(const set &rhs) : t(rhs.t) {}
@@ -121,6 +135,52 @@ class set {
     insert(ils.begin(), ils.end());
   }
 
+ public:// node handle
+  using node_type = typename rep_type::node_type;
+  using insert_return_type = node_insert_return<iterator, node_type>;
+  node_type extract(const_iterator pos) noexcept {
+    using rep_iterator = typename rep_type::iterator;
+    return t.extract(reinterpret_cast<rep_iterator &>(pos));
+  }
+  node_type extract(const key_type &key) { return t.extract(key); }
+  insert_return_type insert(node_type &&nh) {
+    typename rep_type::insert_return_type r = t.insert_unique(TinySTL::move(nh));
+    return insert_return_type{r.position, r.inserted, TinySTL::move(r.node)};
+  }
+  // 移入 src 中键值不重复的元素，只重新链接节点
+  void merge(set &src) { t.merge_unique(src.t); }
+  void merge(multiset<Key, Compare, Alloc, Augment> &src) { t.merge_unique(src.t); }
+
+ public:// set algebra，基于 split / join，O(m log(n/m + 1))，只重新链接节点
+  // 右值版本直接取用 other 的节点，other 被清空；重复元素保留本集合的
+  void union_with(set &&other) noexcept { t.union_with(TinySTL::move(other.t)); }
+  void union_with(const set &other) { t.union_with(other.t); }
+  void intersect_with(const set &other) noexcept { t.intersect_with(other.t); }
+  void difference_with(const set &other) noexcept { t.difference_with(other.t); }
+  // 并行版本，Pool 须提供 parallel_invoke（如 thread_pool）
+  template<class Pool>
+  void parallel_union_with(set &&other, Pool &pool, size_type grain = 4096) noexcept {
+    t.parallel_union_with(TinySTL::move(other.t), pool, grain);
+  }
+  template<class Pool>
+  void parallel_intersect_with(const set &other, Pool &pool, size_type grain = 4096) noexcept {
+    t.parallel_intersect_with(other.t, pool, grain);
+  }
+  template<class Pool>
+  void parallel_difference_with(const set &other, Pool &pool, size_type grain = 4096) noexcept {
+    t.parallel_difference_with(other.t, pool, grain);
+  }
+
+ public:// split && join
+  // 不小于 k 的元素移入返回的 set，见 rb_tree::split
+  set split(const key_type &k) {
+    set r(t.key_comp());
+    r.t = t.split(k);
+    return r;
+  }
+  // 将元素均大于本 set 的 right 接在其后，right 被清空，O(log n)
+  void join(set &&right) noexcept { t.join(TinySTL::move(right.t)); }
+
  public:// erase
   void erase(iterator pos) {
     using rep_iterator = typename rep_type::iterator;
@@ -161,47 +221,100 @@ class set {
       const key_type &key) const {
     return t.equal_range(key);
   }
+
+ public:// heterogeneous find，仅当 Compare::is_transparent 存在时可用
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator find(const K &key) noexcept {
+    return t.find(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator find(const K &key) const noexcept {
+    return t.find(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  size_type count(const K &key) const noexcept {
+    return t.count(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator lower_bound(const K &key) noexcept {
+    return t.lower_bound(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator lower_bound(const K &key) const noexcept {
+    return t.lower_bound(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  iterator upper_bound(const K &key) noexcept {
+    return t.upper_bound(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  const_iterator upper_bound(const K &key) const noexcept {
+    return t.upper_bound(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<iterator, iterator> equal_range(const K &key) noexcept {
+    return t.equal_range(key);
+  }
+  template<class K, class C = Compare, class = enable_if_t<has_is_transparent<C>::value>>
+  pair<const_iterator, const_iterator> equal_range(const K &key) const noexcept {
+    return t.equal_range(key);
+  }
+
+ public:// order statistic，要求 Augment 维护子树大小（如 rb_tree_size_augment）
+  iterator nth(size_type k) const noexcept { return t.nth(k); }
+  size_type rank(const key_type &key) const noexcept { return t.rank(key); }
+  size_type count_range(const key_type &lo, const key_type &hi) const noexcept {
+    return t.count_range(lo, hi);
+  }
 };
 
-template<class Key, class Compare, class Alloc>
-inline bool operator==(const set<Key, Compare, Alloc> &lhs,
-                       const set<Key, Compare, Alloc> &rhs) {
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator==(const set<Key, Compare, Alloc, Augment> &lhs,
+                       const set<Key, Compare, Alloc, Augment> &rhs) {
   return lhs.t == rhs.t;
 }
 
-template<class Key, class Compare, class Alloc>
-inline bool operator!=(const set<Key, Compare, Alloc> &lhs,
-                       const set<Key, Compare, Alloc> &rhs) {
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator!=(const set<Key, Compare, Alloc, Augment> &lhs,
+                       const set<Key, Compare, Alloc, Augment> &rhs) {
   return !(lhs.t == rhs.t);
 }
 
-template<class Key, class Compare, class Alloc>
-inline bool operator<(const set<Key, Compare, Alloc> &lhs,
-                      const set<Key, Compare, Alloc> &rhs) {
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator<(const set<Key, Compare, Alloc, Augment> &lhs,
+                      const set<Key, Compare, Alloc, Augment> &rhs) {
   return lhs.t < rhs.t;
 }
 
-template<class Key, class Compare, class Alloc>
-inline bool operator>(const set<Key, Compare, Alloc> &lhs,
-                      const set<Key, Compare, Alloc> &rhs) {
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator>(const set<Key, Compare, Alloc, Augment> &lhs,
+                      const set<Key, Compare, Alloc, Augment> &rhs) {
   return rhs < lhs;
 }
 
-template<class Key, class Compare, class Alloc>
-inline bool operator<=(const set<Key, Compare, Alloc> &lhs,
-                       const set<Key, Compare, Alloc> &rhs) {
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator<=(const set<Key, Compare, Alloc, Augment> &lhs,
+                       const set<Key, Compare, Alloc, Augment> &rhs) {
   return !(rhs < lhs);
 }
 
-template<class Key, class Compare, class Alloc>
-inline bool operator>=(const set<Key, Compare, Alloc> &lhs,
-                       const set<Key, Compare, Alloc> &rhs) {
+template<class Key, class Compare, class Alloc, class Augment>
+inline bool operator>=(const set<Key, Compare, Alloc, Augment> &lhs,
+                       const set<Key, Compare, Alloc, Augment> &rhs) {
   return !(lhs < rhs);
 }
 
-template<class Key, class Compare, class Alloc>
-inline void swap(const set<Key, Compare, Alloc> &lhs,
-                 const set<Key, Compare, Alloc> &rhs) noexcept {
+// 连接两个范围有序的 set：left 的元素均小于 right
+template<class Key, class Compare, class Alloc, class Augment>
+inline set<Key, Compare, Alloc, Augment> join(set<Key, Compare, Alloc, Augment> &&left,
+                                              set<Key, Compare, Alloc, Augment> &&right) {
+  left.join(TinySTL::move(right));
+  return TinySTL::move(left);
+}
+
+template<class Key, class Compare, class Alloc, class Augment>
+inline void swap(const set<Key, Compare, Alloc, Augment> &lhs,
+                 const set<Key, Compare, Alloc, Augment> &rhs) noexcept {
   lhs.swap(rhs);
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Utils/type_traits.h"
+
 namespace TinySTL {
 // 一元运算符
 template<class Arg, class Result>
@@ -60,7 +62,7 @@ inline T identity_element(multiplies<T>) {
 
 // 运算关系类仿函数
 // equal_to,not_equal_to,greater,less,greater_equal,less_equal
-template<class T>
+template<class T = void>
 struct equal_to : public binary_function<T, T, bool> {
   bool operator()(const T &x, const T &y) const { return x == y; }
 };
@@ -70,12 +72,12 @@ struct not_equal_to : public binary_function<T, T, bool> {
   bool operator()(const T &x, const T &y) const { return x != y; }
 };
 
-template<class T>
+template<class T = void>
 struct greater : public binary_function<T, T, bool> {
   bool operator()(const T &x, const T &y) const { return x > y; }
 };
 
-template<class T>
+template<class T = void>
 struct less : public binary_function<T, T, bool> {
   bool operator()(const T &x, const T &y) const { return x < y; }
 };
@@ -90,6 +92,38 @@ struct less_equal : public binary_function<T, T, bool> {
   bool operator()(const T &x, const T &y) const { return x <= y; }
 };
 
+// 透明比较：void 特化接受任意两个可比较的实参，并以 is_transparent 告知关联容器
+// 开放异构查找，例如以 const char* 查找 std::string 键而不构造临时对象
+template<>
+struct equal_to<void> {
+  using is_transparent = void;
+  template<class T, class U>
+  constexpr auto operator()(T &&x, U &&y) const
+      -> decltype(TinySTL::forward<T>(x) == TinySTL::forward<U>(y)) {
+    return TinySTL::forward<T>(x) == TinySTL::forward<U>(y);
+  }
+};
+
+template<>
+struct greater<void> {
+  using is_transparent = void;
+  template<class T, class U>
+  constexpr auto operator()(T &&x, U &&y) const
+      -> decltype(TinySTL::forward<T>(x) > TinySTL::forward<U>(y)) {
+    return TinySTL::forward<T>(x) > TinySTL::forward<U>(y);
+  }
+};
+
+template<>
+struct less<void> {
+  using is_transparent = void;
+  template<class T, class U>
+  constexpr auto operator()(T &&x, U &&y) const
+      -> decltype(TinySTL::forward<T>(x) < TinySTL::forward<U>(y)) {
+    return TinySTL::forward<T>(x) < TinySTL::forward<U>(y);
+  }
+};
+
 // 逻辑运算类仿函数
 // logical_and,logical_or,logical_not
 template<class T>
@@ -545,6 +579,13 @@ inline const_mem_fun1_ref_t<S, T, Arg> mem_fun1_ref(S (T::*f)(Arg) const) {
   return const_mem_fun1_ref_t<S, T, Arg>(f);
 }
 
+// 内部标签，仅供 map/hash_map 的 try_emplace 使用：first 由首个实参构造，
+// second 由其余实参原位构造。与 std::piecewise_construct 的语义不同，故不沿用其名
+struct _pair_emplace_t {
+  explicit _pair_emplace_t() = default;
+};
+inline constexpr _pair_emplace_t _pair_emplace{};
+
 // struct pair
 template<class T1, class T2>
 struct pair {
@@ -556,6 +597,9 @@ struct pair {
 
   pair() : first(first_type()), second(second_type()) {}
   pair(const first_type &a, const second_type &b) : first(a), second(b) {}
+  template<class U1, class... Args>
+  pair(_pair_emplace_t, U1 &&a, Args &&...args)
+      : first(TinySTL::forward<U1>(a)), second(TinySTL::forward<Args>(args)...) {}
 
   template<class U1, class U2>
   pair(const pair<U1, U2> &rhs) : first(rhs.first), second(rhs.second) {}
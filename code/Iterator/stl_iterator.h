@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Utils/type_traits.h"
 #include <cstddef>//ptrdiff_t定义
 #include <iostream>
 
@@ -95,6 +96,24 @@ using pointer_t = typename iterator_traits<Iterator>::pointer;
 template<class Iterator>
 using reference_t = typename iterator_traits<Iterator>::reference;
 
+// segmented_iterator_traits
+// 分段迭代器：所指序列由若干段连续内存组成（如 deque 的各个缓冲区）
+// 算法可借此逐段处理，段内以原始指针运算（得以使用 memmove 等快速路径），
+// 仅在段与段的边界处做一次修正。
+// 分段迭代器需特化本模板，并提供：
+//   segment_iterator / local_iterator
+//   segment(it) / local(it)：所在段及段内位置
+//   begin(seg) / end(seg)：段的首尾
+//   compose(seg, local)：由段与段内位置重新组合出迭代器
+template<class Iterator>
+struct segmented_iterator_traits {
+  using is_segmented_iterator = false_type;
+};
+
+template<class Iterator>
+using is_segmented_iterator_t =
+    typename segmented_iterator_traits<Iterator>::is_segmented_iterator;
+
 //以下为整组distance函数
 template<class InputIterator>
 inline difference_type_t<InputIterator> _distance(InputIterator first,
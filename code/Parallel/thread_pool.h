@@ -0,0 +1,330 @@
+/*
+    固定大小的工作窃取线程池
+    每个工作线程拥有一个 work_stealing_deque：
+        自己派生的任务压入自己队列的 bottom 端，并优先从 bottom 端取回（LIFO）；
+        自己的队列为空时，先取外部提交队列，再随机挑选受害者从其 top 端窃取。
+    非工作线程提交的任务进入一个 mpmc_queue（injection 队列）。
+
+    task_group 提供 spawn / sync：
+        spawn 派生任务，sync 等待该组内全部任务完成；
+        等待期间当前线程不会阻塞，而是参与执行任务（help-first），因此嵌套并行不会死锁；
+        组内任务抛出的第一个异常在 sync 时重新抛出。
+    parallel_for 对区间做二分派生，直到区间不大于 grain，
+    parallel_invoke 并行执行两个函数对象。
+
+    任务与队列内存取自 _malloc_alloc：_default_alloc 的内存池并非线程安全。
+*/
+#pragma once
+
+#include "Allocator/alloc.h"
+#include "Parallel/work_stealing_deque.h"
+#include "SequenceContainers/MpmcQueue/stl_mpmc_queue.h"
+#include "Utils/type_traits.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace TinySTL {
+
+class thread_pool;
+class task_group;
+
+// 类型擦除的任务：run 负责执行、析构并释放自身，最后通知所属的 task_group
+struct _pool_task {
+  void (*run)(_pool_task *);
+  task_group *group;
+};
+
+template<class F>
+struct _pool_task_impl : _pool_task {
+  F f;
+
+  template<class Fn>
+  explicit _pool_task_impl(Fn &&fn) : f(TinySTL::forward<Fn>(fn)) {}
+};
+
+// 当前线程所属的线程池及其工作线程编号，外部线程的 pool 为 nullptr
+struct _pool_context {
+  thread_pool *pool = nullptr;
+  size_t index = 0;
+  uint64_t seed = 0;
+};
+
+inline _pool_context &_current_pool_context() {
+  static thread_local _pool_context ctx;
+  return ctx;
+}
+
+// xorshift64：挑选窃取的受害者
+inline uint64_t _pool_next_random(uint64_t &seed) {
+  if (seed == 0) seed = reinterpret_cast<uintptr_t>(&seed) | 1;
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+class task_group {
+  friend class thread_pool;
+
+ private:// data member
+  thread_pool &pool;
+  std::atomic<size_t> pending;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+ private:// aux interface
+  template<class F>
+  static void run_task(_pool_task *base);
+  void capture(std::exception_ptr e) {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    if (!error) error = e;
+  }
+  // 执行任务直至组内任务全部完成，不抛出异常
+  void wait() noexcept;
+
+ public:// ctor && dtor
+  explicit task_group(thread_pool &p) : pool(p), pending(0) {}
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+  // 任务可能引用栈上的数据，析构前必须等待其完成
+  ~task_group() { wait(); }
+
+ public:// interface
+  template<class F>
+  void spawn(F &&f);
+  void sync();
+};
+
+class thread_pool {
+  friend class task_group;
+
+ public:
+  using size_type = size_t;
+
+ private:
+  using alloc = _malloc_alloc;
+  static constexpr size_type npos = static_cast<size_type>(-1);
+  static constexpr int spin_limit = 64;// 睡眠前的空转次数
+
+  struct worker {
+    work_stealing_deque<_pool_task *> tasks;
+    std::thread thread;
+  };
+
+ private:// data member
+  worker *workers;
+  size_type nworkers;
+  mpmc_queue<_pool_task *> injection;
+  std::atomic<bool> stop;
+  std::atomic<size_type> sleepers;
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_cv;
+
+ private:// aux interface
+  static size_type default_concurrency() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+  }
+
+  // 当前线程若是本池的工作线程则返回其编号，否则返回 npos
+  size_type self_index() const {
+    const _pool_context &ctx = _current_pool_context();
+    return ctx.pool == this ? ctx.index : npos;
+  }
+
+  void submit(_pool_task *t) {
+    size_type self = self_index();
+    if (self != npos) workers[self].tasks.push(t);
+    else injection.push(t);
+    notify();
+  }
+
+  // 与 worker_loop 中 sleepers 自增后的 fence 配对：
+  // 要么此处看到睡眠者并唤醒，要么睡眠者在等待前看到新任务
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      sleep_cv.notify_one();
+    }
+  }
+
+  bool has_work() const {
+    if (!injection.empty()) return true;
+    for (size_type i = 0; i < nworkers; ++i)
+      if (!workers[i].tasks.empty()) return true;
+    return false;
+  }
+
+  // 依次尝试：自己的队列、外部提交队列、随机起点轮询窃取
+  bool find_task(_pool_task *&t, size_type self, uint64_t &seed) {
+    if (self != npos && workers[self].tasks.pop(t)) return true;
+    if (injection.try_pop(t)) return true;
+    size_type start = static_cast<size_type>(_pool_next_random(seed) % nworkers);
+    for (size_type i = 0; i < nworkers; ++i) {
+      size_type victim = start + i < nworkers ? start + i : start + i - nworkers;
+      if (victim != self && workers[victim].tasks.steal(t)) return true;
+    }
+    return false;
+  }
+
+  void worker_loop(size_type index) {
+    _pool_context &ctx = _current_pool_context();
+    ctx.pool = this;
+    ctx.index = index;
+    ctx.seed = (static_cast<uint64_t>(index) + 1) * 0x9E3779B97F4A7C15ull;
+    int idle = 0;
+    _pool_task *t;
+    while (true) {
+      if (find_task(t, index, ctx.seed)) {
+        t->run(t);
+        idle = 0;
+        continue;
+      }
+      if (++idle < spin_limit) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      sleepers.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      sleep_cv.wait(lock, [this] { return stop.load(std::memory_order_relaxed) || has_work(); });
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      if (stop.load(std::memory_order_relaxed) && !has_work()) return;
+      idle = 0;
+    }
+  }
+
+  void shutdown() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stop.store(true, std::memory_order_relaxed);
+    }
+    sleep_cv.notify_all();
+    for (size_type i = 0; i < nworkers; ++i)
+      if (workers[i].thread.joinable()) workers[i].thread.join();
+  }
+
+  template<class Index, class F>
+  static void parallel_for_split(task_group &g, Index first, Index last, const F &f, Index grain) {
+    // 每次派生后半段，自己继续处理前半段
+    while (last - first > grain) {
+      Index mid = first + (last - first) / 2;
+      g.spawn([&g, mid, last, &f, grain] { parallel_for_split(g, mid, last, f, grain); });
+      last = mid;
+    }
+    for (; first != last; ++first) f(first);
+  }
+
+ public:// ctor && dtor
+  explicit thread_pool(size_type n = default_concurrency())
+      : nworkers(n == 0 ? 1 : n), injection(1024), stop(false), sleepers(0) {
+    workers = new worker[nworkers];
+    size_type i = 0;
+    try {
+      for (; i < nworkers; ++i)
+        workers[i].thread = std::thread(&thread_pool::worker_loop, this, i);
+    } catch (std::exception &) {
+      shutdown();
+      delete[] workers;
+      throw;
+    }
+  }
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  ~thread_pool() {
+    shutdown();
+    delete[] workers;
+  }
+
+ public:// getter
+  size_type size() const noexcept { return nworkers; }
+
+ public:// interface
+  // 对 [first, last) 中的每个下标调用 f(i)；grain 为 0 时按线程数自动选取
+  template<class Index, class F>
+  void parallel_for(Index first, Index last, const F &f, Index grain = Index(0)) {
+    if (!(first < last)) return;
+    if (grain == Index(0)) {
+      grain = static_cast<Index>((last - first) / static_cast<Index>(nworkers * 8));
+      if (grain == Index(0)) grain = Index(1);
+    }
+    task_group g(*this);
+    parallel_for_split(g, first, last, f, grain);
+    g.sync();
+  }
+
+  template<class F1, class F2>
+  void parallel_invoke(F1 &&f1, F2 &&f2) {
+    task_group g(*this);
+    g.spawn(TinySTL::forward<F2>(f2));
+    TinySTL::forward<F1>(f1)();
+    g.sync();
+  }
+};
+
+template<class F>
+void task_group::run_task(_pool_task *base) {
+  _pool_task_impl<F> *self = static_cast<_pool_task_impl<F> *>(base);
+  task_group *g = self->group;
+  try {
+    self->f();
+  } catch (...) {
+    g->capture(std::current_exception());
+  }
+  self->~_pool_task_impl<F>();
+  thread_pool::alloc::deallocate(self, sizeof(_pool_task_impl<F>));
+  // 计数归零后 sync 可能立即返回并析构 task_group，这必须是对 g 的最后一次访问
+  g->pending.fetch_sub(1, std::memory_order_release);
+}
+
+template<class F>
+void task_group::spawn(F &&f) {
+  using impl = _pool_task_impl<std::decay_t<F>>;
+  void *p = thread_pool::alloc::allocate(sizeof(impl));
+  impl *t;
+  try {
+    t = new (p) impl(TinySTL::forward<F>(f));
+  } catch (std::exception &) {
+    thread_pool::alloc::deallocate(p, sizeof(impl));
+    throw;
+  }
+  t->run = &task_group::run_task<std::decay_t<F>>;
+  t->group = this;
+  pending.fetch_add(1, std::memory_order_relaxed);
+  pool.submit(t);
+}
+
+inline void task_group::wait() noexcept {
+  _pool_context &ctx = _current_pool_context();
+  thread_pool::size_type self = pool.self_index();
+  _pool_task *t;
+  while (pending.load(std::memory_order_acquire) != 0) {
+    if (pool.find_task(t, self, ctx.seed)) t->run(t);
+    else std::this_thread::yield();
+  }
+}
+
+inline void task_group::sync() {
+  wait();
+  if (error) {
+    std::exception_ptr e = error;
+    error = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+// 全局共享的线程池，供并行算法使用
+inline thread_pool &default_thread_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+}// namespace TinySTL
@@ -0,0 +1,147 @@
+/*
+    Chase-Lev 工作窃取双端队列（work-stealing deque）
+    所有者线程在 bottom 端 push/pop（LIFO，缓存友好），
+    其他线程在 top 端 steal（FIFO，窃取最早、通常也最大的任务）。
+    只有所有者会修改 bottom，只有最后一个元素会引起 pop 与 steal 之间的竞争，
+    此时以 top 上的 CAS 裁决。内存序参照 Lê et al., "Correct and Efficient
+    Work-Stealing for Weak Memory Models" (PPoPP'13)。
+
+    元素须为可平凡复制的小对象（通常为任务指针）。
+    扩容时旧数组可能仍被窃取者读取，因此不立即释放，而是挂入 retired 链表，析构时统一释放。
+*/
+#pragma once
+
+#include "Allocator/alloc.h"
+#include "SequenceContainers/SpscQueue/stl_spsc_queue.h"// _cache_line_size
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace TinySTL {
+
+template<class T>
+struct _work_stealing_array {
+  int64_t capacity;// 2 的幂
+  _work_stealing_array *retired;// 被替换下来的旧数组链表
+  std::atomic<T> *slots;
+
+  T get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+  void put(int64_t i, T x) { slots[i & (capacity - 1)].store(x, std::memory_order_relaxed); }
+};
+
+template<class T>
+class work_stealing_deque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "work_stealing_deque only holds trivially copyable values");
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ private:
+  using array = _work_stealing_array<T>;
+  // 窃取者与所有者并发访问，内存取自线程安全的 _malloc_alloc
+  using alloc = _malloc_alloc;
+
+ private:// data member
+  alignas(_cache_line_size) std::atomic<int64_t> top;
+  alignas(_cache_line_size) std::atomic<int64_t> bottom;
+  alignas(_cache_line_size) std::atomic<array *> arr;
+
+ private:// aux interface for array
+  static array *create_array(int64_t capacity, array *retired) {
+    array *a = static_cast<array *>(alloc::allocate(sizeof(array)));
+    a->capacity = capacity;
+    a->retired = retired;
+    a->slots = static_cast<std::atomic<T> *>(alloc::allocate(sizeof(std::atomic<T>) * capacity));
+    for (int64_t i = 0; i < capacity; ++i) new (a->slots + i) std::atomic<T>();
+    return a;
+  }
+  static void destroy_array(array *a) {
+    alloc::deallocate(a->slots, sizeof(std::atomic<T>) * a->capacity);
+    alloc::deallocate(a, sizeof(array));
+  }
+  // 仅所有者调用：容量翻倍并复制 [t, b)
+  array *grow(array *a, int64_t b, int64_t t) {
+    array *bigger = create_array(a->capacity * 2, a);
+    for (int64_t i = t; i < b; ++i) bigger->put(i, a->get(i));
+    arr.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+ public:// ctor && dtor
+  explicit work_stealing_deque(size_type capacity = 256) : top(0), bottom(0) {
+    int64_t cap = 1;
+    while (cap < static_cast<int64_t>(capacity)) cap <<= 1;
+    arr.store(create_array(cap, nullptr), std::memory_order_relaxed);
+  }
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+  ~work_stealing_deque() {
+    for (array *a = arr.load(std::memory_order_relaxed); a;) {
+      array *next = a->retired;
+      destroy_array(a);
+      a = next;
+    }
+  }
+
+ public:// getter
+  // 并发时仅为近似值
+  size_type size() const noexcept {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+ public:// owner
+  void push(T x) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    array *a = arr.load(std::memory_order_relaxed);
+    if (b - t > a->capacity - 1) a = grow(a, b, t);
+    a->put(b, x);
+    // 原文为 release fence + relaxed store；release store 语义相同，且能被 TSan 识别
+    bottom.store(b + 1, std::memory_order_release);
+  }
+
+  // 成功时写入 out 并返回 true
+  bool pop(T &out) {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    array *a = arr.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+    if (t > b) {// 已空
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = a->get(b);
+    if (t == b) {// 最后一个元素，与窃取者竞争
+      bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed);
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+ public:// thief
+  bool steal(T &out) {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) return false;
+    array *a = arr.load(std::memory_order_acquire);
+    T x = a->get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed))
+      return false;// 被其他窃取者或所有者抢先
+    out = x;
+    return true;
+  }
+};
+
+}// namespace TinySTL
@@ -0,0 +1,318 @@
+/*
+    circular_buffer<T>: 容量在构造时固定的环形缓冲区
+    全部元素位于构造时一次配置的连续内存中，之后的 push/pop 不再配置或释放内存，
+    适合保存滑动窗口中最近的 N 个样本。
+        || ... tail 段 ... | 空闲 | head 段 ... ||
+    元素从物理下标 head 开始，逻辑下标 i 对应物理下标 (head + i) % capacity。
+    缓冲区已满时按 Policy 处理新元素：
+        overwrite  覆盖最旧的元素（push_back 覆盖队首，push_front 覆盖队尾）
+        reject     拒绝插入，push 返回 false
+    as_two_spans() 以两段 span 返回逻辑上连续、物理上可能回绕的元素，
+    可直接交给向量化的计算核心。
+*/
+#pragma once
+
+#include "Algorithms/algobase/stl_algobase.h"
+#include "Allocator/allocator.h"
+#include "Allocator/construct.h"
+#include "Function/function_adapter.h"// pair
+#include "Utils/span.h"
+#include <cstddef>
+
+namespace TinySTL {
+
+enum class circular_buffer_policy { overwrite, reject };
+
+template<class T, class Ref, class Ptr>
+struct _circular_buffer_iterator {
+  using iterator = _circular_buffer_iterator<T, T &, T *>;
+  using const_iterator = _circular_buffer_iterator<T, const T &, const T *>;
+  using self = _circular_buffer_iterator;
+
+  using iterator_category = random_access_iterator_tag;
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  // data member
+  T *buf;             // 缓冲区首地址
+  size_type cap;      // 容量
+  size_type head;     // 首元素的物理下标
+  difference_type idx;// 逻辑下标
+
+  // ctor
+  _circular_buffer_iterator() : buf(nullptr), cap(0), head(0), idx(0) {}
+  _circular_buffer_iterator(T *b, size_type c, size_type h, difference_type i)
+      : buf(b), cap(c), head(h), idx(i) {}
+  _circular_buffer_iterator(const iterator &rhs)
+      : buf(rhs.buf), cap(rhs.cap), head(rhs.head), idx(rhs.idx) {}
+
+  // dereference
+  reference operator*() const {
+    size_type p = head + static_cast<size_type>(idx);
+    return buf[p < cap ? p : p - cap];
+  }
+  pointer operator->() const { return &(operator*()); }
+
+  // increment && decrement
+  self &operator++() { ++idx; return *this; }
+  self operator++(int) { self temp = *this; ++idx; return temp; }
+  self &operator--() { --idx; return *this; }
+  self operator--(int) { self temp = *this; --idx; return temp; }
+
+  // random access
+  self &operator+=(difference_type n) { idx += n; return *this; }
+  self &operator-=(difference_type n) { idx -= n; return *this; }
+  self operator+(difference_type n) const { return self(buf, cap, head, idx + n); }
+  self operator-(difference_type n) const { return self(buf, cap, head, idx - n); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+};
+
+// 同一缓冲区的迭代器之间只需比较逻辑下标
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline ptrdiff_t operator-(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                           const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return lhs.idx - rhs.idx;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator==(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                       const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return lhs.idx == rhs.idx;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator!=(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                       const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return lhs.idx != rhs.idx;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator<(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                      const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return lhs.idx < rhs.idx;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator>(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                      const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return rhs < lhs;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator<=(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                       const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return !(rhs < lhs);
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator>=(const _circular_buffer_iterator<T, RefL, PtrL> &lhs,
+                       const _circular_buffer_iterator<T, RefR, PtrR> &rhs) {
+  return !(lhs < rhs);
+}
+
+template<class T, class Ref, class Ptr>
+inline _circular_buffer_iterator<T, Ref, Ptr> operator+(
+    ptrdiff_t n, const _circular_buffer_iterator<T, Ref, Ptr> &x) {
+  return x + n;
+}
+
+template<class T, circular_buffer_policy Policy = circular_buffer_policy::overwrite,
+         class Alloc = simpleAlloc<T>>
+class circular_buffer {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = _circular_buffer_iterator<T, T &, T *>;
+  using const_iterator = _circular_buffer_iterator<T, const T &, const T *>;
+  using reverse_iterator = __reverse_iterator<iterator>;
+  using const_reverse_iterator = __reverse_iterator<const_iterator>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  static constexpr circular_buffer_policy policy = Policy;
+
+ private:// data member
+  pointer buffer;
+  size_type cap;
+  size_type head;// 首元素的物理下标
+  size_type count;
+
+ private:// aux interface
+  using data_allocator = Alloc;
+
+  // 逻辑下标 -> 物理下标，要求 i <= cap
+  size_type physical(size_type i) const noexcept {
+    size_type p = head + i;
+    return p < cap ? p : p - cap;
+  }
+  size_type prev(size_type p) const noexcept { return p == 0 ? cap - 1 : p - 1; }
+  size_type next(size_type p) const noexcept { return p + 1 == cap ? 0 : p + 1; }
+
+  template<class InputIterator>
+  void copy_initialize(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) push_back(*first);
+  }
+
+ public:// ctor && dtor
+  explicit circular_buffer(size_type capacity)
+      : buffer(capacity ? data_allocator::allocate(capacity) : nullptr),
+        cap(capacity), head(0), count(0) {}
+  // 依次 push_back [first, last)，溢出时按 Policy 处理
+  template<class InputIterator>
+  circular_buffer(size_type capacity, InputIterator first, InputIterator last)
+      : circular_buffer(capacity) {
+    // 委托构造已完成，此处抛出异常时析构函数会负责清理
+    copy_initialize(first, last);
+  }
+  circular_buffer(const circular_buffer &rhs) : circular_buffer(rhs.cap) {
+    copy_initialize(rhs.begin(), rhs.end());
+  }
+  circular_buffer(circular_buffer &&rhs) noexcept
+      : buffer(rhs.buffer), cap(rhs.cap), head(rhs.head), count(rhs.count) {
+    rhs.buffer = nullptr;
+    rhs.cap = rhs.head = rhs.count = 0;
+  }
+  circular_buffer &operator=(const circular_buffer &rhs) {
+    // copy-and-swap 技法，保证强异常安全
+    circular_buffer temp(rhs);
+    swap(temp);
+    return *this;
+  }
+  circular_buffer &operator=(circular_buffer &&rhs) noexcept {
+    circular_buffer temp(TinySTL::move(rhs));
+    swap(temp);
+    return *this;
+  }
+  ~circular_buffer() {
+    clear();
+    if (buffer) data_allocator::deallocate(buffer, cap);
+  }
+
+  void swap(circular_buffer &rhs) noexcept {
+    TinySTL::swap(buffer, rhs.buffer);
+    TinySTL::swap(cap, rhs.cap);
+    TinySTL::swap(head, rhs.head);
+    TinySTL::swap(count, rhs.count);
+  }
+
+ public:// getter
+  size_type size() const noexcept { return count; }
+  size_type capacity() const noexcept { return cap; }
+  size_type reserve() const noexcept { return cap - count; }// 剩余空位
+  bool empty() const noexcept { return count == 0; }
+  bool full() const noexcept { return count == cap; }
+
+  const_iterator begin() const noexcept { return const_iterator(buffer, cap, head, 0); }
+  const_iterator end() const noexcept {
+    return const_iterator(buffer, cap, head, static_cast<difference_type>(count));
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+  const_reference operator[](size_type n) const noexcept { return buffer[physical(n)]; }
+  const_reference front() const noexcept { return buffer[head]; }
+  const_reference back() const noexcept { return buffer[physical(count - 1)]; }
+
+  // 第一段为 [head, ...)，第二段为回绕到缓冲区开头的部分（可能为空）
+  pair<span<const T>, span<const T>> as_two_spans() const noexcept {
+    size_type first_len = cap - head < count ? cap - head : count;
+    return pair<span<const T>, span<const T>>(span<const T>(buffer + head, first_len),
+                                              span<const T>(buffer, count - first_len));
+  }
+
+ public:// setter
+  iterator begin() noexcept { return iterator(buffer, cap, head, 0); }
+  iterator end() noexcept {
+    return iterator(buffer, cap, head, static_cast<difference_type>(count));
+  }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  reference operator[](size_type n) noexcept { return buffer[physical(n)]; }
+  reference front() noexcept { return buffer[head]; }
+  reference back() noexcept { return buffer[physical(count - 1)]; }
+
+  pair<span<T>, span<T>> as_two_spans() noexcept {
+    size_type first_len = cap - head < count ? cap - head : count;
+    return pair<span<T>, span<T>>(span<T>(buffer + head, first_len),
+                                  span<T>(buffer, count - first_len));
+  }
+
+ public:// push && pop
+  // 返回是否插入了新元素；overwrite 策略下只要容量不为 0 总是成功
+  template<class... Args>
+  bool emplace_back(Args &&...args) {
+    if (cap == 0) return false;
+    if (count < cap) {
+      TinySTL::construct(buffer + physical(count), TinySTL::forward<Args>(args)...);
+      ++count;
+      return true;
+    }
+    if (Policy == circular_buffer_policy::reject) return false;
+    // 先构造临时对象：参数可能引用即将被覆盖的队首元素
+    value_type temp(TinySTL::forward<Args>(args)...);
+    buffer[head] = TinySTL::move(temp);
+    head = next(head);
+    return true;
+  }
+  template<class... Args>
+  bool emplace_front(Args &&...args) {
+    if (cap == 0) return false;
+    if (count < cap) {
+      size_type p = prev(head);
+      TinySTL::construct(buffer + p, TinySTL::forward<Args>(args)...);
+      head = p;
+      ++count;
+      return true;
+    }
+    if (Policy == circular_buffer_policy::reject) return false;
+    // 已满时队尾元素恰好位于 prev(head)
+    value_type temp(TinySTL::forward<Args>(args)...);
+    size_type p = prev(head);
+    buffer[p] = TinySTL::move(temp);
+    head = p;
+    return true;
+  }
+  bool push_back(const value_type &value) { return emplace_back(value); }
+  bool push_back(value_type &&value) { return emplace_back(TinySTL::move(value)); }
+  bool push_front(const value_type &value) { return emplace_front(value); }
+  bool push_front(value_type &&value) { return emplace_front(TinySTL::move(value)); }
+
+  void pop_front() {
+    TinySTL::destroy(buffer + head);
+    head = next(head);
+    --count;
+  }
+  void pop_back() {
+    TinySTL::destroy(buffer + physical(count - 1));
+    --count;
+  }
+  // 弹出最旧的 n 个元素（n 不超过 size()）
+  // 至多分为两段连续内存，trivially destructible 的元素只需移动 head
+  void pop_front_n(size_type n) {
+    size_type first_len = cap - head < n ? cap - head : n;
+    TinySTL::destroy(buffer + head, buffer + head + first_len);
+    TinySTL::destroy(buffer, buffer + (n - first_len));
+    head = physical(n);
+    count -= n;
+  }
+  void clear() noexcept {
+    pair<span<T>, span<T>> halves = as_two_spans();
+    TinySTL::destroy(halves.first.begin(), halves.first.end());
+    TinySTL::destroy(halves.second.begin(), halves.second.end());
+    head = count = 0;
+  }
+
+ public:// compare operator
+  bool operator==(const circular_buffer &rhs) const {
+    return count == rhs.count && TinySTL::equal(begin(), end(), rhs.begin());
+  }
+  bool operator!=(const circular_buffer &rhs) const { return !(*this == rhs); }
+};
+
+}// namespace TinySTL
@@ -8,15 +8,26 @@ namespace TinySTL {
 // 缓冲区大小设定函数（在预设情况下传回可容纳的元素个数）
 // 若n不为0，则传回n，表示由用户自定
 // 若n为0则采用预设值 预设值根据sz（元素大小）而定
-inline size_t _deque_buf_size(size_t sz) {
-    return sz < 512 ? 512 / sz : size_t(1);
+// 结果向下取整为 2 的幂，使 operator+= 中的除法与取模退化为移位与掩码
+constexpr size_t _deque_buf_size(size_t n, size_t sz) {
+    size_t count = n != 0 ? n : (sz < 512 ? 512 / sz : size_t(1));
+    size_t result = 1;
+    while (result <= count / 2) result <<= 1;
+    return result;
 }
 
-template<class T, class Ref, class Ptr>
+// 缓冲区大小的以 2 为底的对数
+constexpr size_t _deque_buf_shift(size_t n, size_t sz) {
+    size_t shift = 0;
+    while ((size_t(1) << shift) < _deque_buf_size(n, sz)) ++shift;
+    return shift;
+}
+
+template<class T, class Ref, class Ptr, size_t BufSiz = 0>
 class _deque_iterator {
 public:
-    using iterator = _deque_iterator<T, T &, T *>;
-    using const_iterator = _deque_iterator<T, const T &, const T *>;
+    using iterator = _deque_iterator<T, T &, T *, BufSiz>;
+    using const_iterator = _deque_iterator<T, const T &, const T *, BufSiz>;
     using self = _deque_iterator;
 
     using iterator_category = random_access_iterator_tag;
@@ -33,7 +44,12 @@ public:
     value_type *last; // 当前 buffer 尾后
     map_pointer node; // 当前 buffer 对应的 map 的节点
 
-    static size_t buffer_size() { return _deque_buf_size(sizeof(value_type)); }
+    static constexpr size_t buffer_size() {
+        return _deque_buf_size(BufSiz, sizeof(value_type));
+    }
+    static constexpr size_t buffer_shift() {
+        return _deque_buf_shift(BufSiz, sizeof(value_type));
+    }
 
     // ctor
     _deque_iterator()
@@ -90,124 +106,150 @@ public:
         if (offset >= 0 && offset < static_cast<difference_type>(buffer_size())) {
             cur += n;
         } else {
-            difference_type node_offset = 
-                offset > 0
-                ? offset / static_cast<difference_type>(buffer_size()) // 要偏移的node数量
-                : -static_cast<difference_type>((-offset - 1) / buffer_size()) - 1;
+            // buffer_size 为 2 的幂：算术右移即向下取整的除法（对负数同样成立），
+            // 与掩码即非负的取模
+            difference_type node_offset = offset >> buffer_shift();
             set_node(node + node_offset);
-            cur = first + (offset - node_offset * static_cast<difference_type>(buffer_size()));
+            cur = first + (offset & static_cast<difference_type>(buffer_size() - 1));
         }
         return *this;
     }
 
-    self operator+(difference_type n) {
+    self operator+(difference_type n) const {
         self temp = *this;
         return temp += n;
     }
 
     self &operator-=(difference_type n) { return *this += -n; }
 
-    self operator-(difference_type n) {
+    self operator-(difference_type n) const {
         self temp = *this;
         return temp -= n;
     }
 
-    reference operator[](difference_type n) { return *(*this + n); }
+    reference operator[](difference_type n) const { return *(*this + n); }
 };
 
-template<class T, class Ref, class Ptr>
-inline bool operator==(const _deque_iterator<T, Ref, Ptr> &lhs,
-                       const _deque_iterator<T, Ref, Ptr> &rhs) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline bool operator==(const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+                       const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
   return lhs.cur == rhs.cur;
 }
 
 // compare with const
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline bool operator==(const _deque_iterator<T, RefL, PtrL> &lhs,
-                       const _deque_iterator<T, RefR, PtrR> &rhs) {
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline bool operator==(const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+                       const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
   return lhs.cur == rhs.cur;
 }
 
-template<class T, class Ref, class Ptr>
-inline bool operator!=(const _deque_iterator<T, Ref, Ptr> &lhs,
-                       const _deque_iterator<T, Ref, Ptr> &rhs) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline bool operator!=(const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+                       const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
   return !(lhs == rhs);
 }
 
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline bool operator!=(const _deque_iterator<T, RefL, PtrL> &lhs,
-                       const _deque_iterator<T, RefR, PtrR> &rhs) {
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline bool operator!=(const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+                       const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
   return !(lhs == rhs);
 }
 
-template<class T, class Ref, class Ptr>
-inline bool operator<(const _deque_iterator<T, Ref, Ptr> &lhs,
-                      const _deque_iterator<T, Ref, Ptr> &rhs) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline bool operator<(const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+                      const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
   return (lhs.node == rhs.node) ? (lhs.cur < rhs.cur) : (lhs.node < rhs.node);
 }
 
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline bool operator<(const _deque_iterator<T, RefL, PtrL> &lhs,
-                      const _deque_iterator<T, RefR, PtrR> &rhs) {
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline bool operator<(const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+                      const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
   return (lhs.node == rhs.node) ? (lhs.cur < rhs.cur) : (lhs.node < rhs.node);
 }
 
-template<class T, class Ref, class Ptr>
-inline bool operator>(const _deque_iterator<T, Ref, Ptr> &lhs,
-                      const _deque_iterator<T, Ref, Ptr> &rhs) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline bool operator>(const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+                      const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
   return rhs < lhs;
 }
 
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline bool operator>(const _deque_iterator<T, RefL, PtrL> &lhs,
-                      const _deque_iterator<T, RefR, PtrR> &rhs) {
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline bool operator>(const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+                      const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
   return rhs < lhs;
 }
 
-template<class T, class Ref, class Ptr>
-inline bool operator<=(const _deque_iterator<T, Ref, Ptr> &lhs,
-                       const _deque_iterator<T, Ref, Ptr> &rhs) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline bool operator<=(const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+                       const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
   return !(rhs < lhs);
 }
 
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline bool operator<=(const _deque_iterator<T, RefL, PtrL> &lhs,
-                       const _deque_iterator<T, RefR, PtrR> &rhs) {
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline bool operator<=(const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+                       const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
   return !(rhs < lhs);
 }
 
-template<class T, class Ref, class Ptr>
-inline bool operator>=(const _deque_iterator<T, Ref, Ptr> &lhs,
-                       const _deque_iterator<T, Ref, Ptr> &rhs) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline bool operator>=(const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+                       const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
   return !(lhs < rhs);
 }
 
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline bool operator>=(const _deque_iterator<T, RefL, PtrL> &lhs,
-                       const _deque_iterator<T, RefR, PtrR> &rhs) {
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline bool operator>=(const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+                       const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
   return !(lhs < rhs);
 }
 
-template<class T, class Ref, class Ptr>
-inline typename _deque_iterator<T, Ref, Ptr>::difference_type operator-(
-    const _deque_iterator<T, Ref, Ptr> &lhs,
-    const _deque_iterator<T, Ref, Ptr> &rhs) {
-  return typename _deque_iterator<T, Ref, Ptr>::difference_type(
-      _deque_iterator<T, Ref, Ptr>::buffer_size() * (lhs.node - rhs.node - 1) + (lhs.cur - lhs.first) + (rhs.last - rhs.cur));
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline typename _deque_iterator<T, Ref, Ptr, BufSiz>::difference_type operator-(
+    const _deque_iterator<T, Ref, Ptr, BufSiz> &lhs,
+    const _deque_iterator<T, Ref, Ptr, BufSiz> &rhs) {
+  return typename _deque_iterator<T, Ref, Ptr, BufSiz>::difference_type(
+      _deque_iterator<T, Ref, Ptr, BufSiz>::buffer_size() * (lhs.node - rhs.node - 1) + (lhs.cur - lhs.first) + (rhs.last - rhs.cur));
 }
 
-template<class T, class RefL, class PtrL, class RefR, class PtrR>
-inline typename _deque_iterator<T, RefL, PtrL>::difference_type operator-(
-    const _deque_iterator<T, RefL, PtrL> &lhs,
-    const _deque_iterator<T, RefR, PtrR> &rhs) {
-  return typename _deque_iterator<T, RefL, PtrL>::difference_type(
-      _deque_iterator<T, RefL, PtrL>::buffer_size() * (lhs.node - rhs.node - 1) + (lhs.cur - lhs.first) + (rhs.last - rhs.cur));
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t BufSiz>
+inline typename _deque_iterator<T, RefL, PtrL, BufSiz>::difference_type operator-(
+    const _deque_iterator<T, RefL, PtrL, BufSiz> &lhs,
+    const _deque_iterator<T, RefR, PtrR, BufSiz> &rhs) {
+  return typename _deque_iterator<T, RefL, PtrL, BufSiz>::difference_type(
+      _deque_iterator<T, RefL, PtrL, BufSiz>::buffer_size() * (lhs.node - rhs.node - 1) + (lhs.cur - lhs.first) + (rhs.last - rhs.cur));
 }
 
-template<class T, class Ref, class Ptr>
-inline _deque_iterator<T, Ref, Ptr> operator+(
-    ptrdiff_t n, const _deque_iterator<T, Ref, Ptr> &x) {
+template<class T, class Ref, class Ptr, size_t BufSiz>
+inline _deque_iterator<T, Ref, Ptr, BufSiz> operator+(
+    ptrdiff_t n, const _deque_iterator<T, Ref, Ptr, BufSiz> &x) {
   return x + n;
 }
 
+// deque 迭代器是典型的分段迭代器：每个缓冲区即为一段
+template<class T, class Ref, class Ptr, size_t BufSiz>
+struct segmented_iterator_traits<_deque_iterator<T, Ref, Ptr, BufSiz>> {
+  using is_segmented_iterator = true_type;
+  using iterator = _deque_iterator<T, Ref, Ptr, BufSiz>;
+  using segment_iterator = T **;
+  using local_iterator = Ptr;
+
+  static segment_iterator segment(const iterator &it) { return it.node; }
+  static local_iterator local(const iterator &it) { return it.cur; }
+  static local_iterator begin(segment_iterator seg) { return *seg; }
+  static local_iterator end(segment_iterator seg) {
+    return *seg + iterator::buffer_size();
+  }
+  static iterator compose(segment_iterator seg, local_iterator local) {
+    iterator result;
+    if (local == end(seg)) {// 与 operator++ 一致：段尾规整到下一段段首
+      result.set_node(seg + 1);
+      result.cur = result.first;
+    } else {
+      result.set_node(seg);
+      result.cur = const_cast<T *>(local);
+    }
+    return result;
+  }
+};
+
 }
\ No newline at end of file
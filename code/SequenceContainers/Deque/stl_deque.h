@@ -7,7 +7,9 @@
 
 namespace TinySTL {
 
-template <class T, class Alloc = simpleAlloc<T>>
+// BufSiz 为每个缓冲区容纳的元素个数，0 表示采用预设值
+// 实际大小会向下取整为 2 的幂（见 _deque_buf_size）
+template <class T, class Alloc = simpleAlloc<T>, size_t BufSiz = 0>
 class deque {
 public:
     using value_type = T;
@@ -16,9 +18,9 @@ public:
     using const_reference = const T &;
     using size_type = size_t;
     using difference_type = ptrdiff_t;
-    using iterator = _deque_iterator<T, T &, T *>;
+    using iterator = _deque_iterator<T, T &, T *, BufSiz>;
     using reverse_iterator = TinySTL::__reverse_iterator<iterator>;
-    using const_iterator = _deque_iterator<T, const T &, const T *>;
+    using const_iterator = _deque_iterator<T, const T &, const T *, BufSiz>;
     using const_reverse_iterator = TinySTL::__reverse_iterator<const_iterator>;
 
 private:// internal alias declarations
@@ -34,10 +36,10 @@ private://data member
 
 private: // aux_interface for node
     value_type *allocate_node() {
-        return node_allocator::allocate(_deque_buf_size(sizeof(value_type)));
+        return node_allocator::allocate(buffer_size());
     }
     void deallocate_node(value_type *p) {
-        node_allocator::deallocate(p, _deque_buf_size(sizeof(value_type)));
+        node_allocator::deallocate(p, buffer_size());
     }
     void create_nodes(map_pointer, map_pointer);
     void destroy_nodes(map_pointer, map_pointer);
@@ -48,6 +50,8 @@ private: // aux_interface for map
         map_allocator::deallocate(p, n);
     }
     void reallocate_map(size_type, bool);
+    void shrink_map(size_type);
+    void compact_map(size_type nodes_to_add = 0) noexcept;
     void reserve_map_at_front(size_type nodes_to_add = 1); // 在头部分配map
     void reserve_map_at_back(size_type nodes_to_add = 1);
     iterator reserve_elements_at_front(size_type); // 在头部分配元素
@@ -57,7 +61,7 @@ private: // aux_interface for map
 
 private: // aux_interface for ctor
     size_type initial_map_size() const noexcept { return 8U; }
-    size_type buffer_size() const noexcept { return iterator:: buffer_size(); }
+    static constexpr size_type buffer_size() noexcept { return iterator::buffer_size(); }
     void fill_initialize(const value_type &);
 
     template<class Integer>
@@ -126,6 +130,8 @@ public: // getter
     const_reference back() const noexcept { return *(finish - 1); }
     size_type size() const noexcept { return finish - start; }
     bool empty() const noexcept { return finish == start; }
+    // map 中可容纳的缓冲区指针个数
+    size_type map_capacity() const noexcept { return map_size; }
 
 public: // setter
     iterator begin() noexcept { return start; }
@@ -137,17 +143,54 @@ public: // setter
     reference back() noexcept { return *(finish - 1); }
 
 private: // aux_interface for push && pop
-    void push_back_aux(const value_type &);
-    void push_front_aux(const value_type &);
+    template<class... Args>
+    void push_back_aux(Args &&...);
+    template<class... Args>
+    void push_front_aux(Args &&...);
     void pop_back_aux();
     void pop_front_aux();
 
+public:// emplace
+    template<class... Args>
+    void emplace_back(Args &&...);
+    template<class... Args>
+    void emplace_front(Args &&...);
+    template<class... Args>
+    iterator emplace(iterator, Args &&...);
+
 public:// push && pop
-    void push_back(const value_type &);
-    void push_front(const value_type &);
+    void push_back(const value_type &value) { emplace_back(value); }
+    void push_back(value_type &&value) { emplace_back(TinySTL::move(value)); }
+    void push_front(const value_type &value) { emplace_front(value); }
+    void push_front(value_type &&value) { emplace_front(TinySTL::move(value)); }
     void pop_back();
     void pop_front();
 
+private:// aux_interface for bulk push && pop
+    template<class InputIterator>
+    void append_aux(InputIterator, InputIterator, input_iterator_tag);
+    template<class ForwardIterator>
+    void append_aux(ForwardIterator, ForwardIterator, forward_iterator_tag);
+    template<class InputIterator>
+    void prepend_aux(InputIterator, InputIterator, input_iterator_tag);
+    template<class ForwardIterator>
+    void prepend_aux(ForwardIterator, ForwardIterator, forward_iterator_tag);
+
+public:// bulk push && pop
+    // 一次性预留 map 与缓冲区，再按缓冲区整段复制
+    template<class InputIterator>
+    void append(InputIterator first, InputIterator last) {
+        append_aux(first, last, iterator_category_t<InputIterator>());
+    }
+    // [first, last) 整体置于头部，保持原有顺序
+    template<class InputIterator>
+    void prepend(InputIterator first, InputIterator last) {
+        prepend_aux(first, last, iterator_category_t<InputIterator>());
+    }
+    // 逐段析构并整块释放缓冲区，要求 n <= size()
+    void pop_front_n(size_type);
+    void pop_back_n(size_type);
+
 private:// interface_aux for insert
     void fill_insert(iterator, size_type, const value_type &);
     template<class Integer>
@@ -167,14 +210,20 @@ private:// interface_aux for insert
     template<class ForwardIterator>
     void range_insert_aux(iterator, ForwardIterator, ForwardIterator,
                             forward_iterator_tag);
-    iterator insert_aux(iterator, const value_type &);
+    template<class... Args>
+    iterator emplace_aux(iterator, Args &&...);
     void insert_aux(iterator, size_type, const value_type &);
     template<class ForwardIterator>
     void insert_aux(iterator, ForwardIterator, ForwardIterator, size_type);
 
 public: //insert
-    iterator insert(iterator, const value_type &);
-    iterator insert(iterator pos) { return insert(pos, value_type()); }
+    iterator insert(iterator pos, const value_type &value) {
+        return emplace(pos, value);
+    }
+    iterator insert(iterator pos, value_type &&value) {
+        return emplace(pos, TinySTL::move(value));
+    }
+    iterator insert(iterator pos) { return emplace(pos); }
     void insert(iterator pos, size_type n, const value_type &val) {
         fill_insert(pos, n, val);
     }
@@ -191,14 +240,16 @@ public: // erase
 public: // resize
     void resize(size_type, const value_type &);
     void resize(size_type new_size) { resize(new_size, value_type()); }
+    // map 收缩至恰好容纳现有缓冲区（两端各留一个空位），并将其居中
+    void shrink_to_fit();
 
 public: //swap
     void swap(deque &rhs) noexcept;
 
 };
 
-template <class T, class Alloc>
-void deque<T, Alloc>::create_nodes(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::create_nodes(map_pointer nstart, map_pointer nfinish) {
     map_pointer cur;
     try {
         for (cur = nstart; cur <= nfinish; ++ cur) *cur = allocate_node();
@@ -207,13 +258,13 @@ void deque<T, Alloc>::create_nodes(map_pointer nstart, map_pointer nfinish) {
         throw;
     }
 }
-template <class T, class Alloc>
-void deque<T, Alloc>::destroy_nodes(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::destroy_nodes(map_pointer nstart, map_pointer nfinish) {
     for (map_pointer n = nstart; n < nfinish; ++ n) deallocate_node(*n);
 }
 
-template <class T, class Alloc>
-void deque<T, Alloc>::initialize_map(size_type n) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::initialize_map(size_type n) {
     size_type num_nodes = n / buffer_size() + 1; // 所需节点数（整除则多配置一个）
     // 一个map至少管理8个节点，至多管理 num_nodes + 2 个
     map_size = TinySTL::max(initial_map_size(), num_nodes + 2);
@@ -238,8 +289,8 @@ void deque<T, Alloc>::initialize_map(size_type n) {
         finish.first + n % buffer_size(); // 整除则多配置一个
 }
 
-template <class T, class Alloc>
-void deque<T, Alloc>::reallocate_map(size_type nodes_to_add, 
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::reallocate_map(size_type nodes_to_add, 
                                     bool add_at_front) {
     size_type old_nodes_num = finish.node - start.node + 1;
     size_type new_nodes_num = old_nodes_num + nodes_to_add;
@@ -274,38 +325,74 @@ void deque<T, Alloc>::reallocate_map(size_type nodes_to_add,
     finish.set_node(new_nstart + old_nodes_num - 1);
 }
 
-template <class T, class Alloc>
-void deque<T, Alloc>::reserve_map_at_front(size_type nodes_to_add) {
+// 配置大小为 new_map_size 的新 map，把现有节点居中复制过去
+// 缓冲区本身不动，迭代器的 cur 依然有效
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::shrink_map(size_type new_map_size) {
+    size_type nodes_num = finish.node - start.node + 1;
+    map_pointer new_map = map_allocator::allocate(new_map_size);
+    map_pointer new_nstart = new_map + (new_map_size - nodes_num) / 2;
+    TinySTL::copy(start.node, finish.node + 1, new_nstart);
+    deallocate_map(map, map_size);
+    map = new_map;
+    map_size = new_map_size;
+    start.set_node(new_nstart);
+    finish.set_node(new_nstart + nodes_num - 1);
+}
+
+// 收缩策略：若 map 已超过所需节点数（含即将添加的 nodes_to_add 个）的 8 倍，则收缩为 4 倍。
+// reallocate_map 在用满一半时扩容一倍，二者之间留有 2 倍的滞后区间。
+// 重新配置 map 会使迭代器失效，故 pop/erase 不调用，只在 map 一端用尽（见 reserve_map_at_*）
+// 与 clear 时收缩；收缩只是优化，配置失败时保持原 map 不变
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::compact_map(size_type nodes_to_add) noexcept {
+    size_type nodes_num = finish.node - start.node + 1 + nodes_to_add;
+    if (map_size <= initial_map_size() || map_size < nodes_num * 8) return;
+    try {
+        shrink_map(TinySTL::max(initial_map_size(), nodes_num * 4));
+    } catch (std::exception &) {
+    }
+}
+
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::reserve_map_at_front(size_type nodes_to_add) {
     // start.node - map -> 前端剩余 node 个数
-    if (nodes_to_add > static_cast<size_type>(start.node - map))
-        reallocate_map(nodes_to_add, true);
+    if (nodes_to_add > static_cast<size_type>(start.node - map)) {
+        // 反正要重整 map：先按工作集收缩，收缩后的 map 两端均留有空位
+        compact_map(nodes_to_add);
+        if (nodes_to_add > static_cast<size_type>(start.node - map))
+            reallocate_map(nodes_to_add, true);
+    }
 }
 
-template <class T, class Alloc>
-void deque<T, Alloc>::reserve_map_at_back(size_type nodes_to_add) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::reserve_map_at_back(size_type nodes_to_add) {
     // map_size-(finish.node-map+1) -> 后端剩余 node 个数
-    if (nodes_to_add + 1 > map_size - (finish.node - map))
-        reallocate_map(nodes_to_add, false);
+    if (nodes_to_add + 1 > map_size - (finish.node - map)) {
+        compact_map(nodes_to_add);
+        if (nodes_to_add + 1 > map_size - (finish.node - map))
+            reallocate_map(nodes_to_add, false);
+    }
 }
 
-template<class T, class Alloc>
-inline typename deque<T, Alloc>::iterator
-deque<T, Alloc>::reserve_elements_at_front(size_type n) {
+template<class T, class Alloc, size_t BufSiz>
+inline typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::reserve_elements_at_front(size_type n) {
   size_type vacancies = start.cur - start.first;
   if (n > vacancies) new_elements_at_front(n - vacancies);
   return start - static_cast<difference_type>(n);
 }
 
-template<class T, class Alloc>
-inline typename deque<T, Alloc>::iterator
-deque<T, Alloc>::reserve_elements_at_back(size_type n) {
+template<class T, class Alloc, size_t BufSiz>
+inline typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::reserve_elements_at_back(size_type n) {
   size_type vacancies = finish.last - finish.cur - 1;
   if (n > vacancies) new_elements_at_back(n - vacancies);
   return finish + static_cast<difference_type>(n);
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::new_elements_at_front(size_type new_elems) {
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::new_elements_at_front(size_type new_elems) {
   size_type new_nodes = (new_elems + buffer_size() - 1) / buffer_size();
   reserve_map_at_front(new_nodes);
   size_type i;
@@ -317,8 +404,8 @@ void deque<T, Alloc>::new_elements_at_front(size_type new_elems) {
   }
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::new_elements_at_back(size_type new_elems) {
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::new_elements_at_back(size_type new_elems) {
   size_type new_nodes = (new_elems + buffer_size() - 1) / buffer_size();
   reserve_map_at_back(new_nodes);
   size_type i;
@@ -330,8 +417,8 @@ void deque<T, Alloc>::new_elements_at_back(size_type new_elems) {
   }
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::fill_initialize(const value_type &val) {
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::fill_initialize(const value_type &val) {
     map_pointer cur;
     try {
         // 为每个缓冲区设定初值
@@ -345,9 +432,9 @@ void deque<T, Alloc>::fill_initialize(const value_type &val) {
     }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, size_t BufSiz>
 template<class InputIterator>
-void deque<T, Alloc>::range_initialize(InputIterator first, InputIterator last,
+void deque<T, Alloc, BufSiz>::range_initialize(InputIterator first, InputIterator last,
                                        input_iterator_tag) {
   initialize_map(0);
   try {
@@ -358,9 +445,9 @@ void deque<T, Alloc>::range_initialize(InputIterator first, InputIterator last,
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, size_t BufSiz>
 template<class ForwardIterator>
-void deque<T, Alloc>::range_initialize(ForwardIterator first,
+void deque<T, Alloc, BufSiz>::range_initialize(ForwardIterator first,
                                        ForwardIterator last,
                                        forward_iterator_tag) {
   size_type n = TinySTL::distance(first, last);
@@ -381,8 +468,8 @@ void deque<T, Alloc>::range_initialize(ForwardIterator first,
   }
 }
 
-template<class T, class Alloc>
-inline deque<T, Alloc>::~deque() {
+template<class T, class Alloc, size_t BufSiz>
+inline deque<T, Alloc, BufSiz>::~deque() {
     TinySTL::destroy(start, finish);
     if (map) {
         destroy_nodes(start.node,
@@ -391,8 +478,8 @@ inline deque<T, Alloc>::~deque() {
     }
 }
 
-template<class T, class Alloc>
-inline deque<T, Alloc> &deque<T, Alloc>::operator=(const deque &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline deque<T, Alloc, BufSiz> &deque<T, Alloc, BufSiz>::operator=(const deque &rhs) {
   const size_type len = size();
   if (&rhs != this) {
     if (len >= rhs.size())
@@ -407,28 +494,29 @@ inline deque<T, Alloc> &deque<T, Alloc>::operator=(const deque &rhs) {
   return *this;
 }
 
-template<class T, class Alloc>
-inline deque<T, Alloc>::deque(deque &&rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline deque<T, Alloc, BufSiz>::deque(deque &&rhs) {
   initialize_map(0);
   if (rhs.map) {
     swap(rhs);
   }
 }
 
-template<class T, class Alloc>
-deque<T, Alloc> &deque<T, Alloc>::operator=(deque &&rhs) noexcept {
+template<class T, class Alloc, size_t BufSiz>
+deque<T, Alloc, BufSiz> &deque<T, Alloc, BufSiz>::operator=(deque &&rhs) noexcept {
   clear();
   swap(rhs);
   return *this;
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::push_back_aux(const value_type &value) {
-  value_type value_copy = value;
+// 缓冲区之间不搬移元素，args 即便引用容器内的元素也依然有效
+template<class T, class Alloc, size_t BufSiz>
+template<class... Args>
+void deque<T, Alloc, BufSiz>::push_back_aux(Args &&...args) {
   reserve_map_at_back();               // 若符合条件则重新更换map
   *(finish.node + 1) = allocate_node();// 配置新节点
   try {
-    construct(finish.cur, value_copy);
+    construct(finish.cur, TinySTL::forward<Args>(args)...);
     finish.set_node(finish.node + 1);
     finish.cur = finish.first;// 更新finish.cur为当前first
   } catch (std::exception &) {
@@ -437,15 +525,15 @@ inline void deque<T, Alloc>::push_back_aux(const value_type &value) {
   }
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::push_front_aux(const value_type &value) {
-    value_type value_copy = value;
+template<class T, class Alloc, size_t BufSiz>
+template<class... Args>
+void deque<T, Alloc, BufSiz>::push_front_aux(Args &&...args) {
     reserve_map_at_front();             // 若符合条件则重新更换map
     *(start.node - 1) = allocate_node();// 配置新节点
     try {
         start.set_node(start.node - 1);
         start.cur = start.last - 1;
-        construct(start.cur, value);
+        construct(start.cur, TinySTL::forward<Args>(args)...);
     } catch (std::exception &) {
         ++start;
         deallocate_node(*(start.node - 1));
@@ -453,43 +541,60 @@ inline void deque<T, Alloc>::push_front_aux(const value_type &value) {
     }
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::pop_back_aux() {
-    node_allocator::deallocate(finish.first);
+template<class T, class Alloc, size_t BufSiz>
+inline void deque<T, Alloc, BufSiz>::pop_back_aux() {
+    deallocate_node(finish.first);
     finish.set_node(finish.node - 1);
     finish.cur = finish.last - 1;
     destroy(finish.cur);
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::pop_front_aux() {
+template<class T, class Alloc, size_t BufSiz>
+inline void deque<T, Alloc, BufSiz>::pop_front_aux() {
     destroy(start.cur);
-    node_allocator::deallocate(start.first);
+    deallocate_node(start.first);
     start.set_node(start.node + 1);
     start.cur = start.first;
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::push_back(const value_type &value) {
+template<class T, class Alloc, size_t BufSiz>
+template<class... Args>
+inline void deque<T, Alloc, BufSiz>::emplace_back(Args &&...args) {
     // finish的cur指向最后一个元素的下一个位置，因此if语句表征至少还有一个备用空间
     if (finish.cur != finish.last - 1) {
-        construct(finish.cur, value);
+        construct(finish.cur, TinySTL::forward<Args>(args)...);
         ++finish.cur;
     } else
-        push_back_aux(value);
+        push_back_aux(TinySTL::forward<Args>(args)...);
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::push_front(const value_type &value) {
+template<class T, class Alloc, size_t BufSiz>
+template<class... Args>
+inline void deque<T, Alloc, BufSiz>::emplace_front(Args &&...args) {
   if (start.cur != start.first) {
-    construct(start.cur - 1, value);
+    construct(start.cur - 1, TinySTL::forward<Args>(args)...);
     --start.cur;
   } else
-    push_front_aux(value);
+    push_front_aux(TinySTL::forward<Args>(args)...);
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::pop_back() {
+template<class T, class Alloc, size_t BufSiz>
+template<class... Args>
+typename deque<T, Alloc, BufSiz>::iterator deque<T, Alloc, BufSiz>::emplace(
+    iterator pos, Args &&...args) {
+  if (pos.cur == start.cur) {
+    emplace_front(TinySTL::forward<Args>(args)...);
+    return start;
+  } else if (pos.cur == finish.cur) {
+    emplace_back(TinySTL::forward<Args>(args)...);
+    iterator temp = finish - 1;
+    return temp;
+  } else
+    return emplace_aux(pos, TinySTL::forward<Args>(args)...);
+}
+
+template<class T, class Alloc, size_t BufSiz>
+inline void deque<T, Alloc, BufSiz>::pop_back() {
   if (finish.cur != finish.first) {
     // 缓冲区至少存在一个元素
     --finish.cur;
@@ -498,8 +603,8 @@ inline void deque<T, Alloc>::pop_back() {
     pop_back_aux();
 }
 
-template<class T, class Alloc>
-inline void deque<T, Alloc>::pop_front() {
+template<class T, class Alloc, size_t BufSiz>
+inline void deque<T, Alloc, BufSiz>::pop_front() {
   if (start.cur != start.last - 1) {
     destroy(start.cur);
     ++start.cur;
@@ -507,14 +612,84 @@ inline void deque<T, Alloc>::pop_front() {
     pop_front_aux();
 }
 
-template<class T, class Alloc>
-typename deque<T, Alloc>::iterator deque<T, Alloc>::insert_aux(
-    iterator pos, const value_type &val) {
+template<class T, class Alloc, size_t BufSiz>
+template<class InputIterator>
+void deque<T, Alloc, BufSiz>::append_aux(InputIterator first,
+                                         InputIterator last,
+                                         input_iterator_tag) {
+  for (; first != last; ++first) push_back(*first);
+}
+
+template<class T, class Alloc, size_t BufSiz>
+template<class ForwardIterator>
+void deque<T, Alloc, BufSiz>::append_aux(ForwardIterator first,
+                                         ForwardIterator last,
+                                         forward_iterator_tag) {
+  size_type n = TinySTL::distance(first, last);
+  iterator new_finish = reserve_elements_at_back(n);
+  try {
+    TinySTL::uninitialized_copy(first, last, finish);
+    finish = new_finish;
+  } catch (std::exception &) {
+    destroy_nodes(finish.node + 1, new_finish.node + 1);
+    throw;
+  }
+}
+
+template<class T, class Alloc, size_t BufSiz>
+template<class InputIterator>
+void deque<T, Alloc, BufSiz>::prepend_aux(InputIterator first,
+                                          InputIterator last,
+                                          input_iterator_tag) {
+  // 输入迭代器无法预知长度，先收集到临时 deque 中再整体置于头部
+  deque temp;
+  temp.append_aux(first, last, input_iterator_tag());
+  prepend_aux(temp.begin(), temp.end(), forward_iterator_tag());
+}
+
+template<class T, class Alloc, size_t BufSiz>
+template<class ForwardIterator>
+void deque<T, Alloc, BufSiz>::prepend_aux(ForwardIterator first,
+                                          ForwardIterator last,
+                                          forward_iterator_tag) {
+  size_type n = TinySTL::distance(first, last);
+  iterator new_start = reserve_elements_at_front(n);
+  try {
+    TinySTL::uninitialized_copy(first, last, new_start);
+    start = new_start;
+  } catch (std::exception &) {
+    destroy_nodes(new_start.node, start.node);
+    throw;
+  }
+}
+
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::pop_front_n(size_type n) {
+  iterator new_start = start + static_cast<difference_type>(n);
+  TinySTL::destroy(start, new_start);
+  // 释放被整段清空的缓冲区
+  destroy_nodes(start.node, new_start.node);
+  start = new_start;
+}
+
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::pop_back_n(size_type n) {
+  iterator new_finish = finish - static_cast<difference_type>(n);
+  TinySTL::destroy(new_finish, finish);
+  destroy_nodes(new_finish.node + 1, finish.node + 1);
+  finish = new_finish;
+}
+
+template<class T, class Alloc, size_t BufSiz>
+template<class... Args>
+typename deque<T, Alloc, BufSiz>::iterator deque<T, Alloc, BufSiz>::emplace_aux(
+    iterator pos, Args &&...args) {
   difference_type index = pos - start;// 插入点之前的元素个数
-  value_type value_copy = val;
+  // 先构造新元素，args 可能引用即将被搬移的元素
+  value_type value_copy(TinySTL::forward<Args>(args)...);
   if (static_cast<size_type>(index) < size() / 2) {// 前移
     // 插图见书
-    push_front(front());// 最前端加入哨兵以作标识，注意此时start发生了改变
+    push_front(TinySTL::move(front()));// 最前端加入哨兵以作标识，注意此时start发生了改变
     iterator front1 = start;
     ++front1;// 复制后自增效率较高
     iterator front2 = front1;
@@ -522,23 +697,23 @@ typename deque<T, Alloc>::iterator deque<T, Alloc>::insert_aux(
     pos = start + index;
     iterator pos1 = pos;
     ++pos1;
-    TinySTL::copy(front2, pos1, front1);// 移动元素
+    TinySTL::move(front2, pos1, front1);// 移动元素
   } else {
     // 过程类似于上
-    push_back(back());
+    push_back(TinySTL::move(back()));
     iterator back1 = finish;
     --back1;
     iterator back2 = back1;
     --back2;
     pos = start + index;
-    TinySTL::copy_backward(pos, back2, back1);
+    TinySTL::move_backward(pos, back2, back1);
   }
-  *pos = value_copy;
+  *pos = TinySTL::move(value_copy);
   return pos;
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::fill_insert(iterator pos, size_type n,
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::fill_insert(iterator pos, size_type n,
                                   const value_type &val) {
   if (pos.cur == start.cur) {
     iterator new_start = reserve_elements_at_front(n);
@@ -560,8 +735,8 @@ void deque<T, Alloc>::fill_insert(iterator pos, size_type n,
     insert_aux(pos, n, val);
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::insert_aux(iterator pos, size_type n,
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::insert_aux(iterator pos, size_type n,
                                  const value_type &val) {
   const difference_type elems_before = pos - start;
   size_type length = size();
@@ -575,7 +750,7 @@ void deque<T, Alloc>::insert_aux(iterator pos, size_type n,
         iterator start_n = start + static_cast<difference_type>(n);
         TinySTL::uninitialized_copy(start, start_n, new_start);
         start = new_start;
-        TinySTL::copy(start_n, pos, old_start);
+        TinySTL::move(start_n, pos, old_start);
         TinySTL::fill(pos - static_cast<difference_type>(n), pos,
                       value_copy);
       } else {
@@ -599,7 +774,7 @@ void deque<T, Alloc>::insert_aux(iterator pos, size_type n,
         iterator finish_n = finish - static_cast<difference_type>(n);
         TinySTL::uninitialized_copy(finish_n, finish, finish);
         finish = new_finish;
-        TinySTL::copy_backward(pos, finish_n, old_finish);
+        TinySTL::move_backward(pos, finish_n, old_finish);
         TinySTL::fill(pos, pos + static_cast<difference_type>(n),
                       value_copy);
       } else {
@@ -617,9 +792,9 @@ void deque<T, Alloc>::insert_aux(iterator pos, size_type n,
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, size_t BufSiz>
 template<class ForwardIterator>
-void deque<T, Alloc>::insert_aux(iterator pos, ForwardIterator first,
+void deque<T, Alloc, BufSiz>::insert_aux(iterator pos, ForwardIterator first,
                                  ForwardIterator last, size_type n) {
   const difference_type elems_before = pos - start;
   size_type length = size();
@@ -632,7 +807,7 @@ void deque<T, Alloc>::insert_aux(iterator pos, ForwardIterator first,
         iterator start_n = start + static_cast<difference_type>(n);
         TinySTL::uninitialized_copy(start, start_n, new_start);
         start = new_start;
-        TinySTL::copy(start_n, pos, old_start);
+        TinySTL::move(start_n, pos, old_start);
         TinySTL::copy(first, last,
                       pos - static_cast<difference_type>(n));
       } else {
@@ -659,7 +834,7 @@ void deque<T, Alloc>::insert_aux(iterator pos, ForwardIterator first,
         iterator finish_n = finish - static_cast<difference_type>(n);
         TinySTL::uninitialized_copy(finish_n, finish, finish);
         finish = new_finish;
-        TinySTL::copy_backward(pos, finish_n, old_finish);
+        TinySTL::move_backward(pos, finish_n, old_finish);
         TinySTL::copy(first, last, pos);
       } else {
         ForwardIterator mid = first;
@@ -676,57 +851,28 @@ void deque<T, Alloc>::insert_aux(iterator pos, ForwardIterator first,
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, size_t BufSiz>
 template<class InputIterator>
-void deque<T, Alloc>::range_insert_aux(iterator pos, InputIterator first,
+void deque<T, Alloc, BufSiz>::range_insert_aux(iterator pos, InputIterator first,
                                        InputIterator last, input_iterator_tag) {
   TinySTL::copy(first, last, inserter(*this, pos));// 插入迭代器
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, size_t BufSiz>
 template<class ForwardIterator>
-void deque<T, Alloc>::range_insert_aux(iterator pos, ForwardIterator first,
+void deque<T, Alloc, BufSiz>::range_insert_aux(iterator pos, ForwardIterator first,
                                        ForwardIterator last,
                                        forward_iterator_tag) {
-  size_type n = TinySTL::distance(first, last);
-  if (pos.cur == start.cur) {
-    iterator new_start = reserve_elements_at_front(n);
-    try {
-      TinySTL::uninitialized_copy(first, last, new_start);
-      start = new_start;
-    } catch (std::exception &) {
-      destroy_nodes(new_start.node, start.node);
-      throw;
-    }
-  } else if (pos.cur == finish.cur) {
-    iterator new_finish = reserve_elements_at_back(n);
-    try {
-      TinySTL::uninitialized_copy(first, last, finish);
-      finish = new_finish;
-    } catch (std::exception &) {
-      destroy_nodes(finish.node + 1, new_finish.node + 1);
-      throw;
-    }
-  } else
-    insert_aux(pos, first, last, n);
+  if (pos.cur == start.cur)
+    prepend_aux(first, last, forward_iterator_tag());
+  else if (pos.cur == finish.cur)
+    append_aux(first, last, forward_iterator_tag());
+  else
+    insert_aux(pos, first, last, TinySTL::distance(first, last));
 }
 
-template<class T, class Alloc>
-typename deque<T, Alloc>::iterator deque<T, Alloc>::insert(
-    iterator pos, const value_type &value) {
-  if (pos.cur == start.cur) {
-    push_front(value);
-    return start;
-  } else if (pos.cur == finish.cur) {
-    push_back(value);
-    iterator temp = finish - 1;
-    return temp;
-  } else
-    return insert_aux(pos, value);
-}
-
-template<class T, class Alloc>
-inline void deque<T, Alloc>::clear() {
+template<class T, class Alloc, size_t BufSiz>
+inline void deque<T, Alloc, BufSiz>::clear() {
   // 清空所有node，保留唯一缓冲区（需要注意的是尽管map可能存有更多节点，但有[start,finish]占据内存
   for (map_pointer node = start.node + 1; node < finish.node;
        ++node) {                                   //内部均存有元素
@@ -742,24 +888,25 @@ inline void deque<T, Alloc>::clear() {
   } else
     TinySTL::destroy(start.cur, finish.cur);// 利用finish.cur标记末尾
   finish = start;
+  compact_map();
 }
 
-template<class T, class Alloc>
-typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator pos) {
+template<class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::iterator deque<T, Alloc, BufSiz>::erase(iterator pos) {
   iterator next = pos + 1;
   difference_type index = pos - start;// 清除点前的元素个数
   if (index < size() / 2) {           // 后移开销较低
-    TinySTL::copy_backward(start, pos, pos);
+    TinySTL::move_backward(start, pos, next);
     pop_front();
   } else {
-    TinySTL::copy(next, finish, pos);
+    TinySTL::move(next, finish, pos);
     pop_back();
   }
   return start + index;
 }
 
-template<class T, class Alloc>
-typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator first,
+template<class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::iterator deque<T, Alloc, BufSiz>::erase(iterator first,
                                                           iterator last) {
   if (first == start && last == finish) {
     clear();
@@ -768,7 +915,7 @@ typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator first,
     difference_type n = last - first;            // 清除区间长度
     difference_type elems_before = first - start;// 前方元素个数
     if (elems_before < (size() - n) / 2) {       // 后移开销较低
-      TinySTL::copy_backward(start, first, last);
+      TinySTL::move_backward(start, first, last);
       iterator new_start = start + n;    // 标记新起点
       TinySTL::destroy(start, new_start);// 析构多余元素
       // 释放多余缓冲区
@@ -776,7 +923,7 @@ typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator first,
         node_allocator::deallocate(*cur, buffer_size());
       start = new_start;
     } else {// 前移开销较低
-      TinySTL::copy(last, finish, first);
+      TinySTL::move(last, finish, first);
       iterator new_finish = finish - n;// 标记末尾
       TinySTL::destroy(new_finish, finish);
       // 释放多余缓冲区
@@ -789,8 +936,8 @@ typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator first,
   }
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::resize(size_type new_size, const value_type &val) {
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::resize(size_type new_size, const value_type &val) {
     const size_type len = size();
     if (new_size < len)
         erase(start + new_size, finish);
@@ -798,47 +945,54 @@ void deque<T, Alloc>::resize(size_type new_size, const value_type &val) {
         insert(finish, new_size - len, val);
 }
 
-template<class T, class Alloc>
-void deque<T, Alloc>::swap(deque &rhs) noexcept {
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::shrink_to_fit() {
+    size_type new_map_size =
+        TinySTL::max(initial_map_size(), size_type(finish.node - start.node + 3));
+    if (new_map_size < map_size) shrink_map(new_map_size);
+}
+
+template<class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::swap(deque &rhs) noexcept {
   TinySTL::swap(start, rhs.start);
   TinySTL::swap(finish, rhs.finish);
   TinySTL::swap(map, rhs.map);
   TinySTL::swap(map_size, rhs.map_size);
 }
 
-template<class T, class Alloc>
-inline void swap(deque<T, Alloc> &lhs, deque<T, Alloc> &rhs) noexcept {
+template<class T, class Alloc, size_t BufSiz>
+inline void swap(deque<T, Alloc, BufSiz> &lhs, deque<T, Alloc, BufSiz> &rhs) noexcept {
   lhs.swap(rhs);
 }
 
-template<class T, class Alloc>
-inline bool operator==(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline bool operator==(const deque<T, Alloc, BufSiz> &lhs, const deque<T, Alloc, BufSiz> &rhs) {
   return lhs.size() == rhs.size() && TinySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template<class T, class Alloc>
-inline bool operator!=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline bool operator!=(const deque<T, Alloc, BufSiz> &lhs, const deque<T, Alloc, BufSiz> &rhs) {
   return !(lhs == rhs);
 }
 
-template<class T, class Alloc>
-inline bool operator<(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline bool operator<(const deque<T, Alloc, BufSiz> &lhs, const deque<T, Alloc, BufSiz> &rhs) {
   return TinySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
                                           rhs.end());
 }
 
-template<class T, class Alloc>
-inline bool operator>(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline bool operator>(const deque<T, Alloc, BufSiz> &lhs, const deque<T, Alloc, BufSiz> &rhs) {
   return rhs < lhs;
 }
 
-template<class T, class Alloc>
-inline bool operator<=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline bool operator<=(const deque<T, Alloc, BufSiz> &lhs, const deque<T, Alloc, BufSiz> &rhs) {
   return !(rhs < lhs);
 }
 
-template<class T, class Alloc>
-inline bool operator>=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+template<class T, class Alloc, size_t BufSiz>
+inline bool operator>=(const deque<T, Alloc, BufSiz> &lhs, const deque<T, Alloc, BufSiz> &rhs) {
   return !(lhs < rhs);
 }
 
@@ -0,0 +1,491 @@
+/*
+    intrusive_list / intrusive_slist: 侵入式链表
+    链接指针不再放在容器配置的节点里，而是由用户类型内嵌的钩子（hook）成员提供：
+        struct item {
+          int value;
+          intrusive_list_hook by_age;  // 可同时属于多个容器，每个容器使用各自的钩子
+          intrusive_list_hook by_size;
+        };
+        intrusive_list<item, &item::by_age> ages;
+
+    容器不拥有元素：插入与删除只修改钩子中的指针，不配置、不构造也不析构任何对象。
+    元素的生命周期由用户管理，元素析构前必须先从容器中移除（或容器先被 clear/析构）。
+    钩子在未链入时 next == nullptr，可用 is_linked() 检查；复制对象时钩子不随之复制。
+*/
+#pragma once
+
+#include "Iterator/stl_iterator.h"
+#include "Utils/type_traits.h"
+#include <cstddef>
+
+namespace TinySTL {
+
+struct intrusive_list_hook {
+  intrusive_list_hook *next;
+  intrusive_list_hook *prev;
+
+  intrusive_list_hook() noexcept : next(nullptr), prev(nullptr) {}
+  // 复制对象不复制链接关系
+  intrusive_list_hook(const intrusive_list_hook &) noexcept : next(nullptr), prev(nullptr) {}
+  intrusive_list_hook &operator=(const intrusive_list_hook &) noexcept { return *this; }
+
+  bool is_linked() const noexcept { return next != nullptr; }
+};
+
+struct intrusive_slist_hook {
+  intrusive_slist_hook *next;
+
+  intrusive_slist_hook() noexcept : next(nullptr) {}
+  intrusive_slist_hook(const intrusive_slist_hook &) noexcept : next(nullptr) {}
+  intrusive_slist_hook &operator=(const intrusive_slist_hook &) noexcept { return *this; }
+
+  bool is_linked() const noexcept { return next != nullptr; }
+};
+
+// 由钩子地址反推宿主对象地址：偏移量只依赖成员指针，编译期即可折叠为常量
+template<class T, class Hook, Hook T::*Member>
+inline T *_intrusive_owner(Hook *h) noexcept {
+  unsigned char *base = reinterpret_cast<unsigned char *>(h);
+  const ptrdiff_t offset = reinterpret_cast<unsigned char *>(&(reinterpret_cast<T *>(base)->*Member)) - base;
+  return reinterpret_cast<T *>(base - offset);
+}
+
+template<class T, class Hook, Hook T::*Member>
+inline const T *_intrusive_owner(const Hook *h) noexcept {
+  return _intrusive_owner<T, Hook, Member>(const_cast<Hook *>(h));
+}
+
+/*
+    intrusive_list
+*/
+template<class T, intrusive_list_hook T::*Member, class Ref, class Ptr>
+struct _intrusive_list_iterator {
+  using iterator = _intrusive_list_iterator<T, Member, T &, T *>;
+  using const_iterator = _intrusive_list_iterator<T, Member, const T &, const T *>;
+  using self = _intrusive_list_iterator;
+
+  using iterator_category = bidirectional_iterator_tag;
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using difference_type = ptrdiff_t;
+
+  intrusive_list_hook *node;
+
+  _intrusive_list_iterator() : node(nullptr) {}
+  explicit _intrusive_list_iterator(intrusive_list_hook *x) : node(x) {}
+  _intrusive_list_iterator(const iterator &rhs) : node(rhs.node) {}
+
+  reference operator*() const { return *_intrusive_owner<T, intrusive_list_hook, Member>(node); }
+  pointer operator->() const { return &(operator*()); }
+
+  self &operator++() {
+    node = node->next;
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++*this;
+    return temp;
+  }
+  self &operator--() {
+    node = node->prev;
+    return *this;
+  }
+  self operator--(int) {
+    self temp = *this;
+    --*this;
+    return temp;
+  }
+
+  bool operator==(const self &rhs) const { return node == rhs.node; }
+  bool operator!=(const self &rhs) const { return node != rhs.node; }
+};
+
+template<class T, intrusive_list_hook T::*Member>
+class intrusive_list {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = _intrusive_list_iterator<T, Member, T &, T *>;
+  using const_iterator = _intrusive_list_iterator<T, Member, const T &, const T *>;
+
+ private:// data member
+  intrusive_list_hook header;// 环状链表的哨兵，不属于任何元素
+  size_type length;
+
+ private:// aux interface
+  static intrusive_list_hook *hook_of(T &x) noexcept { return &(x.*Member); }
+
+  void init_header() noexcept {
+    header.next = &header;
+    header.prev = &header;
+    length = 0;
+  }
+  // 在 pos 之前链入 h
+  static void link_before(intrusive_list_hook *pos, intrusive_list_hook *h) noexcept {
+    h->next = pos;
+    h->prev = pos->prev;
+    pos->prev->next = h;
+    pos->prev = h;
+  }
+  static void unlink(intrusive_list_hook *h) noexcept {
+    h->prev->next = h->next;
+    h->next->prev = h->prev;
+    h->next = h->prev = nullptr;
+  }
+  // 把 [first, last) 摘下并链入 pos 之前
+  static void transfer(intrusive_list_hook *pos, intrusive_list_hook *first,
+                       intrusive_list_hook *last) noexcept {
+    if (pos == last) return;
+    intrusive_list_hook *tail = last->prev;
+    first->prev->next = last;
+    last->prev = first->prev;
+    tail->next = pos;
+    first->prev = pos->prev;
+    pos->prev->next = first;
+    pos->prev = tail;
+  }
+  // 接管 rhs 的全部元素，rhs 置空
+  void steal(intrusive_list &rhs) noexcept {
+    if (rhs.empty()) {
+      init_header();
+      return;
+    }
+    header.next = rhs.header.next;
+    header.prev = rhs.header.prev;
+    header.next->prev = &header;
+    header.prev->next = &header;
+    length = rhs.length;
+    rhs.init_header();
+  }
+
+ public:// ctor && dtor
+  intrusive_list() noexcept { init_header(); }
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list &operator=(const intrusive_list &) = delete;
+  intrusive_list(intrusive_list &&rhs) noexcept { steal(rhs); }
+  intrusive_list &operator=(intrusive_list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      steal(rhs);
+    }
+    return *this;
+  }
+  ~intrusive_list() { clear(); }
+
+ public:// getter
+  const_iterator begin() const noexcept { return const_iterator(header.next); }
+  const_iterator end() const noexcept { return const_iterator(const_cast<intrusive_list_hook *>(&header)); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  bool empty() const noexcept { return header.next == &header; }
+  size_type size() const noexcept { return length; }
+  const_reference front() const noexcept { return *begin(); }
+  const_reference back() const noexcept { return *(--end()); }
+
+ public:// setter
+  iterator begin() noexcept { return iterator(header.next); }
+  iterator end() noexcept { return iterator(&header); }
+  reference front() noexcept { return *begin(); }
+  reference back() noexcept { return *(--end()); }
+
+  // 由元素引用得到其迭代器，O(1)
+  iterator iterator_to(reference x) noexcept { return iterator(hook_of(x)); }
+  const_iterator iterator_to(const_reference x) const noexcept {
+    return const_iterator(const_cast<intrusive_list_hook *>(&(x.*Member)));
+  }
+
+ public:// insert && erase，均不配置内存
+  // 要求 x 的该钩子尚未链入任何容器
+  iterator insert(const_iterator pos, reference x) noexcept {
+    intrusive_list_hook *h = hook_of(x);
+    link_before(pos.node, h);
+    ++length;
+    return iterator(h);
+  }
+  void push_front(reference x) noexcept { insert(begin(), x); }
+  void push_back(reference x) noexcept { insert(end(), x); }
+
+  iterator erase(const_iterator pos) noexcept {
+    intrusive_list_hook *next = pos.node->next;
+    unlink(pos.node);
+    --length;
+    return iterator(next);
+  }
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    while (first != last) first = erase(first);
+    return iterator(last.node);
+  }
+  // 要求 x 位于本容器中
+  void remove(reference x) noexcept { erase(iterator_to(x)); }
+  void pop_front() noexcept { erase(begin()); }
+  void pop_back() noexcept { erase(--end()); }
+
+  template<class Predicate>
+  void remove_if(Predicate pred) {
+    for (iterator first = begin(); first != end();) {
+      if (pred(*first))
+        first = erase(first);
+      else
+        ++first;
+    }
+  }
+
+  // 逐个复位钩子，使元素可再次链入其他容器
+  void clear() noexcept {
+    intrusive_list_hook *cur = header.next;
+    while (cur != &header) {
+      intrusive_list_hook *next = cur->next;
+      cur->next = cur->prev = nullptr;
+      cur = next;
+    }
+    init_header();
+  }
+
+  void swap(intrusive_list &rhs) noexcept {
+    intrusive_list temp(TinySTL::move(rhs));
+    rhs.steal(*this);
+    steal(temp);
+  }
+
+ public:// splice，只改指针
+  void splice(const_iterator pos, intrusive_list &rhs) noexcept {
+    if (rhs.empty()) return;
+    transfer(pos.node, rhs.header.next, &rhs.header);
+    length += rhs.length;
+    rhs.length = 0;
+  }
+  void splice(const_iterator pos, intrusive_list &rhs, const_iterator i) noexcept {
+    intrusive_list_hook *j = i.node->next;
+    if (pos.node == i.node || pos.node == j) return;
+    transfer(pos.node, i.node, j);
+    ++length;
+    --rhs.length;
+  }
+  void splice(const_iterator pos, intrusive_list &rhs, const_iterator first,
+              const_iterator last) noexcept {
+    if (first == last) return;
+    if (this != &rhs) {
+      size_type n = static_cast<size_type>(TinySTL::distance(first, last));
+      length += n;
+      rhs.length -= n;
+    }
+    transfer(pos.node, first.node, last.node);
+  }
+};
+
+template<class T, intrusive_list_hook T::*Member>
+inline void swap(intrusive_list<T, Member> &lhs, intrusive_list<T, Member> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+/*
+    intrusive_slist：单向侵入式链表，末元素的 next 指回哨兵，
+    因此已链入的钩子 next 恒非空，与未链入状态可以区分
+*/
+template<class T, intrusive_slist_hook T::*Member, class Ref, class Ptr>
+struct _intrusive_slist_iterator {
+  using iterator = _intrusive_slist_iterator<T, Member, T &, T *>;
+  using const_iterator = _intrusive_slist_iterator<T, Member, const T &, const T *>;
+  using self = _intrusive_slist_iterator;
+
+  using iterator_category = forward_iterator_tag;
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using difference_type = ptrdiff_t;
+
+  intrusive_slist_hook *node;
+
+  _intrusive_slist_iterator() : node(nullptr) {}
+  explicit _intrusive_slist_iterator(intrusive_slist_hook *x) : node(x) {}
+  _intrusive_slist_iterator(const iterator &rhs) : node(rhs.node) {}
+
+  reference operator*() const { return *_intrusive_owner<T, intrusive_slist_hook, Member>(node); }
+  pointer operator->() const { return &(operator*()); }
+
+  self &operator++() {
+    node = node->next;
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++*this;
+    return temp;
+  }
+
+  bool operator==(const self &rhs) const { return node == rhs.node; }
+  bool operator!=(const self &rhs) const { return node != rhs.node; }
+};
+
+template<class T, intrusive_slist_hook T::*Member>
+class intrusive_slist {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = _intrusive_slist_iterator<T, Member, T &, T *>;
+  using const_iterator = _intrusive_slist_iterator<T, Member, const T &, const T *>;
+
+ private:// data member
+  intrusive_slist_hook header;
+  size_type length;
+
+ private:// aux interface
+  static intrusive_slist_hook *hook_of(T &x) noexcept { return &(x.*Member); }
+
+  void init_header() noexcept {
+    header.next = &header;
+    length = 0;
+  }
+  // 接管 rhs 的全部元素：需要找到末元素并令其指回本哨兵
+  void steal(intrusive_slist &rhs) noexcept {
+    if (rhs.empty()) {
+      init_header();
+      return;
+    }
+    intrusive_slist_hook *last = rhs.header.next;
+    while (last->next != &rhs.header) last = last->next;
+    header.next = rhs.header.next;
+    last->next = &header;
+    length = rhs.length;
+    rhs.init_header();
+  }
+
+ public:// ctor && dtor
+  intrusive_slist() noexcept { init_header(); }
+  intrusive_slist(const intrusive_slist &) = delete;
+  intrusive_slist &operator=(const intrusive_slist &) = delete;
+  intrusive_slist(intrusive_slist &&rhs) noexcept { steal(rhs); }
+  intrusive_slist &operator=(intrusive_slist &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      steal(rhs);
+    }
+    return *this;
+  }
+  ~intrusive_slist() { clear(); }
+
+ public:// getter
+  const_iterator before_begin() const noexcept {
+    return const_iterator(const_cast<intrusive_slist_hook *>(&header));
+  }
+  const_iterator begin() const noexcept { return const_iterator(header.next); }
+  const_iterator end() const noexcept { return before_begin(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  bool empty() const noexcept { return header.next == &header; }
+  size_type size() const noexcept { return length; }
+  const_reference front() const noexcept { return *begin(); }
+
+ public:// setter
+  iterator before_begin() noexcept { return iterator(&header); }
+  iterator begin() noexcept { return iterator(header.next); }
+  // 环状结构：哨兵同时充当 before_begin 与 end
+  iterator end() noexcept { return iterator(&header); }
+  reference front() noexcept { return *begin(); }
+
+  iterator iterator_to(reference x) noexcept { return iterator(hook_of(x)); }
+  const_iterator iterator_to(const_reference x) const noexcept {
+    return const_iterator(const_cast<intrusive_slist_hook *>(&(x.*Member)));
+  }
+  // 查找 pos 的前驱，O(n)
+  iterator previous(const_iterator pos) noexcept {
+    intrusive_slist_hook *cur = &header;
+    while (cur->next != pos.node) cur = cur->next;
+    return iterator(cur);
+  }
+
+ public:// insert && erase，均不配置内存
+  iterator insert_after(const_iterator pos, reference x) noexcept {
+    intrusive_slist_hook *h = hook_of(x);
+    h->next = pos.node->next;
+    pos.node->next = h;
+    ++length;
+    return iterator(h);
+  }
+  void push_front(reference x) noexcept { insert_after(before_begin(), x); }
+
+  // 删除 pos 之后的元素，返回被删元素的后继
+  iterator erase_after(const_iterator pos) noexcept {
+    intrusive_slist_hook *victim = pos.node->next;
+    pos.node->next = victim->next;
+    victim->next = nullptr;
+    --length;
+    return iterator(pos.node->next);
+  }
+  // 删除 (before_first, last) 之间的元素
+  iterator erase_after(const_iterator before_first, const_iterator last) noexcept {
+    while (before_first.node->next != last.node) erase_after(before_first);
+    return iterator(last.node);
+  }
+  void pop_front() noexcept { erase_after(before_begin()); }
+  // 要求 x 位于本容器中；需要查找前驱，O(n)
+  void remove(reference x) noexcept { erase_after(previous(iterator_to(x))); }
+
+  template<class Predicate>
+  void remove_if(Predicate pred) {
+    intrusive_slist_hook *prev = &header;
+    while (prev->next != &header) {
+      if (pred(*iterator(prev->next)))
+        erase_after(iterator(prev));
+      else
+        prev = prev->next;
+    }
+  }
+
+  void clear() noexcept {
+    intrusive_slist_hook *cur = header.next;
+    while (cur != &header) {
+      intrusive_slist_hook *next = cur->next;
+      cur->next = nullptr;
+      cur = next;
+    }
+    init_header();
+  }
+
+  void swap(intrusive_slist &rhs) noexcept {
+    intrusive_slist temp(TinySTL::move(rhs));
+    rhs.steal(*this);
+    steal(temp);
+  }
+
+ public:// splice_after
+  // 把 rhs 的全部元素接到 pos 之后
+  void splice_after(const_iterator pos, intrusive_slist &rhs) noexcept {
+    if (rhs.empty() || this == &rhs) return;
+    intrusive_slist_hook *last = rhs.header.next;
+    while (last->next != &rhs.header) last = last->next;
+    last->next = pos.node->next;
+    pos.node->next = rhs.header.next;
+    length += rhs.length;
+    rhs.init_header();
+  }
+  // 把 rhs 中 before 之后的那个元素移到 pos 之后
+  void splice_after(const_iterator pos, intrusive_slist &rhs, const_iterator before) noexcept {
+    intrusive_slist_hook *h = before.node->next;
+    if (pos.node == before.node || pos.node == h) return;
+    before.node->next = h->next;
+    h->next = pos.node->next;
+    pos.node->next = h;
+    ++length;
+    --rhs.length;
+  }
+};
+
+template<class T, intrusive_slist_hook T::*Member>
+inline void swap(intrusive_slist<T, Member> &lhs, intrusive_slist<T, Member> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
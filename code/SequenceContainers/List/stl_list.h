@@ -2,13 +2,24 @@
 
 #include "Allocator/allocator.h"
 #include "Allocator/uninitialized.h"
+#include "Function/function_adapter.h"
 #include "List/stl_list_node.h"
 #include "stl_list_iterator.h"
 #include <exception>
 #include <initializer_list>
+#include <type_traits>
 
 namespace TinySTL {
 
+// 预取只是提示，不支持的编译器上为空操作
+inline void _list_prefetch(const void *p) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void) p;
+#endif
+}
+
 template <class T, class Alloc = simpleAlloc<T>>
 class list {
 public:
@@ -30,7 +41,8 @@ private:
 
     list_node *get_node() { return list_node_allocator::allocate(); }
     void put_node(list_node* p) { list_node_allocator::deallocate(p); }
-    list_node *create_node(const value_type&);
+    template<class... Args>
+    list_node *create_node(Args &&...);
     void destroy_node(list_node *p) {
         TinySTL::destroy(p);
         put_node(p);
@@ -38,12 +50,47 @@ private:
 
 private:// data member
     list_node *node; // 初始 node 为尾后哨兵
+    size_type length; // 元素个数，由所有增删节点的操作维护
 
 private:// aux_interface
     void empty_initialized();
     // Move [first ,last) before pos
     void transfer(iterator position, iterator first, iterator last);
 
+private:// aux_interface for sort
+    // 有序段：以 nullptr 结尾，除首节点外 prev 均有效，last 为末节点
+    struct sort_run {
+        list_node *first;
+        list_node *last;
+    };
+    // 将 b 归并入 a，相等时 a 的元素在前；顺带维护 prev，无需额外的一趟遍历
+    template<class Compare>
+    static void merge_runs(sort_run &a, sort_run &b, Compare &comp);
+    static list_node *concat_runs(list_node *a, list_node *b);
+    // 由以 nullptr 结尾的单链重建 prev 指针与环状结构
+    void relink(list_node *first);
+    // sort_gathered 缓冲区中的元素：一般情形只收集节点指针；
+    // 小的 trivial 类型连同值一起收集，比较时完全不必访问零散的节点
+    struct sort_entry {
+        T key;
+        list_node *node;
+    };
+    using gather_value = bool_constant<std::is_trivial<T>::value &&
+                                       sizeof(T) <= 2 * sizeof(void *)>;
+    static const T &entry_key(list_node *p) { return p->data; }
+    static const T &entry_key(const sort_entry &e) { return e.key; }
+    static list_node *entry_node(list_node *p) { return p; }
+    static list_node *entry_node(const sort_entry &e) { return e.node; }
+    static void make_entry(list_node *&e, list_node *p) { e = p; }
+    static void make_entry(sort_entry &e, list_node *p) {
+        e.key = p->data;
+        e.node = p;
+    }
+    template<class Entry, class Compare>
+    static Entry *sort_entries(Entry *a, Entry *tmp, size_type n, Compare &comp);
+    template<class Entry, class Compare>
+    void sort_gathered_aux(Compare &comp);
+
 public:// ctor && dtor
     list() { empty_initialized(); }
     explicit list(size_type, const value_type &value = value_type());
@@ -65,7 +112,10 @@ public:// ctor && dtor
     }
 
 public://swap
-    void swap(list &rhs) noexcept { TinySTL::swap(node, rhs.node); }
+    void swap(list &rhs) noexcept {
+        TinySTL::swap(node, rhs.node);
+        TinySTL::swap(length, rhs.length);
+    }
 
 public://copy
     list(const list &);
@@ -74,22 +124,18 @@ public://copy
 public://move
     list(list &&rhs) noexcept {
         empty_initialized();
-        TinySTL::swap(node, rhs.node);
+        swap(rhs);
     }
     list &operator= (list &&rhs) noexcept {
-        empty_initialized();
+        clear();
         swap(rhs);
         return *this;
     }
 
 public:// getter
     bool empty() const noexcept { return node->next == node; }
-    size_type size() const noexcept {
-        return TinySTL::distance(cbegin(), cend());
-        // distance底层还是遍历了节点求size，复杂度是O(n),
-        // 直接在list里记录当前长度是否更好？
-        // C++11之后的主流实现为O(1)
-    }
+    // C++11 起要求 O(1)：直接返回记录的长度
+    size_type size() const noexcept { return length; }
     const_iterator begin() const noexcept { return const_iterator(node->next); }
     const_iterator end() const noexcept { return const_iterator(node); }
     const_iterator cbegin() const noexcept { return const_iterator(node->next); }
@@ -118,9 +164,26 @@ public:// aux interface for insert
     template<class InputIterator>
     void insert_dispatch(iterator, InputIterator, InputIterator, false_type);
 
+public:// emplace
+    template<class... Args>
+    iterator emplace(iterator, Args &&...);
+    template<class... Args>
+    void emplace_front(Args &&...args) {
+        emplace(begin(), TinySTL::forward<Args>(args)...);
+    }
+    template<class... Args>
+    void emplace_back(Args &&...args) {
+        emplace(end(), TinySTL::forward<Args>(args)...);
+    }
+
 public:// insert
-    iterator insert(iterator pos) { return insert(pos, value_type()); }
-    iterator insert(iterator, const value_type &);
+    iterator insert(iterator pos) { return emplace(pos); }
+    iterator insert(iterator pos, const value_type &value) {
+        return emplace(pos, value);
+    }
+    iterator insert(iterator pos, value_type &&value) {
+        return emplace(pos, TinySTL::move(value));
+    }
 
     template<class InputIterator>
     void insert(iterator pos, InputIterator first, InputIterator last) {
@@ -134,7 +197,9 @@ public://erase
 
 public:// push && pop
     void push_front(const T &value) { insert(begin(), value); }
+    void push_front(T &&value) { insert(begin(), TinySTL::move(value)); }
     void push_back(const T &value) { insert(end(), value); }
+    void push_back(T &&value) { insert(end(), TinySTL::move(value)); }
     void pop_front() { erase(begin()); }
     void pop_back() {
         iterator temp = end();
@@ -144,26 +209,42 @@ public:// push && pop
 public:// other list algorithm
     void unique();
     void splice(iterator pos, list &rhs) {
-        if (!rhs.empty()) transfer(pos, rhs.begin(), rhs.end());
+        if (!rhs.empty()) {
+            transfer(pos, rhs.begin(), rhs.end());
+            length += rhs.length;
+            rhs.length = 0;
+        }
     }
     void splice(iterator, list &, iterator);
-    void splice(iterator pos, list &, iterator first, iterator last) {
-        if (first != last) transfer(pos, first, last);
-    }
-    void merge(list &);
+    void splice(iterator, list &, iterator, iterator);
+    void merge(list &x) { merge(x, TinySTL::less<T>()); }
+    template<class Compare>
+    void merge(list &, Compare);
     void reverse();
-    void sort();
+    // 自底向上的归并排序，直接在节点链接上进行，不配置任何内存
+    void sort() { sort(TinySTL::less<T>()); }
+    template<class Compare>
+    void sort(Compare);
+    // 把节点指针（小的 trivial 类型连同其值）收集到连续缓冲区中排序后再重新链接，
+    // 需要 2 * size() 个缓冲区元素的额外内存，换取对连续数组而非零散节点的归并
+    void sort_gathered() { sort_gathered(TinySTL::less<T>()); }
+    template<class Compare>
+    void sort_gathered(Compare comp) {
+        using entry = conditional_t<gather_value::value, sort_entry, list_node *>;
+        sort_gathered_aux<entry>(comp);
+    }
     void remove(const T &);
 
 };
 
 template <class T, class Alloc>
+template <class... Args>
 inline typename list<T, Alloc>::list_node *list<T, Alloc>::create_node(
-    const T& value) {
+    Args &&...args) {
     list_node *p = get_node();
     try {
-        TinySTL::construct(&p->data, value);
-    } catch (std::exception) {
+        TinySTL::construct(&p->data, TinySTL::forward<Args>(args)...);
+    } catch (std::exception &) {
         put_node(p);
         throw;
     }
@@ -175,6 +256,7 @@ inline void list<T, Alloc>::empty_initialized() {
     node = get_node();
     node->next = node;
     node->prev = node;
+    length = 0;
 }
 
 template <class T, class Alloc>
@@ -237,13 +319,15 @@ void list<T, Alloc>::insert_dispatch(iterator pos,
 }
 
 template<class T, class Alloc>
-inline typename list<T, Alloc>::iterator list<T, Alloc>::insert(
-    iterator position, const value_type &value) {
-    list_node *temp = create_node(value);
+template<class... Args>
+inline typename list<T, Alloc>::iterator list<T, Alloc>::emplace(
+    iterator position, Args &&...args) {
+    list_node *temp = create_node(TinySTL::forward<Args>(args)...);
     temp->next = position.node;
     temp->prev = position.node->prev;
     position.node->prev->next = temp;
     position.node->prev = temp;
+    ++length;
     return iterator(temp);
 }
 
@@ -255,6 +339,7 @@ inline typename list<T, Alloc>::iterator list<T, Alloc>::erase(
     prev_node->next = next_node;
     next_node->prev = prev_node;
     destroy_node(position.node);
+    --length;
     return iterator(next_node);
 }
 
@@ -276,6 +361,7 @@ void list<T, Alloc>::clear() {
     }
     node->next = node;
     node->prev = node;
+    length = 0;
 }
 
 template<class T, class Alloc>
@@ -306,25 +392,43 @@ void list<T, Alloc>::unique() {
 }
 
 template<class T, class Alloc>
-inline void list<T, Alloc>::splice(iterator position, list &, iterator i) {
+inline void list<T, Alloc>::splice(iterator position, list &rhs, iterator i) {
   iterator j = i;
   ++j;
   // i==pos 自身无法插于自身之前
   // j==pos 已处于pos之前
   if (position == i || position == j) return;
   transfer(position, i, j);
+  ++length;
+  --rhs.length;
+}
+
+// 区间来自另一个 list 时需数出区间长度以维护两边的 length，O(n)；
+// 同一 list 内部移动则长度不变，仍为 O(1)
+template<class T, class Alloc>
+inline void list<T, Alloc>::splice(iterator position, list &rhs, iterator first,
+                                   iterator last) {
+  if (first == last) return;
+  if (&rhs != this) {
+    size_type n = static_cast<size_type>(TinySTL::distance(first, last));
+    length += n;
+    rhs.length -= n;
+  }
+  transfer(position, first, last);
 }
 
 // need two lists' elements are ordered
 template<class T, class Alloc>
-void list<T, Alloc>::merge(list &x) {
+template<class Compare>
+void list<T, Alloc>::merge(list &x, Compare comp) {
+  if (&x == this) return;
   iterator first1 = begin();
   iterator last1 = end();
   iterator first2 = x.begin();
   iterator last2 = x.end();
 
   while (first1 != last1 && first2 != last2) {
-    if (*first2 < *first1) {
+    if (comp(*first2, *first1)) {
       iterator next = first2;
       transfer(first1, first2, ++next);
       first2 = next;
@@ -332,6 +436,8 @@ void list<T, Alloc>::merge(list &x) {
       ++first1;
   }
   if (first2 != last2) transfer(last1, first2, last2);
+  length += x.length;
+  x.length = 0;
 }
 
 template<class T, class Alloc>
@@ -348,28 +454,179 @@ void list<T, Alloc>::reverse() {
   }
 }
 
-// More information can be seen at
-// https://blog.csdn.net/qq276592716/article/details/7932483
 template<class T, class Alloc>
-void list<T, Alloc>::sort() {
+template<class Compare>
+void list<T, Alloc>::merge_runs(sort_run &a, sort_run &b, Compare &comp) {
+  list_node *first = nullptr;
+  list_node *last = nullptr;// 已输出的末节点
+  list_node *x = a.first;
+  list_node *y = b.first;
+  try {
+    while (x && y) {
+      list_node *next;
+      if (comp(y->data, x->data)) {
+        next = y;
+        y = y->next;
+      } else {
+        next = x;
+        x = x->next;
+      }
+      if (last) {
+        last->next = next;
+        next->prev = last;
+      } else
+        first = next;
+      last = next;
+    }
+  } catch (std::exception &) {
+    // 比较抛出异常：剩余的两条链接到结果末尾，所有节点仍在 a 这一条链上
+    list_node *rest = concat_runs(x, y);
+    if (last) last->next = rest;
+    else first = rest;
+    a.first = first;
+    a.last = nullptr;
+    b.first = b.last = nullptr;
+    throw;
+  }
+  // 剩余部分整段接上，段内的 prev 本已有效
+  list_node *rest = x ? x : y;
+  if (rest) {
+    if (last) {
+      last->next = rest;
+      rest->prev = last;
+    } else
+      first = rest;
+    last = x ? a.last : b.last;
+  }
+  a.first = first;
+  a.last = last;
+  b.first = b.last = nullptr;
+}
+
+template<class T, class Alloc>
+typename list<T, Alloc>::list_node *list<T, Alloc>::concat_runs(list_node *a,
+                                                                list_node *b) {
+  if (!a) return b;
+  list_node *last = a;
+  while (last->next) last = last->next;
+  last->next = b;
+  return a;
+}
+
+template<class T, class Alloc>
+void list<T, Alloc>::relink(list_node *first) {
+  list_node *prev = node;
+  for (list_node *cur = first; cur; cur = cur->next) {
+    prev->next = cur;
+    cur->prev = prev;
+    prev = cur;
+  }
+  prev->next = node;
+  node->prev = prev;
+}
+
+// 先以插入排序排好长度为 16 的小段，再自底向上两两归并，
+// a 与 tmp 轮流作为输入与输出，返回最终有序的那一个
+template<class T, class Alloc>
+template<class Entry, class Compare>
+Entry *list<T, Alloc>::sort_entries(Entry *a, Entry *tmp, size_type n, Compare &comp) {
+  const size_type run = 16;
+  for (size_type lo = 0; lo < n; lo += run) {
+    size_type hi = lo + run < n ? lo + run : n;
+    for (size_type i = lo + 1; i < hi; ++i) {
+      Entry x = a[i];
+      size_type j = i;
+      for (; j > lo && comp(entry_key(x), entry_key(a[j - 1])); --j) a[j] = a[j - 1];
+      a[j] = x;
+    }
+  }
+  Entry *src = a;
+  Entry *dst = tmp;
+  for (size_type width = run; width < n; width *= 2) {
+    for (size_type lo = 0; lo < n; lo += 2 * width) {
+      size_type mid = lo + width < n ? lo + width : n;
+      size_type hi = lo + 2 * width < n ? lo + 2 * width : n;
+      size_type i = lo, j = mid, k = lo;
+      while (i < mid && j < hi) {
+        // 缓冲区是连续的，可以提前预取之后将要比较的元素
+        _list_prefetch(&entry_key(src[i + 8 < mid ? i + 8 : mid - 1]));
+        _list_prefetch(&entry_key(src[j + 8 < hi ? j + 8 : hi - 1]));
+        dst[k++] = comp(entry_key(src[j]), entry_key(src[i])) ? src[j++] : src[i++];
+      }
+      while (i < mid) dst[k++] = src[i++];
+      while (j < hi) dst[k++] = src[j++];
+    }
+    TinySTL::swap(src, dst);
+  }
+  return src;
+}
+
+// counter[i] 为至多 2^i 个元素的有序段，与原先以 64 个 list 作缓冲区的算法相同，
+// 但直接操作节点链接，不再为 65 个临时 list 配置哨兵节点
+template<class T, class Alloc>
+template<class Compare>
+void list<T, Alloc>::sort(Compare comp) {
   if (node->next == node || node->next->next == node) return;
-  // 数据缓存区
-  // counter[n]中最多存放2^(n+1)个元素，若大于则与counter[n+1]作归并
-  list carry;
-  list counter[64];
+  sort_run counter[64] = {};
+  sort_run carry = {nullptr, nullptr};
   int fill = 0;
-  while (!empty()) {
-    carry.splice(carry.begin(), *this, begin());
-    int i = 0;
-    while (i < fill && !counter[i].empty()) {
-      counter[i].merge(carry);
-      carry.swap(counter[i++]);
+  node->prev->next = nullptr;// 断开环，rest 为待处理的单链
+  list_node *rest = node->next;
+  try {
+    while (rest) {
+      carry.first = carry.last = rest;
+      rest = rest->next;
+      carry.first->next = nullptr;
+      int i = 0;
+      for (; i < fill && counter[i].first; ++i) {
+        merge_runs(counter[i], carry, comp);// counter[i] 中的元素更早，保持稳定
+        TinySTL::swap(carry, counter[i]);
+      }
+      TinySTL::swap(carry, counter[i]);
+      if (i == fill) ++fill;
     }
-    carry.swap(counter[i]);
-    if (i == fill) ++fill;
+    for (int i = 1; i < fill; ++i) merge_runs(counter[i], counter[i - 1], comp);
+  } catch (std::exception &) {
+    // 所有节点串回 list（次序未定）后重新抛出
+    list_node *all = concat_runs(rest, carry.first);
+    for (int i = 0; i < fill; ++i) all = concat_runs(counter[i].first, all);
+    relink(all);
+    throw;
   }
-  for (int i = 1; i < fill; ++i) counter[i].merge(counter[i - 1]);
-  swap(counter[fill - 1]);
+  sort_run &result = counter[fill - 1];
+  node->next = result.first;
+  result.first->prev = node;
+  result.last->next = node;
+  node->prev = result.last;
 }
 
-}
\ No newline at end of file
+// 排序只读取节点，比较抛出异常时 list 保持原状
+template<class T, class Alloc>
+template<class Entry, class Compare>
+void list<T, Alloc>::sort_gathered_aux(Compare &comp) {
+  if (length < 2) return;
+  using entry_allocator = simpleAlloc<Entry>;
+  Entry *buf = entry_allocator::allocate(2 * length);
+  Entry *sorted;
+  try {
+    Entry *p = buf;
+    for (list_node *cur = node->next; cur != node; cur = cur->next) make_entry(*p++, cur);
+    sorted = sort_entries(buf, buf + length, length, comp);
+  } catch (std::exception &) {
+    entry_allocator::deallocate(buf, 2 * length);
+    throw;
+  }
+  list_node *prev = node;
+  for (size_type i = 0; i < length; ++i) {
+    if (i + 8 < length) _list_prefetch(entry_node(sorted[i + 8]));
+    list_node *cur = entry_node(sorted[i]);
+    prev->next = cur;
+    cur->prev = prev;
+    prev = cur;
+  }
+  prev->next = node;
+  node->prev = prev;
+  entry_allocator::deallocate(buf, 2 * length);
+}
+
+}
@@ -0,0 +1,301 @@
+/*
+    多生产者/多消费者（MPMC）有界队列，基于 Dmitry Vyukov 的序号数组队列
+    每个槽位（cell）携带一个序号 sequence：
+        sequence == pos          槽位空闲，可供第 pos 次入队使用
+        sequence == pos + 1      槽位已写入，可供第 pos 次出队读取
+    出队后序号置为 pos + capacity，即下一圈的空闲状态。
+    生产者与消费者分别以 CAS 争夺 enqueue_pos / dequeue_pos，二者各占一条 cache line。
+
+    提供三类接口：
+        try_*   立即返回，满/空时失败
+        spin_*  忙等直至成功，适合短暂的竞争
+        push/pop 先短暂自旋，之后在条件变量上睡眠
+    任何成功的入队/出队都会检查对端是否有睡眠的等待者，仅在确有等待者时才加锁唤醒，
+    因此三类接口可以混用。
+    以及批量的 try_push_n / try_pop_n：一次 CAS 认领连续的多个槽位。
+    槽位一经认领就必须发布，否则之后到达的出队者将永远等待：构造可能抛出异常时，
+    元素先在槽位外构造好，认领后再以不抛出异常的移动放入。
+    内存取自 _malloc_alloc：_default_alloc 的内存池并非线程安全。
+*/
+#pragma once
+
+#include "Allocator/allocator.h"
+#include "Allocator/construct.h"
+#include "SequenceContainers/SpscQueue/stl_spsc_queue.h"// _cache_line_size, _round_up_pow2
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace TinySTL {
+
+template<class T>
+struct _mpmc_queue_cell {
+  std::atomic<size_t> sequence;
+  alignas(T) unsigned char storage[sizeof(T)];
+
+  T *data() { return reinterpret_cast<T *>(storage); }
+};
+
+template<class T>
+class mpmc_queue {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ private:
+  using cell = _mpmc_queue_cell<T>;
+  using cell_allocator = simpleAlloc<cell, _malloc_alloc>;
+
+  // 阻塞接口在进入睡眠前的自旋次数
+  static constexpr int spin_limit = 64;
+
+ private:// data member
+  alignas(_cache_line_size) std::atomic<size_type> enqueue_pos;
+  alignas(_cache_line_size) std::atomic<size_type> dequeue_pos;
+  alignas(_cache_line_size) cell *buffer;// 构造后只读
+  size_type mask;
+  // 仅供阻塞接口使用
+  alignas(_cache_line_size) std::atomic<size_type> push_waiters;
+  std::atomic<size_type> pop_waiters;
+  std::mutex wait_mutex;
+  std::condition_variable not_full;
+  std::condition_variable not_empty;
+
+ private:// aux interface for enqueue && dequeue
+  // 认领一个可写槽位，失败（队列满）返回 nullptr
+  cell *claim_enqueue(size_type &pos) {
+    pos = enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell *c = buffer + (pos & mask);
+      size_type seq = c->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          return c;
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  // 认领一个可读槽位，失败（队列空）返回 nullptr
+  cell *claim_dequeue(size_type &pos) {
+    pos = dequeue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell *c = buffer + (pos & mask);
+      size_type seq = c->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          return c;
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  // 忙等直至认领成功
+  cell *spin_claim_enqueue(size_type &pos) {
+    cell *c;
+    for (int spins = 0; !(c = claim_enqueue(pos));) spin_pause(spins);
+    return c;
+  }
+  // 先短暂自旋，之后在条件变量上睡眠直至认领成功
+  cell *wait_claim_enqueue(size_type &pos) {
+    cell *c = nullptr;
+    for (int i = 0; i < spin_limit && !(c = claim_enqueue(pos)); ++i) {}
+    if (!c) {
+      std::unique_lock<std::mutex> lock(wait_mutex);
+      push_waiters.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      not_full.wait(lock, [&] { return (c = claim_enqueue(pos)) != nullptr; });
+      push_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return c;
+  }
+  // 以 claim 认领槽位后构造并发布；构造可能抛出异常时先在本地构造，再移入槽位
+  template<class... Args>
+  bool enqueue_aux(cell *(mpmc_queue::*claim)(size_type &), Args &&...args) {
+    if constexpr (!std::is_nothrow_constructible<value_type, Args &&...>::value) {
+      static_assert(std::is_nothrow_move_constructible<value_type>::value,
+                    "mpmc_queue requires a nothrow move constructor");
+      value_type temp(TinySTL::forward<Args>(args)...);
+      return enqueue_aux(claim, TinySTL::move(temp));
+    } else {
+      size_type pos;
+      cell *c = (this->*claim)(pos);
+      if (!c) return false;
+      TinySTL::construct(c->data(), TinySTL::forward<Args>(args)...);
+      publish_enqueue(c, pos);
+      wake(pop_waiters, not_empty);
+      return true;
+    }
+  }
+  void publish_enqueue(cell *c, size_type pos) {
+    c->sequence.store(pos + 1, std::memory_order_release);
+  }
+  void publish_dequeue(cell *c, size_type pos) {
+    c->sequence.store(pos + mask + 1, std::memory_order_release);
+  }
+  // 出队但不唤醒等待者（可在持有 wait_mutex 时调用）
+  bool pop_aux(value_type &out) {
+    size_type pos;
+    cell *c = claim_dequeue(pos);
+    if (!c) return false;
+    out = TinySTL::move(*c->data());
+    TinySTL::destroy(c->data());
+    publish_dequeue(c, pos);
+    return true;
+  }
+
+  // 自 pos 起连续满足 sequence == pos + i + offset 的槽位个数（至多 n 个）
+  size_type count_ready(size_type pos, size_type n, size_type offset) const {
+    size_type i = 0;
+    for (; i < n && i <= mask; ++i) {
+      size_type seq = buffer[(pos + i) & mask].sequence.load(std::memory_order_acquire);
+      if (seq != pos + i + offset) break;
+    }
+    return i;
+  }
+
+  // 唤醒阻塞接口中的等待者：seq_cst 栅栏与等待者对计数器的 seq_cst 自增配对，
+  // 保证二者至少一方能看到对方的修改，不会丢失唤醒
+  void wake(std::atomic<size_type> &waiters, std::condition_variable &cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(wait_mutex);
+      cv.notify_all();
+    }
+  }
+  static void spin_pause(int &spins) {
+    if (++spins > spin_limit) {
+      spins = 0;
+      std::this_thread::yield();
+    }
+  }
+
+ public:// ctor && dtor
+  // 实际容量为不小于 capacity 的 2 的幂（至少为 2）
+  explicit mpmc_queue(size_type capacity)
+      : enqueue_pos(0), dequeue_pos(0), push_waiters(0), pop_waiters(0) {
+    size_type cap = _round_up_pow2(capacity < 2 ? 2 : capacity);
+    buffer = cell_allocator::allocate(cap);
+    for (size_type i = 0; i < cap; ++i) new (&buffer[i].sequence) std::atomic<size_type>(i);
+    mask = cap - 1;
+  }
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+  ~mpmc_queue() {
+    size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+    size_type end = enqueue_pos.load(std::memory_order_relaxed);
+    for (; pos != end; ++pos) TinySTL::destroy(buffer[pos & mask].data());
+    cell_allocator::deallocate(buffer, mask + 1);
+  }
+
+ public:// getter
+  size_type capacity() const noexcept { return mask + 1; }
+  // 并发时仅为近似值
+  size_type size() const noexcept {
+    size_type tail = enqueue_pos.load(std::memory_order_acquire);
+    size_type head = dequeue_pos.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+ public:// try
+  template<class... Args>
+  bool try_emplace(Args &&...args) {
+    return enqueue_aux(&mpmc_queue::claim_enqueue, TinySTL::forward<Args>(args)...);
+  }
+  bool try_push(const value_type &value) { return try_emplace(value); }
+  bool try_push(value_type &&value) { return try_emplace(TinySTL::move(value)); }
+
+  bool try_pop(value_type &out) {
+    if (!pop_aux(out)) return false;
+    wake(push_waiters, not_full);
+    return true;
+  }
+
+  // 批量入队：先数出连续的空闲槽位，再以一次 CAS 整段认领；返回实际入队个数。
+  // 复制可能抛出异常时改为逐个入队，抛出异常时之前的元素已经入队
+  template<class InputIterator>
+  size_type try_push_n(InputIterator first, size_type n) {
+    if constexpr (!std::is_nothrow_constructible<value_type, decltype(*first)>::value) {
+      size_type i = 0;
+      for (; i < n && try_emplace(*first); ++i, ++first) {}
+      return i;
+    }
+    size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+    size_type count;
+    do {
+      count = count_ready(pos, n, 0);
+      if (count == 0) return 0;
+    } while (!enqueue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed));
+    for (size_type i = 0; i < count; ++i, ++first) {
+      cell *c = buffer + ((pos + i) & mask);
+      TinySTL::construct(c->data(), *first);
+      publish_enqueue(c, pos + i);
+    }
+    wake(pop_waiters, not_empty);
+    return count;
+  }
+
+  // 批量出队至 result，返回实际出队个数
+  template<class OutputIterator>
+  size_type try_pop_n(OutputIterator result, size_type n) {
+    size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+    size_type count;
+    do {
+      count = count_ready(pos, n, 1);
+      if (count == 0) return 0;
+    } while (!dequeue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed));
+    for (size_type i = 0; i < count; ++i, ++result) {
+      cell *c = buffer + ((pos + i) & mask);
+      *result = TinySTL::move(*c->data());
+      TinySTL::destroy(c->data());
+      publish_dequeue(c, pos + i);
+    }
+    wake(push_waiters, not_full);
+    return count;
+  }
+
+ public:// spinning
+  template<class... Args>
+  void spin_emplace(Args &&...args) {
+    enqueue_aux(&mpmc_queue::spin_claim_enqueue, TinySTL::forward<Args>(args)...);
+  }
+  void spin_push(const value_type &value) { spin_emplace(value); }
+  void spin_push(value_type &&value) { spin_emplace(TinySTL::move(value)); }
+  void spin_pop(value_type &out) {
+    for (int spins = 0; !try_pop(out);) spin_pause(spins);
+  }
+
+ public:// blocking
+  template<class... Args>
+  void emplace(Args &&...args) {
+    enqueue_aux(&mpmc_queue::wait_claim_enqueue, TinySTL::forward<Args>(args)...);
+  }
+  void push(const value_type &value) { emplace(value); }
+  void push(value_type &&value) { emplace(TinySTL::move(value)); }
+
+  void pop(value_type &out) {
+    bool done = false;
+    for (int i = 0; i < spin_limit && !(done = pop_aux(out)); ++i) {}
+    if (!done) {
+      std::unique_lock<std::mutex> lock(wait_mutex);
+      pop_waiters.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      not_empty.wait(lock, [&] { return pop_aux(out); });
+      pop_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+    wake(push_waiters, not_full);
+  }
+};
+
+}// namespace TinySTL
@@ -0,0 +1,558 @@
+/*
+    slist<T, CacheTail>: 单向链表
+        || head | -> node{next, T} -> node{next, T} -> ... -> nullptr
+    与 list 相比每个节点少一个 prev 指针，插入与删除也少两次指针写入；代价是只能前向遍历，
+    因此插入与删除都以“之后”的形式给出：insert_after / erase_after / splice_after，
+    before_begin() 指向不含元素的头节点，使得首元素之前也能插入。
+
+    CacheTail 为 true 时额外记录末节点，push_back / back 为 O(1)；
+    为 false 时不占用任何额外空间，也不提供 push_back。
+    节点与 list 一样经由 simpleAlloc 从内存池中配置。
+*/
+#pragma once
+
+#include "Algorithms/algobase/stl_algobase.h"
+#include "Allocator/allocator.h"
+#include "Allocator/construct.h"
+#include "Function/function_adapter.h"
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+
+namespace TinySTL {
+
+struct _slist_node_base {
+  _slist_node_base *next;
+};
+
+template<class T>
+struct _slist_node : _slist_node_base {
+  T data;
+};
+
+template<class T, class Ref, class Ptr>
+struct _slist_iterator {
+  using iterator = _slist_iterator<T, T &, T *>;
+  using const_iterator = _slist_iterator<T, const T &, const T *>;
+  using self = _slist_iterator;
+
+  using iterator_category = forward_iterator_tag;
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using difference_type = ptrdiff_t;
+  using base_ptr = _slist_node_base *;
+  using link_type = _slist_node<T> *;
+
+  // data member
+  base_ptr node;
+
+  // ctor
+  _slist_iterator() : node(nullptr) {}
+  explicit _slist_iterator(base_ptr x) : node(x) {}
+  _slist_iterator(const iterator &rhs) : node(rhs.node) {}
+
+  // dereference
+  reference operator*() const { return static_cast<link_type>(node)->data; }
+  pointer operator->() const { return &(operator*()); }
+
+  self &operator++() {
+    node = node->next;
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++*this;
+    return temp;
+  }
+};
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator==(const _slist_iterator<T, RefL, PtrL> &lhs,
+                       const _slist_iterator<T, RefR, PtrR> &rhs) {
+  return lhs.node == rhs.node;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR>
+inline bool operator!=(const _slist_iterator<T, RefL, PtrL> &lhs,
+                       const _slist_iterator<T, RefR, PtrR> &rhs) {
+  return lhs.node != rhs.node;
+}
+
+// 末节点缓存：不缓存时为空基类，不占空间
+template<bool CacheTail>
+struct _slist_tail {};
+
+template<>
+struct _slist_tail<true> {
+  _slist_node_base *tail;// 空链表时指向头节点
+};
+
+template<class T, bool CacheTail = false, class Alloc = simpleAlloc<T>>
+class slist : private _slist_tail<CacheTail> {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = _slist_iterator<T, T &, T *>;
+  using const_iterator = _slist_iterator<T, const T &, const T *>;
+
+  static constexpr bool caches_tail = CacheTail;
+
+ private:
+  using base_ptr = _slist_node_base *;
+  using list_node = _slist_node<T>;
+  using link_type = list_node *;
+  using list_node_allocator = simpleAlloc<list_node>;
+
+ private:// data member
+  _slist_node_base head;// 头节点，只有 next
+  size_type length;
+
+ private:// aux interface for node
+  template<class... Args>
+  link_type create_node(Args &&...args) {
+    link_type p = list_node_allocator::allocate();
+    try {
+      TinySTL::construct(&p->data, TinySTL::forward<Args>(args)...);
+    } catch (std::exception &) {
+      list_node_allocator::deallocate(p);
+      throw;
+    }
+    return p;
+  }
+  static void destroy_node(base_ptr p) {
+    TinySTL::destroy(&static_cast<link_type>(p)->data);
+    list_node_allocator::deallocate(static_cast<link_type>(p));
+  }
+  static const T &value(base_ptr p) { return static_cast<link_type>(p)->data; }
+
+ private:// aux interface for tail
+  void set_tail(base_ptr p) noexcept {
+    if constexpr (CacheTail) this->tail = p;
+  }
+  // 末节点为 from 时改为 to
+  void replace_tail(base_ptr from, base_ptr to) noexcept {
+    if constexpr (CacheTail)
+      if (this->tail == from) this->tail = to;
+  }
+  // 末节点（空链表时为头节点）：缓存时 O(1)，否则 O(n)
+  base_ptr last_node() noexcept {
+    if constexpr (CacheTail) {
+      return this->tail;
+    } else {
+      return find_last();
+    }
+  }
+  base_ptr find_last() noexcept {
+    base_ptr p = &head;
+    while (p->next) p = p->next;
+    return p;
+  }
+  // 整条链被重排之后重新确定末节点
+  void reset_tail() noexcept {
+    if constexpr (CacheTail) this->tail = find_last();
+  }
+
+ private:// aux interface
+  void empty_initialized() noexcept {
+    head.next = nullptr;
+    length = 0;
+    set_tail(&head);
+  }
+  // 把 node 链接到 pos 之后
+  base_ptr link_after(base_ptr pos, base_ptr node) noexcept {
+    node->next = pos->next;
+    pos->next = node;
+    replace_tail(pos, node);
+    ++length;
+    return node;
+  }
+  // 把 (before_first, before_last] 摘下并链接到 pos 之后，调用者负责维护 length 与 tail
+  static void transfer_after(base_ptr pos, base_ptr before_first, base_ptr before_last) noexcept {
+    if (pos == before_first || pos == before_last) return;
+    base_ptr first = before_first->next;
+    before_first->next = before_last->next;
+    before_last->next = pos->next;
+    pos->next = first;
+  }
+  // 以下插入函数均返回最后插入的节点，未插入时返回 pos
+  template<class Integer>
+  base_ptr insert_after_dispatch(base_ptr pos, Integer n, Integer value, true_type) {
+    return fill_insert_after(pos, static_cast<size_type>(n), static_cast<value_type>(value));
+  }
+  template<class InputIterator>
+  base_ptr insert_after_dispatch(base_ptr pos, InputIterator first, InputIterator last, false_type) {
+    for (; first != last; ++first) pos = link_after(pos, create_node(*first));
+    return pos;
+  }
+  base_ptr fill_insert_after(base_ptr pos, size_type n, const value_type &value) {
+    for (; n > 0; --n) pos = link_after(pos, create_node(value));
+    return pos;
+  }
+  // 将以 nullptr 结尾的有序链 b 归并入 a，相等时 a 的元素在前；
+  // 比较抛出异常时 a 仍持有两条链的全部节点
+  template<class Compare>
+  static void merge_into(base_ptr &a, base_ptr b, Compare &comp);
+
+ public:// ctor && dtor
+  slist() noexcept { empty_initialized(); }
+  explicit slist(size_type n, const value_type &value = value_type()) {
+    empty_initialized();
+    try {
+      fill_insert_after(&head, n, value);
+    } catch (std::exception &) {
+      clear();
+      throw;
+    }
+  }
+  template<class InputIterator>
+  slist(InputIterator first, InputIterator last) {
+    empty_initialized();
+    try {
+      insert_after_dispatch(&head, first, last, is_integral<InputIterator>());
+    } catch (std::exception &) {
+      clear();
+      throw;
+    }
+  }
+  slist(std::initializer_list<value_type> il) : slist(il.begin(), il.end()) {}
+  slist(const slist &rhs) : slist(rhs.begin(), rhs.end()) {}
+  slist(slist &&rhs) noexcept {
+    empty_initialized();
+    swap(rhs);
+  }
+  slist &operator=(const slist &rhs) {
+    // copy-and-swap
+    slist temp(rhs);
+    swap(temp);
+    return *this;
+  }
+  slist &operator=(slist &&rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+  ~slist() { clear(); }
+
+  // 头节点是成员，交换后末节点若指向对方的头节点需要改回自己的
+  void swap(slist &rhs) noexcept {
+    TinySTL::swap(head.next, rhs.head.next);
+    TinySTL::swap(length, rhs.length);
+    if constexpr (CacheTail) {
+      TinySTL::swap(this->tail, rhs.tail);
+      if (this->tail == &rhs.head) this->tail = &head;
+      if (rhs.tail == &head) rhs.tail = &rhs.head;
+    }
+  }
+
+ public:// getter
+  size_type size() const noexcept { return length; }
+  bool empty() const noexcept { return head.next == nullptr; }
+  const_iterator before_begin() const noexcept {
+    return const_iterator(const_cast<base_ptr>(&head));
+  }
+  const_iterator begin() const noexcept { return const_iterator(head.next); }
+  const_iterator end() const noexcept { return const_iterator(nullptr); }
+  const_iterator cbefore_begin() const noexcept { return before_begin(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reference front() const noexcept { return value(head.next); }
+  const_reference back() const noexcept {
+    static_assert(CacheTail, "slist::back requires CacheTail");
+    return value(this->tail);
+  }
+
+ public:// setter
+  iterator before_begin() noexcept { return iterator(&head); }
+  iterator begin() noexcept { return iterator(head.next); }
+  iterator end() noexcept { return iterator(nullptr); }
+  reference front() noexcept { return static_cast<link_type>(head.next)->data; }
+  reference back() noexcept {
+    static_assert(CacheTail, "slist::back requires CacheTail");
+    return static_cast<link_type>(this->tail)->data;
+  }
+
+  // pos 的前驱，O(n)；pos 为 end() 时得到末元素
+  iterator previous(const_iterator pos) noexcept {
+    if constexpr (CacheTail)
+      if (pos.node == nullptr) return iterator(this->tail);
+    base_ptr p = &head;
+    while (p->next != pos.node) p = p->next;
+    return iterator(p);
+  }
+
+ public:// emplace && insert
+  template<class... Args>
+  iterator emplace_after(const_iterator pos, Args &&...args) {
+    return iterator(link_after(pos.node, create_node(TinySTL::forward<Args>(args)...)));
+  }
+  iterator insert_after(const_iterator pos, const value_type &value) {
+    return emplace_after(pos, value);
+  }
+  iterator insert_after(const_iterator pos, value_type &&value) {
+    return emplace_after(pos, TinySTL::move(value));
+  }
+  // 返回最后插入的元素，未插入时返回 pos
+  iterator insert_after(const_iterator pos, size_type n, const value_type &value) {
+    return iterator(fill_insert_after(pos.node, n, value));
+  }
+  template<class InputIterator>
+  iterator insert_after(const_iterator pos, InputIterator first, InputIterator last) {
+    return iterator(insert_after_dispatch(pos.node, first, last, is_integral<InputIterator>()));
+  }
+  iterator insert_after(const_iterator pos, std::initializer_list<value_type> il) {
+    return insert_after(pos, il.begin(), il.end());
+  }
+
+  template<class... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace_after(before_begin(), TinySTL::forward<Args>(args)...);
+  }
+  void push_front(const value_type &value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(TinySTL::move(value)); }
+
+  template<class... Args>
+  reference emplace_back(Args &&...args) {
+    static_assert(CacheTail, "slist::push_back requires CacheTail");
+    return *emplace_after(const_iterator(this->tail), TinySTL::forward<Args>(args)...);
+  }
+  void push_back(const value_type &value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(TinySTL::move(value)); }
+
+ public:// erase
+  // 删除 pos 之后的元素，返回其后继
+  iterator erase_after(const_iterator pos) {
+    base_ptr victim = pos.node->next;
+    pos.node->next = victim->next;
+    replace_tail(victim, pos.node);
+    destroy_node(victim);
+    --length;
+    return iterator(pos.node->next);
+  }
+  // 删除 (before_first, last) 中的元素
+  iterator erase_after(const_iterator before_first, const_iterator last) {
+    base_ptr p = before_first.node;
+    base_ptr cur = p->next;
+    while (cur != last.node) {
+      base_ptr next = cur->next;
+      destroy_node(cur);
+      --length;
+      cur = next;
+    }
+    p->next = last.node;
+    if (last.node == nullptr) set_tail(p);
+    return iterator(last.node);
+  }
+  void pop_front() { erase_after(before_begin()); }
+  void clear() noexcept {
+    base_ptr cur = head.next;
+    while (cur) {
+      base_ptr next = cur->next;
+      destroy_node(cur);
+      cur = next;
+    }
+    empty_initialized();
+  }
+  void resize(size_type n, const value_type &value = value_type()) {
+    base_ptr p = &head;
+    for (size_type i = 0; i < n && p->next; ++i) p = p->next;
+    if (length >= n)
+      erase_after(const_iterator(p), end());
+    else
+      fill_insert_after(p, n - length, value);
+  }
+
+ public:// splice_after
+  // 把 rhs 的全部元素接到 pos 之后
+  void splice_after(const_iterator pos, slist &rhs) noexcept {
+    if (rhs.empty() || this == &rhs) return;
+    base_ptr last = rhs.last_node();
+    transfer_after(pos.node, &rhs.head, last);
+    replace_tail(pos.node, last);
+    length += rhs.length;
+    rhs.empty_initialized();
+  }
+  // 把 rhs 中 i 之后的那个元素移到 pos 之后
+  void splice_after(const_iterator pos, slist &rhs, const_iterator i) noexcept {
+    base_ptr moved = i.node->next;
+    if (pos.node == i.node || pos.node == moved) return;
+    rhs.replace_tail(moved, i.node);
+    transfer_after(pos.node, i.node, moved);
+    replace_tail(pos.node, moved);
+    --rhs.length;
+    ++length;
+  }
+  // 把 rhs 中 (before_first, last) 的元素移到 pos 之后，需要 O(区间长度) 找到区间末节点；
+  // 要求 pos 不在区间之中
+  void splice_after(const_iterator pos, slist &rhs, const_iterator before_first,
+                    const_iterator last) noexcept {
+    if (before_first.node->next == last.node) return;
+    size_type n = 0;
+    base_ptr before_last = before_first.node;
+    for (; before_last->next != last.node; before_last = before_last->next) ++n;
+    if (last.node == nullptr) rhs.set_tail(before_first.node);
+    transfer_after(pos.node, before_first.node, before_last);
+    replace_tail(pos.node, before_last);
+    rhs.length -= n;
+    length += n;
+  }
+
+ public:// list algorithm
+  template<class Predicate>
+  void remove_if(Predicate pred) {
+    base_ptr p = &head;
+    while (p->next) {
+      if (pred(value(p->next)))
+        erase_after(const_iterator(p));
+      else
+        p = p->next;
+    }
+  }
+  void remove(const value_type &val) {
+    remove_if([&val](const value_type &x) { return x == val; });
+  }
+  void unique() {
+    base_ptr p = head.next;
+    if (!p) return;
+    while (p->next) {
+      if (value(p) == value(p->next))
+        erase_after(const_iterator(p));
+      else
+        p = p->next;
+    }
+  }
+  void reverse() noexcept {
+    base_ptr cur = head.next;
+    set_tail(cur ? cur : &head);
+    base_ptr result = nullptr;
+    while (cur) {
+      base_ptr next = cur->next;
+      cur->next = result;
+      result = cur;
+      cur = next;
+    }
+    head.next = result;
+  }
+  void merge(slist &rhs) { merge(rhs, TinySTL::less<T>()); }
+  // 要求两者均已按 comp 有序；只改链接，不配置内存
+  template<class Compare>
+  void merge(slist &rhs, Compare comp) {
+    if (this == &rhs || rhs.empty()) return;
+    base_ptr b = rhs.head.next;
+    length += rhs.length;
+    rhs.empty_initialized();
+    try {
+      merge_into(head.next, b, comp);
+    } catch (std::exception &) {
+      reset_tail();
+      throw;
+    }
+    reset_tail();
+  }
+  // 自底向上的归并排序，直接在节点链接上进行，不配置任何内存
+  void sort() { sort(TinySTL::less<T>()); }
+  template<class Compare>
+  void sort(Compare comp);
+
+ public:// compare operator
+  bool operator==(const slist &rhs) const {
+    return length == rhs.length && TinySTL::equal(begin(), end(), rhs.begin());
+  }
+  bool operator!=(const slist &rhs) const { return !(*this == rhs); }
+};
+
+template<class T, bool CacheTail, class Alloc>
+template<class Compare>
+void slist<T, CacheTail, Alloc>::merge_into(base_ptr &a, base_ptr b, Compare &comp) {
+  _slist_node_base result;
+  base_ptr tail = &result;
+  base_ptr x = a;
+  try {
+    while (x && b) {
+      if (comp(value(b), value(x))) {
+        tail->next = b;
+        b = b->next;
+      } else {
+        tail->next = x;
+        x = x->next;
+      }
+      tail = tail->next;
+    }
+  } catch (std::exception &) {
+    // 已归并的部分之后依次接上两条链的剩余部分
+    tail->next = x;
+    while (tail->next) tail = tail->next;
+    tail->next = b;
+    a = result.next;
+    throw;
+  }
+  tail->next = x ? x : b;
+  a = result.next;
+}
+
+template<class T, bool CacheTail, class Alloc>
+template<class Compare>
+void slist<T, CacheTail, Alloc>::sort(Compare comp) {
+  if (!head.next || !head.next->next) return;
+  // counter[i] 为空或恰好含 2^i 个节点的有序链，越高层的元素在原序列中越靠前
+  base_ptr counter[64] = {};
+  int fill = 0;
+  base_ptr cur = head.next;
+  base_ptr result = nullptr;
+  try {
+    while (cur) {
+      base_ptr carry = cur;
+      cur = cur->next;
+      carry->next = nullptr;
+      int i = 0;
+      for (; i < fill && counter[i]; ++i) {
+        merge_into(counter[i], carry, comp);
+        carry = counter[i];
+        counter[i] = nullptr;
+      }
+      counter[i] = carry;
+      if (i == fill) ++fill;
+    }
+    for (int i = 0; i < fill; ++i) {
+      if (!counter[i]) continue;
+      base_ptr later = result;
+      result = nullptr;
+      merge_into(counter[i], later, comp);
+      result = counter[i];
+      counter[i] = nullptr;
+    }
+  } catch (std::exception &) {
+    // 比较抛出异常：merge_into 保证节点都留在 counter 中，把各段与未处理的节点重新串起来
+    base_ptr chain = cur;
+    if (result) {
+      base_ptr last = result;
+      while (last->next) last = last->next;
+      last->next = chain;
+      chain = result;
+    }
+    for (int i = 0; i < fill; ++i) {
+      if (!counter[i]) continue;
+      base_ptr last = counter[i];
+      while (last->next) last = last->next;
+      last->next = chain;
+      chain = counter[i];
+    }
+    head.next = chain;
+    reset_tail();
+    throw;
+  }
+  head.next = result;
+  reset_tail();
+}
+
+template<class T, bool CacheTail, class Alloc>
+inline void swap(slist<T, CacheTail, Alloc> &lhs, slist<T, CacheTail, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
@@ -0,0 +1,461 @@
+/*
+    soa_vector<Fields...>: struct-of-arrays 形式的 vector
+    vector<Record> 把一条记录的所有字段放在一起（array-of-structs），
+    只扫描其中一两个字段时，每条 cache line 中大部分字节都被浪费。
+    soa_vector 为每个字段维护一段独立、连续且按 cache line 对齐的缓冲区：
+        || field0 [0, cap) | pad || field1 [0, cap) | pad || ... ||
+    所有列位于同一块内存中，扩容时只做一次配置，再逐列 uninitialized_copy。
+    column<I>() 返回第 I 列的 span，可直接交给向量化的计算核心；
+    begin()/end() 返回按行访问的代理迭代器，解引用得到 tuple<Fields &...>
+*/
+#pragma once
+
+#include "Algorithms/algobase/stl_algobase.h"
+#include "Allocator/allocator.h"
+#include "Allocator/uninitialized.h"
+#include "Utils/span.h"
+#include <cstddef>
+#include <exception>
+#include <tuple>
+#include <utility>// index_sequence
+
+namespace TinySTL {
+
+template<bool IsConst, class... Fields>
+struct _soa_vector_iterator {
+  using iterator = _soa_vector_iterator<false, Fields...>;
+  using self = _soa_vector_iterator;
+  using columns_type = std::tuple<Fields *...>;
+
+  using iterator_category = random_access_iterator_tag;
+  using value_type = std::tuple<Fields...>;
+  using difference_type = ptrdiff_t;
+  // 按行访问时并不存在真实的 value_type 对象，因此没有可用的指针类型
+  using pointer = void;
+  using reference =
+      conditional_t<IsConst, std::tuple<const Fields &...>, std::tuple<Fields &...>>;
+
+  // data member
+  columns_type cols;// 各列首地址
+  difference_type index;
+
+  // ctor
+  _soa_vector_iterator() : cols(), index(0) {}
+  _soa_vector_iterator(const columns_type &c, difference_type i)
+      : cols(c), index(i) {}
+  _soa_vector_iterator(const iterator &rhs) : cols(rhs.cols), index(rhs.index) {}
+
+  // dereference
+  reference operator*() const { return deref(std::index_sequence_for<Fields...>()); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  // increasement && decreasement
+  self &operator++() {
+    ++index;
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++index;
+    return temp;
+  }
+  self &operator--() {
+    --index;
+    return *this;
+  }
+  self operator--(int) {
+    self temp = *this;
+    --index;
+    return temp;
+  }
+
+  // random access
+  self &operator+=(difference_type n) {
+    index += n;
+    return *this;
+  }
+  self &operator-=(difference_type n) {
+    index -= n;
+    return *this;
+  }
+  self operator+(difference_type n) const { return self(cols, index + n); }
+  self operator-(difference_type n) const { return self(cols, index - n); }
+
+ private:
+  template<size_t... I>
+  reference deref(std::index_sequence<I...>) const {
+    return reference(std::get<I>(cols)[index]...);
+  }
+};
+
+// 同一容器的迭代器共享列地址，因此只需比较下标
+template<bool L, bool R, class... Fields>
+inline bool operator==(const _soa_vector_iterator<L, Fields...> &lhs,
+                       const _soa_vector_iterator<R, Fields...> &rhs) {
+  return lhs.index == rhs.index;
+}
+
+template<bool L, bool R, class... Fields>
+inline bool operator!=(const _soa_vector_iterator<L, Fields...> &lhs,
+                       const _soa_vector_iterator<R, Fields...> &rhs) {
+  return lhs.index != rhs.index;
+}
+
+template<bool L, bool R, class... Fields>
+inline bool operator<(const _soa_vector_iterator<L, Fields...> &lhs,
+                      const _soa_vector_iterator<R, Fields...> &rhs) {
+  return lhs.index < rhs.index;
+}
+
+template<bool L, bool R, class... Fields>
+inline bool operator>(const _soa_vector_iterator<L, Fields...> &lhs,
+                      const _soa_vector_iterator<R, Fields...> &rhs) {
+  return rhs < lhs;
+}
+
+template<bool L, bool R, class... Fields>
+inline bool operator<=(const _soa_vector_iterator<L, Fields...> &lhs,
+                       const _soa_vector_iterator<R, Fields...> &rhs) {
+  return !(rhs < lhs);
+}
+
+template<bool L, bool R, class... Fields>
+inline bool operator>=(const _soa_vector_iterator<L, Fields...> &lhs,
+                       const _soa_vector_iterator<R, Fields...> &rhs) {
+  return !(lhs < rhs);
+}
+
+template<bool L, bool R, class... Fields>
+inline ptrdiff_t operator-(const _soa_vector_iterator<L, Fields...> &lhs,
+                           const _soa_vector_iterator<R, Fields...> &rhs) {
+  return lhs.index - rhs.index;
+}
+
+template<bool IsConst, class... Fields>
+inline _soa_vector_iterator<IsConst, Fields...> operator+(
+    ptrdiff_t n, const _soa_vector_iterator<IsConst, Fields...> &x) {
+  return x + n;
+}
+
+template<class... Fields>
+class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+ public:
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields &...>;
+  using const_reference = std::tuple<const Fields &...>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = _soa_vector_iterator<false, Fields...>;
+  using const_iterator = _soa_vector_iterator<true, Fields...>;
+  using reverse_iterator = __reverse_iterator<iterator>;
+  using const_reverse_iterator = __reverse_iterator<const_iterator>;
+
+  template<size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  static constexpr size_type field_count = sizeof...(Fields);
+  // 每一列的起始地址按 cache line 对齐
+  static constexpr size_type column_align = 64;
+
+ private:
+  using columns_type = std::tuple<Fields *...>;
+  using data_allocator = simpleAlloc<char>;
+  using field_indices = std::index_sequence_for<Fields...>;
+
+ private:// data member
+  char *storage;        // 所有列共用的一整块原始内存
+  size_type storage_size;// storage 的字节数
+  columns_type cols;    // 各列首地址，均位于 storage 内部
+  size_type len;
+  size_type cap;
+
+ private:// aux interface for layout
+  static size_type round_up(size_type n, size_type align) {
+    return (n + align - 1) & ~(align - 1);
+  }
+  // 按列依次排布所需的字节数（额外预留 column_align 用于对齐首地址）
+  static size_type bytes_for(size_type n) {
+    size_type bytes = 0;
+    ((bytes = round_up(bytes, column_align) + n * sizeof(Fields)), ...);
+    return bytes + column_align;
+  }
+  static columns_type layout(char *raw, size_type n) {
+    columns_type result;
+    layout_aux(result, raw, n, field_indices());
+    return result;
+  }
+  template<size_t... I>
+  static void layout_aux(columns_type &result, char *raw, size_type n,
+                         std::index_sequence<I...>) {
+    // 对齐的是绝对地址，而非相对 raw 的偏移
+    size_t addr = round_up(reinterpret_cast<size_t>(raw), column_align);
+    ((std::get<I>(result) = reinterpret_cast<field_type<I> *>(addr),
+      addr = round_up(addr + n * sizeof(field_type<I>), column_align)),
+     ...);
+  }
+
+ private:// aux interface for construct && destroy
+  // 将 [0, len) 逐列复制到 dst，某一列失败时析构已复制的列
+  template<size_t I>
+  void copy_columns(const columns_type &src, const columns_type &dst,
+                    size_type n) {
+    if constexpr (I < field_count) {
+      field_type<I> *first = std::get<I>(src);
+      TinySTL::uninitialized_copy(first, first + n, std::get<I>(dst));
+      try {
+        copy_columns<I + 1>(src, dst, n);
+      } catch (std::exception &) {
+        TinySTL::destroy(std::get<I>(dst), std::get<I>(dst) + n);
+        throw;
+      }
+    }
+  }
+  // 在 dst 的第 pos 行逐列构造一条记录
+  template<size_t I, class Row>
+  static void construct_row(const columns_type &dst, size_type pos,
+                            const Row &row) {
+    if constexpr (I < field_count) {
+      TinySTL::construct(std::get<I>(dst) + pos, std::get<I>(row));
+      try {
+        construct_row<I + 1>(dst, pos, row);
+      } catch (std::exception &) {
+        TinySTL::destroy(std::get<I>(dst) + pos);
+        throw;
+      }
+    }
+  }
+  template<size_t... I>
+  static void destroy_rows(const columns_type &c, size_type first,
+                           size_type last, std::index_sequence<I...>) {
+    (TinySTL::destroy(std::get<I>(c) + first, std::get<I>(c) + last), ...);
+  }
+
+  void deallocate() noexcept {
+    if (storage) data_allocator::deallocate(storage, storage_size);
+  }
+  void destroy_and_deallocate() noexcept {
+    destroy_rows(cols, 0, len, field_indices());
+    deallocate();
+  }
+
+  // 配置一块可容纳 n 行的新内存，并将现有元素逐列搬移过去
+  void reallocate(size_type n);
+
+  // 插入一行：容量不足时先在新内存中构造新行再释放旧内存，
+  // 因此 row 引用容器内已有元素也是安全的
+  template<class Row>
+  void append_row(const Row &row);
+
+ public:// ctor && dtor
+  soa_vector() noexcept
+      : storage(nullptr), storage_size(0), cols(), len(0), cap(0) {}
+  explicit soa_vector(size_type n) : soa_vector() { resize(n); }
+  soa_vector(const soa_vector &rhs) : soa_vector() {
+    if (rhs.len) {
+      reserve(rhs.len);
+      copy_columns<0>(rhs.cols, cols, rhs.len);
+      len = rhs.len;
+    }
+  }
+  soa_vector(soa_vector &&rhs) noexcept
+      : storage(rhs.storage),
+        storage_size(rhs.storage_size),
+        cols(rhs.cols),
+        len(rhs.len),
+        cap(rhs.cap) {
+    rhs.storage = nullptr;
+    rhs.storage_size = rhs.len = rhs.cap = 0;
+    rhs.cols = columns_type();
+  }
+  ~soa_vector() { destroy_and_deallocate(); }
+
+  soa_vector &operator=(const soa_vector &rhs) {
+    // copy-and-swap
+    soa_vector temp(rhs);
+    swap(temp);
+    return *this;
+  }
+  soa_vector &operator=(soa_vector &&rhs) noexcept {
+    if (this != &rhs) {
+      soa_vector temp(TinySTL::move(rhs));
+      swap(temp);
+    }
+    return *this;
+  }
+
+ public:// swap
+  void swap(soa_vector &rhs) noexcept {
+    TinySTL::swap(storage, rhs.storage);
+    TinySTL::swap(storage_size, rhs.storage_size);
+    TinySTL::swap(cols, rhs.cols);
+    TinySTL::swap(len, rhs.len);
+    TinySTL::swap(cap, rhs.cap);
+  }
+
+ public:// getter
+  size_type size() const noexcept { return len; }
+  size_type capacity() const noexcept { return cap; }
+  bool empty() const noexcept { return len == 0; }
+  const_iterator begin() const noexcept { return const_iterator(cols, 0); }
+  const_iterator end() const noexcept {
+    return const_iterator(cols, static_cast<difference_type>(len));
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+  const_reference operator[](size_type n) const noexcept {
+    return *(begin() + static_cast<difference_type>(n));
+  }
+  const_reference front() const noexcept { return *begin(); }
+  const_reference back() const noexcept { return *(end() - 1); }
+
+  // 第 I 列的只读视图
+  template<size_t I>
+  span<const field_type<I>> column() const noexcept {
+    return span<const field_type<I>>(std::get<I>(cols), len);
+  }
+  template<size_t I>
+  const field_type<I> *data() const noexcept {
+    return std::get<I>(cols);
+  }
+
+ public:// setter
+  iterator begin() noexcept { return iterator(cols, 0); }
+  iterator end() noexcept {
+    return iterator(cols, static_cast<difference_type>(len));
+  }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  reference operator[](size_type n) noexcept {
+    return *(begin() + static_cast<difference_type>(n));
+  }
+  reference front() noexcept { return *begin(); }
+  reference back() noexcept { return *(end() - 1); }
+
+  template<size_t I>
+  span<field_type<I>> column() noexcept {
+    return span<field_type<I>>(std::get<I>(cols), len);
+  }
+  template<size_t I>
+  field_type<I> *data() noexcept {
+    return std::get<I>(cols);
+  }
+
+ public:// interface for size and capacity
+  void reserve(size_type n) {
+    if (n > cap) reallocate(n);
+  }
+  void resize(size_type new_size) {
+    resize(new_size, Fields()...);
+  }
+  void resize(size_type new_size, const Fields &...vals);
+  void shrink_to_fit() {
+    if (len < cap) reallocate(len);
+  }
+
+ public:// push && pop
+  void push_back(const Fields &...vals) {
+    append_row(std::forward_as_tuple(vals...));
+  }
+  void push_back(const value_type &row) { append_row(row); }
+  void pop_back() {
+    --len;
+    destroy_rows(cols, len, len + 1, field_indices());
+  }
+
+ public:// erase
+  void clear() noexcept {
+    destroy_rows(cols, 0, len, field_indices());
+    len = 0;
+  }
+};
+
+template<class... Fields>
+void soa_vector<Fields...>::reallocate(size_type n) {
+  const size_type new_size = bytes_for(n);
+  char *new_storage = data_allocator::allocate(new_size);
+  columns_type new_cols = layout(new_storage, n);
+  try {
+    copy_columns<0>(cols, new_cols, len);
+  } catch (std::exception &) {
+    data_allocator::deallocate(new_storage, new_size);
+    throw;
+  }
+  destroy_and_deallocate();
+  storage = new_storage;
+  storage_size = new_size;
+  cols = new_cols;
+  cap = n;
+}
+
+template<class... Fields>
+template<class Row>
+void soa_vector<Fields...>::append_row(const Row &row) {
+  if (len != cap) {
+    construct_row<0>(cols, len, row);
+    ++len;
+    return;
+  }
+  const size_type new_cap = cap ? cap * 2 : 8;
+  const size_type new_size = bytes_for(new_cap);
+  char *new_storage = data_allocator::allocate(new_size);
+  columns_type new_cols = layout(new_storage, new_cap);
+  try {
+    construct_row<0>(new_cols, len, row);
+    try {
+      copy_columns<0>(cols, new_cols, len);
+    } catch (std::exception &) {
+      destroy_rows(new_cols, len, len + 1, field_indices());
+      throw;
+    }
+  } catch (std::exception &) {
+    data_allocator::deallocate(new_storage, new_size);
+    throw;
+  }
+  destroy_and_deallocate();
+  storage = new_storage;
+  storage_size = new_size;
+  cols = new_cols;
+  cap = new_cap;
+  ++len;
+}
+
+template<class... Fields>
+void soa_vector<Fields...>::resize(size_type new_size, const Fields &...vals) {
+  if (new_size < len) {
+    destroy_rows(cols, new_size, len, field_indices());
+    len = new_size;
+    return;
+  }
+  reserve(new_size);
+  const auto row = std::forward_as_tuple(vals...);
+  for (; len < new_size; ++len) construct_row<0>(cols, len, row);
+}
+
+template<class... Fields>
+inline bool operator==(const soa_vector<Fields...> &lhs,
+                       const soa_vector<Fields...> &rhs) {
+  return lhs.size() == rhs.size() &&
+         TinySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<class... Fields>
+inline bool operator!=(const soa_vector<Fields...> &lhs,
+                       const soa_vector<Fields...> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<class... Fields>
+inline void swap(soa_vector<Fields...> &lhs,
+                 soa_vector<Fields...> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
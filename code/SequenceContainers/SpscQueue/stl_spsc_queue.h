@@ -0,0 +1,314 @@
+/*
+    单生产者/单消费者（SPSC）无锁队列
+    spsc_queue：容量固定的环形缓冲区，容量向上取整为 2 的幂，下标以掩码取模；
+    unbounded_spsc_queue：容量不限，仿照 deque 以固定大小的缓冲区为节点串接而成。
+
+    head 只由消费者写入，tail 只由生产者写入，二者各占一条 cache line，
+    避免伪共享（false sharing）；双方各自缓存对方的下标，仅在看似满/空时才重新读取。
+    下标单调递增，tail - head 即为元素个数。
+    内存统一取自 _malloc_alloc：_default_alloc 的内存池并非线程安全。
+*/
+#pragma once
+
+#include "Allocator/allocator.h"
+#include "Allocator/construct.h"
+#include "SequenceContainers/Deque/deque_iterator.h"// _deque_buf_size
+#include <atomic>
+#include <cstddef>
+#include <exception>
+
+namespace TinySTL {
+
+// 避免伪共享所需的对齐
+constexpr size_t _cache_line_size = 64;
+
+// 不小于 n 的最小的 2 的幂
+inline size_t _round_up_pow2(size_t n) {
+  size_t result = 1;
+  while (result < n) result <<= 1;
+  return result;
+}
+
+template<class T, class Alloc = simpleAlloc<T, _malloc_alloc>>
+class spsc_queue {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ private:// data member
+  // 消费者独占
+  alignas(_cache_line_size) std::atomic<size_type> head;// 下一个出队位置
+  size_type cached_tail;                                 // 消费者所见的 tail
+  // 生产者独占
+  alignas(_cache_line_size) std::atomic<size_type> tail;// 下一个入队位置
+  size_type cached_head;                                 // 生产者所见的 head
+  // 构造后只读，双方共享
+  alignas(_cache_line_size) value_type *buffer;
+  size_type mask;
+
+ private:// aux interface
+  // 生产者端：剩余空位，缓存的值不足 n 时才刷新 cached_head
+  size_type free_slots(size_type t, size_type n) {
+    size_type cap = mask + 1;
+    if (cap - (t - cached_head) < n) cached_head = head.load(std::memory_order_acquire);
+    return cap - (t - cached_head);
+  }
+  // 消费者端：可读元素个数，缓存的值不足 n 时才刷新 cached_tail
+  size_type ready_slots(size_type h, size_type n) {
+    if (cached_tail - h < n) cached_tail = tail.load(std::memory_order_acquire);
+    return cached_tail - h;
+  }
+
+ public:// ctor && dtor
+  // 实际容量为不小于 capacity 的 2 的幂
+  explicit spsc_queue(size_type capacity)
+      : head(0), cached_tail(0), tail(0), cached_head(0) {
+    size_type cap = _round_up_pow2(capacity ? capacity : 1);
+    buffer = Alloc::allocate(cap);
+    mask = cap - 1;
+  }
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+  ~spsc_queue() {
+    size_type h = head.load(std::memory_order_relaxed);
+    size_type t = tail.load(std::memory_order_relaxed);
+    for (; h != t; ++h) TinySTL::destroy(buffer + (h & mask));
+    Alloc::deallocate(buffer, mask + 1);
+  }
+
+ public:// getter
+  size_type capacity() const noexcept { return mask + 1; }
+  // 并发时仅为近似值
+  size_type size() const noexcept {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+ public:// producer
+  template<class... Args>
+  bool try_emplace(Args &&...args) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    if (free_slots(t, 1) == 0) return false;
+    TinySTL::construct(buffer + (t & mask), TinySTL::forward<Args>(args)...);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_push(const value_type &value) { return try_emplace(value); }
+  bool try_push(value_type &&value) { return try_emplace(TinySTL::move(value)); }
+
+  // 批量入队，返回实际入队的个数；只发布一次 tail
+  template<class InputIterator>
+  size_type try_push_n(InputIterator first, size_type n) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    size_type free = free_slots(t, n);
+    if (n > free) n = free;
+    size_type i = 0;
+    try {
+      for (; i < n; ++i, ++first) TinySTL::construct(buffer + ((t + i) & mask), *first);
+    } catch (std::exception &) {
+      // 析构已构造的元素，一个也不发布
+      for (size_type j = 0; j < i; ++j) TinySTL::destroy(buffer + ((t + j) & mask));
+      throw;
+    }
+    if (n) tail.store(t + n, std::memory_order_release);
+    return n;
+  }
+
+ public:// consumer
+  bool try_pop(value_type &out) {
+    size_type h = head.load(std::memory_order_relaxed);
+    if (ready_slots(h, 1) == 0) return false;
+    value_type *p = buffer + (h & mask);
+    out = TinySTL::move(*p);
+    TinySTL::destroy(p);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 批量出队至 result，返回实际出队的个数；只发布一次 head
+  template<class OutputIterator>
+  size_type try_pop_n(OutputIterator result, size_type n) {
+    size_type h = head.load(std::memory_order_relaxed);
+    size_type ready = ready_slots(h, n);
+    if (n > ready) n = ready;
+    for (size_type i = 0; i < n; ++i, ++result) {
+      value_type *p = buffer + ((h + i) & mask);
+      *result = TinySTL::move(*p);
+      TinySTL::destroy(p);
+    }
+    if (n) head.store(h + n, std::memory_order_release);
+    return n;
+  }
+
+  // 队首元素，仅消费者可调用；队列为空时返回 nullptr
+  value_type *front() {
+    size_type h = head.load(std::memory_order_relaxed);
+    return ready_slots(h, 1) ? buffer + (h & mask) : nullptr;
+  }
+};
+
+template<class T>
+struct _spsc_queue_node {
+  T *buffer;
+  std::atomic<_spsc_queue_node *> next;
+};
+
+// BufSiz 的含义与 deque 相同：每个缓冲区容纳的元素个数，0 表示采用预设值
+template<class T, size_t BufSiz = 0>
+class unbounded_spsc_queue {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ private:
+  using node = _spsc_queue_node<T>;
+  using node_allocator = simpleAlloc<node, _malloc_alloc>;
+  using data_allocator = simpleAlloc<T, _malloc_alloc>;
+
+  static constexpr size_type buffer_size() {
+    return _deque_buf_size(BufSiz, sizeof(T));
+  }
+
+ private:// data member
+  // 消费者独占
+  alignas(_cache_line_size) std::atomic<size_type> head;
+  node *head_node;
+  size_type cached_tail;
+  // 生产者独占
+  alignas(_cache_line_size) std::atomic<size_type> tail;
+  node *tail_node;
+  // 消费者归还、生产者取用的备用节点，稳态下不再配置内存
+  alignas(_cache_line_size) std::atomic<node *> spare;
+
+ private:// aux interface for node
+  static node *create_node() {
+    node *p = node_allocator::allocate();
+    try {
+      p->buffer = data_allocator::allocate(buffer_size());
+    } catch (std::exception &) {
+      node_allocator::deallocate(p);
+      throw;
+    }
+    new (&p->next) std::atomic<node *>(nullptr);
+    return p;
+  }
+  static void destroy_node(node *p) {
+    data_allocator::deallocate(p->buffer, buffer_size());
+    node_allocator::deallocate(p);
+  }
+  // 生产者：优先复用备用节点
+  node *acquire_node() {
+    node *p = spare.exchange(nullptr, std::memory_order_acquire);
+    if (!p) return create_node();
+    p->next.store(nullptr, std::memory_order_relaxed);
+    return p;
+  }
+  // 消费者：归还节点，备用位已占用则直接释放
+  void release_node(node *p) {
+    node *expected = nullptr;
+    if (!spare.compare_exchange_strong(expected, p, std::memory_order_release,
+                                       std::memory_order_relaxed))
+      destroy_node(p);
+  }
+
+  // 生产者：返回下标 t 所在的缓冲区位置，跨越缓冲区时 cur 前进到下一节点。
+  // 新节点随 tail 的 release 一并发布；构造失败时已串接的节点留在链尾，下次直接复用
+  value_type *slot_for_push(node *&cur, size_type t) {
+    size_type offset = t & (buffer_size() - 1);
+    if (offset == 0 && t != 0) {
+      node *p = cur->next.load(std::memory_order_relaxed);
+      if (!p) {
+        p = acquire_node();
+        cur->next.store(p, std::memory_order_relaxed);
+      }
+      cur = p;
+    }
+    return cur->buffer + offset;
+  }
+  // 消费者：返回下标 h 所在的缓冲区位置，必要时释放已读完的节点
+  value_type *slot_for_pop(size_type h) {
+    size_type offset = h & (buffer_size() - 1);
+    if (offset == 0 && h != 0) {
+      node *old = head_node;
+      head_node = old->next.load(std::memory_order_relaxed);
+      release_node(old);
+    }
+    return head_node->buffer + offset;
+  }
+
+ public:// ctor && dtor
+  unbounded_spsc_queue()
+      : head(0), head_node(nullptr), cached_tail(0), tail(0), tail_node(nullptr),
+        spare(nullptr) {
+    head_node = tail_node = create_node();
+  }
+  unbounded_spsc_queue(const unbounded_spsc_queue &) = delete;
+  unbounded_spsc_queue &operator=(const unbounded_spsc_queue &) = delete;
+  ~unbounded_spsc_queue() {
+    size_type h = head.load(std::memory_order_relaxed);
+    size_type t = tail.load(std::memory_order_relaxed);
+    for (; h != t; ++h) TinySTL::destroy(slot_for_pop(h));
+    // slot_for_pop 已释放读完的节点，剩下 head_node 至链尾
+    for (node *p = head_node; p;) {
+      node *next = p->next.load(std::memory_order_relaxed);
+      destroy_node(p);
+      p = next;
+    }
+    if (node *p = spare.load(std::memory_order_relaxed)) destroy_node(p);
+  }
+
+ public:// getter
+  size_type size() const noexcept {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+ public:// producer
+  template<class... Args>
+  void emplace(Args &&...args) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    node *cur = tail_node;
+    TinySTL::construct(slot_for_push(cur, t), TinySTL::forward<Args>(args)...);
+    tail_node = cur;
+    tail.store(t + 1, std::memory_order_release);
+  }
+  void push(const value_type &value) { emplace(value); }
+  void push(value_type &&value) { emplace(TinySTL::move(value)); }
+
+  // 批量入队，只发布一次 tail
+  template<class InputIterator>
+  void push_n(InputIterator first, size_type n) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    node *cur = tail_node;
+    size_type i = 0;
+    try {
+      for (; i < n; ++i, ++first) TinySTL::construct(slot_for_push(cur, t + i), *first);
+    } catch (std::exception &) {
+      // 析构已构造的元素，一个也不发布
+      node *p = tail_node;
+      for (size_type j = 0; j < i; ++j) TinySTL::destroy(slot_for_push(p, t + j));
+      throw;
+    }
+    tail_node = cur;
+    if (n) tail.store(t + n, std::memory_order_release);
+  }
+
+ public:// consumer
+  bool try_pop(value_type &out) { return try_pop_n(&out, 1) == 1; }
+
+  template<class OutputIterator>
+  size_type try_pop_n(OutputIterator result, size_type n) {
+    size_type h = head.load(std::memory_order_relaxed);
+    if (cached_tail - h < n) cached_tail = tail.load(std::memory_order_acquire);
+    if (n > cached_tail - h) n = cached_tail - h;
+    for (size_type i = 0; i < n; ++i, ++result) {
+      value_type *p = slot_for_pop(h + i);
+      *result = TinySTL::move(*p);
+      TinySTL::destroy(p);
+    }
+    if (n) head.store(h + n, std::memory_order_release);
+    return n;
+  }
+};
+
+}// namespace TinySTL
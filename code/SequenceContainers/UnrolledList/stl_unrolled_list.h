@@ -0,0 +1,543 @@
+/*
+    unrolled_list<T, K>: 展开链表（unrolled linked list）
+    每个节点保存一个至多 K 个元素的小数组：
+        || header | node{count, T[K]} <-> node{count, T[K]} <-> ... ||
+    与 list 相比，链接指针与配置次数均摊到 K 个元素上，顺序遍历时大部分访问落在同一数组内。
+
+    插入：节点未满时在节点内平移元素；节点已满时对半分裂。
+    删除：节点内平移元素；元素个数低于 K/4 时与相邻节点合并（合并后不超过 K）。
+    迭代器由（节点，下标）组成：插入与删除只会使同一节点（及其分裂/合并的邻居）中的迭代器失效，
+    其余节点中的迭代器保持有效。
+    splice 在节点边界处切开并重新链接整段节点，不逐个搬移元素；
+    merge 以流式方式归并两侧元素，边归并边释放已取空的节点。
+*/
+#pragma once
+
+#include "Algorithms/algobase/stl_algobase.h"
+#include "Allocator/allocator.h"
+#include "Allocator/construct.h"
+#include "Function/function_adapter.h"
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+
+namespace TinySTL {
+
+// 预设每个节点约占 256 字节，至少容纳 4 个元素
+constexpr size_t _unrolled_list_node_capacity(size_t sz) {
+  return sz <= 240 / 4 ? 240 / sz : size_t(4);
+}
+
+struct _unrolled_list_node_base {
+  _unrolled_list_node_base *next;
+  _unrolled_list_node_base *prev;
+  size_t count;// 哨兵节点恒为 0
+};
+
+template<class T, size_t K>
+struct _unrolled_list_node : _unrolled_list_node_base {
+  alignas(T) unsigned char storage[sizeof(T) * K];
+
+  T *data() { return reinterpret_cast<T *>(storage); }
+};
+
+template<class T, class Ref, class Ptr, size_t K>
+struct _unrolled_list_iterator {
+  using iterator = _unrolled_list_iterator<T, T &, T *, K>;
+  using const_iterator = _unrolled_list_iterator<T, const T &, const T *, K>;
+  using self = _unrolled_list_iterator;
+
+  using iterator_category = bidirectional_iterator_tag;
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using difference_type = ptrdiff_t;
+  using base_ptr = _unrolled_list_node_base *;
+  using link_type = _unrolled_list_node<T, K> *;
+
+  // data member
+  base_ptr node;
+  size_t idx;
+
+  // ctor
+  _unrolled_list_iterator() : node(nullptr), idx(0) {}
+  _unrolled_list_iterator(base_ptr x, size_t i) : node(x), idx(i) {}
+  _unrolled_list_iterator(const iterator &rhs) : node(rhs.node), idx(rhs.idx) {}
+
+  // dereference
+  reference operator*() const { return static_cast<link_type>(node)->data()[idx]; }
+  pointer operator->() const { return &(operator*()); }
+
+  // ++i：哨兵节点的 count 为 0，越过末节点后恰好得到 end()
+  self &operator++() {
+    if (++idx == node->count) {
+      node = node->next;
+      idx = 0;
+    }
+    return *this;
+  }
+  self operator++(int) {
+    self temp = *this;
+    ++*this;
+    return temp;
+  }
+  self &operator--() {
+    if (idx == 0) {
+      node = node->prev;
+      idx = node->count;
+    }
+    --idx;
+    return *this;
+  }
+  self operator--(int) {
+    self temp = *this;
+    --*this;
+    return temp;
+  }
+};
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t K>
+inline bool operator==(const _unrolled_list_iterator<T, RefL, PtrL, K> &lhs,
+                       const _unrolled_list_iterator<T, RefR, PtrR, K> &rhs) {
+  return lhs.node == rhs.node && lhs.idx == rhs.idx;
+}
+
+template<class T, class RefL, class PtrL, class RefR, class PtrR, size_t K>
+inline bool operator!=(const _unrolled_list_iterator<T, RefL, PtrL, K> &lhs,
+                       const _unrolled_list_iterator<T, RefR, PtrR, K> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<class T, size_t K = _unrolled_list_node_capacity(sizeof(T)),
+         class Alloc = simpleAlloc<T>>
+class unrolled_list {
+  static_assert(K >= 2, "unrolled_list nodes must hold at least two elements");
+
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = _unrolled_list_iterator<T, T &, T *, K>;
+  using const_iterator = _unrolled_list_iterator<T, const T &, const T *, K>;
+
+  static constexpr size_type node_capacity = K;
+
+ private:
+  using base_ptr = _unrolled_list_node_base *;
+  using node_type = _unrolled_list_node<T, K>;
+  using link_type = node_type *;
+  using node_allocator = simpleAlloc<node_type>;
+  using header_allocator = simpleAlloc<_unrolled_list_node_base>;
+
+ private:// data member
+  base_ptr header;// 哨兵节点
+  size_type length;
+
+ private:// aux interface for node
+  static T *data(base_ptr p) { return static_cast<link_type>(p)->data(); }
+
+  // 在 pos 之前链入一个新的空节点
+  base_ptr create_node(base_ptr pos) {
+    base_ptr p = node_allocator::allocate();
+    p->count = 0;
+    p->next = pos;
+    p->prev = pos->prev;
+    pos->prev->next = p;
+    pos->prev = p;
+    return p;
+  }
+  // 摘下并释放节点，要求其中元素已析构或已搬走
+  void free_node(base_ptr p) {
+    p->prev->next = p->next;
+    p->next->prev = p->prev;
+    node_allocator::deallocate(static_cast<link_type>(p));
+  }
+  // 把 [first, last) 搬移到未初始化的 dest 处，并析构源元素
+  static void relocate(T *first, T *last, T *dest) {
+    for (; first != last; ++first, ++dest) {
+      TinySTL::construct(dest, TinySTL::move(*first));
+      TinySTL::destroy(first);
+    }
+  }
+  // 节点 p 的 [idx, count) 移入 p 之后的新节点，返回新节点
+  base_ptr split_node(base_ptr p, size_type idx) {
+    base_ptr q = create_node(p->next);
+    relocate(data(p) + idx, data(p) + p->count, data(q));
+    q->count = p->count - idx;
+    p->count = idx;
+    return q;
+  }
+  // p 与其后继的元素总数不超过 K 时，把后继并入 p
+  bool try_merge_next(base_ptr p) {
+    base_ptr q = p->next;
+    if (p == header || q == header || p->count + q->count > K) return false;
+    relocate(data(q), data(q) + q->count, data(p) + p->count);
+    p->count += q->count;
+    free_node(q);
+    return true;
+  }
+  // 使 pos 落在节点边界上，返回应在其之前链入节点的位置；
+  // fix 指向的迭代器若位于被移走的部分，则随之修正
+  base_ptr split_at(iterator pos, iterator *fix1 = nullptr, iterator *fix2 = nullptr) {
+    if (pos.idx == 0) return pos.node;
+    base_ptr q = split_node(pos.node, pos.idx);
+    for (iterator *f : {fix1, fix2}) {
+      if (f && f->node == pos.node && f->idx >= pos.idx) {
+        f->node = q;
+        f->idx -= pos.idx;
+      }
+    }
+    return q;
+  }
+  // 把节点段 [first, last] 从所在链表摘下，链入 pos 之前
+  static void transfer_nodes(base_ptr pos, base_ptr first, base_ptr last) {
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+    first->prev = pos->prev;
+    last->next = pos;
+    pos->prev->next = first;
+    pos->prev = last;
+  }
+
+ private:// aux interface
+  void empty_initialized() {
+    header = header_allocator::allocate();
+    header->next = header->prev = header;
+    header->count = 0;
+    length = 0;
+  }
+  template<class Integer>
+  void initialize_dispatch(Integer n, Integer value, true_type) {
+    for (; n > 0; --n) push_back(static_cast<value_type>(value));
+  }
+  template<class InputIterator>
+  void initialize_dispatch(InputIterator first, InputIterator last, false_type) {
+    for (; first != last; ++first) push_back(*first);
+  }
+
+ public:// ctor && dtor
+  unrolled_list() { empty_initialized(); }
+  explicit unrolled_list(size_type n, const value_type &value = value_type()) {
+    empty_initialized();
+    try {
+      for (; n > 0; --n) push_back(value);
+    } catch (std::exception &) {
+      clear();
+      header_allocator::deallocate(header);
+      throw;
+    }
+  }
+  template<class InputIterator>
+  unrolled_list(InputIterator first, InputIterator last) {
+    empty_initialized();
+    try {
+      initialize_dispatch(first, last, is_integral<InputIterator>());
+    } catch (std::exception &) {
+      clear();
+      header_allocator::deallocate(header);
+      throw;
+    }
+  }
+  unrolled_list(std::initializer_list<value_type> il) : unrolled_list(il.begin(), il.end()) {}
+  unrolled_list(const unrolled_list &rhs) : unrolled_list(rhs.begin(), rhs.end()) {}
+  unrolled_list(unrolled_list &&rhs) noexcept {
+    empty_initialized();
+    swap(rhs);
+  }
+  unrolled_list &operator=(const unrolled_list &rhs) {
+    // copy-and-swap
+    unrolled_list temp(rhs);
+    swap(temp);
+    return *this;
+  }
+  unrolled_list &operator=(unrolled_list &&rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+  ~unrolled_list() {
+    clear();
+    header_allocator::deallocate(header);
+  }
+
+  void swap(unrolled_list &rhs) noexcept {
+    TinySTL::swap(header, rhs.header);
+    TinySTL::swap(length, rhs.length);
+  }
+
+ public:// getter
+  size_type size() const noexcept { return length; }
+  bool empty() const noexcept { return length == 0; }
+  const_iterator begin() const noexcept { return const_iterator(header->next, 0); }
+  const_iterator end() const noexcept { return const_iterator(header, 0); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reference front() const noexcept { return data(header->next)[0]; }
+  const_reference back() const noexcept { return data(header->prev)[header->prev->count - 1]; }
+
+ public:// setter
+  iterator begin() noexcept { return iterator(header->next, 0); }
+  iterator end() noexcept { return iterator(header, 0); }
+  reference front() noexcept { return data(header->next)[0]; }
+  reference back() noexcept { return data(header->prev)[header->prev->count - 1]; }
+
+ public:// emplace && insert
+  template<class... Args>
+  iterator emplace(iterator pos, Args &&...args);
+  template<class... Args>
+  void emplace_back(Args &&...args) { emplace(end(), TinySTL::forward<Args>(args)...); }
+  template<class... Args>
+  void emplace_front(Args &&...args) { emplace(begin(), TinySTL::forward<Args>(args)...); }
+  iterator insert(iterator pos, const value_type &value) { return emplace(pos, value); }
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, TinySTL::move(value));
+  }
+  void push_back(const value_type &value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(TinySTL::move(value)); }
+  void push_front(const value_type &value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(TinySTL::move(value)); }
+
+ public:// erase
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  void pop_front() { erase(begin()); }
+  void pop_back() { erase(iterator(header->prev, header->prev->count - 1)); }
+  void clear() noexcept;
+
+ public:// list algorithm
+  // 整段链入节点，O(节点数)；x 中的元素不被搬移（切分处的节点除外）
+  void splice(iterator pos, unrolled_list &x);
+  void splice(iterator pos, unrolled_list &x, iterator i) {
+    iterator j = i;
+    ++j;
+    // 链入原位，无需搬动
+    if (&x == this && (pos == i || pos == j)) return;
+    splice(pos, x, i, j);
+  }
+  // 要求 pos 不在 [first, last) 之中
+  void splice(iterator pos, unrolled_list &x, iterator first, iterator last);
+  void merge(unrolled_list &x) { merge(x, TinySTL::less<T>()); }
+  template<class Compare>
+  void merge(unrolled_list &x, Compare comp);
+  template<class Predicate>
+  void remove_if(Predicate pred);
+  void remove(const value_type &value) {
+    remove_if([&value](const value_type &x) { return x == value; });
+  }
+
+ public:// compare operator
+  bool operator==(const unrolled_list &rhs) const {
+    return length == rhs.length && TinySTL::equal(begin(), end(), rhs.begin());
+  }
+  bool operator!=(const unrolled_list &rhs) const { return !(*this == rhs); }
+};
+
+template<class T, size_t K, class Alloc>
+template<class... Args>
+typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::emplace(
+    iterator pos, Args &&...args) {
+  base_ptr p = pos.node;
+  size_type idx = pos.idx;
+  // 插入点位于节点开头而前一个节点未满时，追加到前一个节点末尾；
+  // 在 end() 处插入即追加到最后一个节点
+  if (idx == 0 && p->prev != header && p->prev->count < K) {
+    p = p->prev;
+    idx = p->count;
+  } else if (p == header || (idx == 0 && p->count == K)) {
+    p = create_node(p);
+    idx = 0;
+  }
+  if (idx == p->count && p->count < K) {// 追加在末尾，无需平移
+    try {
+      TinySTL::construct(data(p) + idx, TinySTL::forward<Args>(args)...);
+    } catch (std::exception &) {
+      if (p->count == 0) free_node(p);
+      throw;
+    }
+    ++p->count;
+    ++length;
+    return iterator(p, idx);
+  }
+  // 先构造新元素，args 可能引用即将被平移的元素
+  value_type value(TinySTL::forward<Args>(args)...);
+  if (p->count == K) {// 对半分裂
+    base_ptr q = split_node(p, K / 2);
+    if (idx > K / 2) {
+      p = q;
+      idx -= K / 2;
+    }
+  }
+  T *d = data(p);
+  if (idx == p->count) {
+    TinySTL::construct(d + idx, TinySTL::move(value));
+  } else {
+    TinySTL::construct(d + p->count, TinySTL::move(d[p->count - 1]));
+    TinySTL::move_backward(d + idx, d + p->count - 1, d + p->count);
+    d[idx] = TinySTL::move(value);
+  }
+  ++p->count;
+  ++length;
+  return iterator(p, idx);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::erase(
+    iterator pos) {
+  base_ptr p = pos.node;
+  size_type idx = pos.idx;
+  T *d = data(p);
+  TinySTL::move(d + idx + 1, d + p->count, d + idx);
+  TinySTL::destroy(d + p->count - 1);
+  --p->count;
+  --length;
+  if (p->count == 0) {
+    base_ptr next = p->next;
+    free_node(p);
+    return iterator(next, 0);
+  }
+  iterator result = idx == p->count ? iterator(p->next, 0) : iterator(p, idx);
+  // 过于稀疏时与相邻节点合并
+  if (p->count < (K + 3) / 4) {
+    size_type old_count = p->count;
+    if (try_merge_next(p)) {
+      if (result.node != p) result = iterator(p, old_count);
+    } else {
+      base_ptr prev = p->prev;
+      size_type prev_count = prev->count;
+      if (try_merge_next(prev) && result.node == p) result = iterator(prev, prev_count + idx);
+    }
+  }
+  return result;
+}
+
+// 合并可能使 last 失效，因此先数出区间长度
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::erase(
+    iterator first, iterator last) {
+  for (difference_type n = TinySTL::distance(first, last); n > 0; --n) first = erase(first);
+  return first;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::clear() noexcept {
+  base_ptr p = header->next;
+  while (p != header) {
+    base_ptr next = p->next;
+    TinySTL::destroy(data(p), data(p) + p->count);
+    node_allocator::deallocate(static_cast<link_type>(p));
+    p = next;
+  }
+  header->next = header->prev = header;
+  length = 0;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(iterator pos, unrolled_list &x) {
+  if (x.empty() || &x == this) return;
+  base_ptr before = split_at(pos);
+  base_ptr first = x.header->next;
+  base_ptr last = x.header->prev;
+  transfer_nodes(before, first, last);
+  length += x.length;
+  x.length = 0;
+  // 切分处可能留下不满的节点
+  try_merge_next(last);
+  try_merge_next(first->prev);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(iterator pos, unrolled_list &x, iterator first,
+                                        iterator last) {
+  if (first == last) return;
+  // 依次在 last、first、pos 处切开，后切的位置若受前一次切分影响则随之修正
+  base_ptr last_node = split_at(last, &first, &pos);
+  base_ptr first_node = split_at(first, &pos);
+  base_ptr before = split_at(pos);
+  if (before == last_node) return;// pos == last，无需移动
+  base_ptr tail = last_node->prev;
+  if (&x != this) {
+    size_type n = 0;
+    for (base_ptr p = first_node; p != last_node; p = p->next) n += p->count;
+    length += n;
+    x.length -= n;
+  }
+  base_ptr x_seam = first_node->prev;
+  transfer_nodes(before, first_node, tail);
+  // 修补两侧切分处留下的不满节点
+  x.try_merge_next(x_seam);
+  try_merge_next(tail);
+  try_merge_next(first_node->prev);
+}
+
+// 按序把两侧元素搬入新链表，取空的节点立即释放，额外内存不超过两个节点
+template<class T, size_t K, class Alloc>
+template<class Compare>
+void unrolled_list<T, K, Alloc>::merge(unrolled_list &x, Compare comp) {
+  if (&x == this || x.empty()) return;
+  unrolled_list result;
+  base_ptr p1 = header->next;
+  base_ptr p2 = x.header->next;
+  size_type i1 = 0, i2 = 0;
+  auto take = [&result](unrolled_list &from, base_ptr &p, size_type &i) {
+    result.push_back(TinySTL::move(data(p)[i]));
+    if (++i == p->count) {
+      base_ptr next = p->next;
+      TinySTL::destroy(data(p), data(p) + p->count);
+      from.length -= p->count;
+      from.free_node(p);
+      p = next;
+      i = 0;
+    }
+  };
+  try {
+    while (p1 != header && p2 != x.header) {
+      if (comp(data(p2)[i2], data(p1)[i1])) take(x, p2, i2);
+      else take(*this, p1, i1);
+    }
+    while (p1 != header) take(*this, p1, i1);
+    while (p2 != x.header) take(x, p2, i2);
+  } catch (std::exception &) {
+    // 删去两侧首节点中已被搬走的元素，再把已归并的部分接回头部，不丢失任何元素
+    for (; i1 > 0; --i1) erase(begin());
+    for (; i2 > 0; --i2) x.erase(x.begin());
+    splice(begin(), result);
+    throw;
+  }
+  swap(result);
+}
+
+// 逐节点就地压缩，再合并相邻的稀疏节点，O(n)
+template<class T, size_t K, class Alloc>
+template<class Predicate>
+void unrolled_list<T, K, Alloc>::remove_if(Predicate pred) {
+  base_ptr p = header->next;
+  while (p != header) {
+    T *d = data(p);
+    size_type w = 0;
+    for (size_type r = 0; r < p->count; ++r) {
+      if (pred(d[r])) continue;
+      if (w != r) d[w] = TinySTL::move(d[r]);
+      ++w;
+    }
+    TinySTL::destroy(d + w, d + p->count);
+    length -= p->count - w;
+    p->count = w;
+    base_ptr next = p->next;
+    if (w == 0) free_node(p);
+    p = next;
+  }
+  for (p = header->next; p != header;) {
+    if (!try_merge_next(p)) p = p->next;
+  }
+}
+
+template<class T, size_t K, class Alloc>
+inline void swap(unrolled_list<T, K, Alloc> &lhs, unrolled_list<T, K, Alloc> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}// namespace TinySTL
@@ -0,0 +1,92 @@
+/*
+node_handle: 由关联容器 extract() 取出的单个节点，独占其所有权（C++17 风格）。
+节点保持原有内存与值，插回同类容器时只重新链接，不经过分配器，也不复制值；
+未被插回的节点在 node_handle 析构时销毁。
+NodeTraits 由容器提供：
+    using node_pointer = ...;
+    static Value &value(node_pointer);
+    static void destroy(node_pointer);// 析构值并释放节点
+*/
+#pragma once
+
+#include "Utils/type_traits.h"
+#include <type_traits>
+
+namespace TinySTL {
+
+// forward declarations
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+class rb_tree;
+template<class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+class hashtable;
+
+template<class Value, class NodeTraits>
+class node_handle {
+  template<class, class, class, class, class, class>
+  friend class rb_tree;
+  template<class, class, class, class, class, class>
+  friend class hashtable;
+
+ public:
+  using value_type = Value;
+
+ private:
+  using node_pointer = typename NodeTraits::node_pointer;
+  node_pointer ptr;
+
+  explicit node_handle(node_pointer p) noexcept : ptr(p) {}
+  // 交还节点所有权，供容器重新链接
+  node_pointer release() noexcept {
+    node_pointer p = ptr;
+    ptr = nullptr;
+    return p;
+  }
+
+ public:// ctor && dtor
+  node_handle() noexcept : ptr(nullptr) {}
+  node_handle(node_handle &&rhs) noexcept : ptr(rhs.release()) {}
+  node_handle &operator=(node_handle &&rhs) noexcept {
+    if (this != &rhs) {
+      if (ptr) NodeTraits::destroy(ptr);
+      ptr = rhs.release();
+    }
+    return *this;
+  }
+  node_handle(const node_handle &) = delete;
+  node_handle &operator=(const node_handle &) = delete;
+  ~node_handle() {
+    if (ptr) NodeTraits::destroy(ptr);
+  }
+
+ public:// getter，要求非空
+  bool empty() const noexcept { return ptr == nullptr; }
+  explicit operator bool() const noexcept { return ptr != nullptr; }
+  value_type &value() const noexcept { return NodeTraits::value(ptr); }
+  // map 类节点：键值可在插回前修改
+  template<class V = Value, class = void_t<typename V::first_type>>
+  std::remove_const_t<typename V::first_type> &key() const noexcept {
+    return const_cast<std::remove_const_t<typename V::first_type> &>(value().first);
+  }
+  template<class V = Value, class = void_t<typename V::second_type>>
+  typename V::second_type &mapped() const noexcept {
+    return value().second;
+  }
+
+ public:// swap
+  void swap(node_handle &rhs) noexcept {
+    node_pointer p = ptr;
+    ptr = rhs.ptr;
+    rhs.ptr = p;
+  }
+  friend void swap(node_handle &lhs, node_handle &rhs) noexcept { lhs.swap(rhs); }
+};
+
+// 以 node_handle 插入唯一键容器的结果：失败时节点原样留在 node 中
+template<class Iterator, class NodeType>
+struct node_insert_return {
+  Iterator position;
+  bool inserted;
+  NodeType node;
+};
+
+}// namespace TinySTL
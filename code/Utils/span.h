@@ -0,0 +1,58 @@
+/*
+    span: 对一段连续内存的非拥有视图（C++20 std::span 的简化版本）
+    仅保存首地址与长度，不负责内存的配置与释放，
+    用于把容器内部的连续缓冲区直接交给向量化的计算核心
+*/
+#pragma once
+
+#include "Iterator/stl_iterator.h"
+#include <cstddef>
+
+namespace TinySTL {
+
+template<class T>
+class span {
+ public:
+  using element_type = T;
+  using pointer = T *;
+  using reference = T &;
+  using iterator = T *;
+  using reverse_iterator = __reverse_iterator<iterator>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+ private:// data member
+  pointer ptr;
+  size_type len;
+
+ public:// ctor
+  span() noexcept : ptr(nullptr), len(0) {}
+  span(pointer p, size_type n) noexcept : ptr(p), len(n) {}
+  span(pointer first, pointer last) noexcept
+      : ptr(first), len(static_cast<size_type>(last - first)) {}
+  // span<T> -> span<const T>
+  template<class U>
+  span(const span<U> &rhs) noexcept : ptr(rhs.data()), len(rhs.size()) {}
+
+ public:// getter
+  pointer data() const noexcept { return ptr; }
+  size_type size() const noexcept { return len; }
+  size_type size_bytes() const noexcept { return len * sizeof(T); }
+  bool empty() const noexcept { return len == 0; }
+  iterator begin() const noexcept { return ptr; }
+  iterator end() const noexcept { return ptr + len; }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+  reference front() const noexcept { return *ptr; }
+  reference back() const noexcept { return *(ptr + len - 1); }
+  reference operator[](size_type n) const noexcept { return *(ptr + n); }
+
+ public:// sub view
+  span first(size_type n) const noexcept { return span(ptr, n); }
+  span last(size_type n) const noexcept { return span(ptr + len - n, n); }
+  span subspan(size_type offset, size_type n) const noexcept {
+    return span(ptr + offset, n);
+  }
+};
+
+}// namespace TinySTL
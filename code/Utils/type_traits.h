@@ -389,6 +389,25 @@ struct remove_reference<T &&> : type_identity<T> {};
 template<class T>
 using remove_reference_t = typename remove_reference<T>::type;
 
+// move && forward
+template<typename T>
+constexpr remove_reference_t<T> &&move(T &&param) noexcept {
+  return static_cast<remove_reference_t<T> &&>(param);
+}
+
+template<typename T>
+constexpr T &&forward(remove_reference_t<T> &param) noexcept {
+  return static_cast<T &&>(param);
+}
+
+// 转发右值，禁止将右值转发为左值
+template<typename T>
+constexpr T &&forward(remove_reference_t<T> &&param) noexcept {
+  static_assert(!is_same<T, remove_reference_t<T> &>::value,
+                "can not forward an rvalue as an lvalue");
+  return static_cast<T &&>(param);
+}
+
 namespace detail {
 // add reference
 template<class T>
@@ -471,6 +490,14 @@ struct has_value_type : false_type {};
 template<class T>
 struct has_value_type<T, void_t<typename T::value_type>> : true_type {};
 
+// has_is_transparent<T>::value is true if T has a nested type `is_transparent`，
+// 关联容器据此开放以任意可比较类型查找的模板重载
+template<class T, class = void>
+struct has_is_transparent : false_type {};
+
+template<class T>
+struct has_is_transparent<T, void_t<typename T::is_transparent>> : true_type {};
+
 template<typename, typename>
 constexpr bool is_similar_instantiation_v = false;
 template<template<typename...> class C, typename... A, typename... B>
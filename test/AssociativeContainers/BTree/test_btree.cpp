@@ -0,0 +1,164 @@
+#include "AssociativeContainers/BTree/btree_map.h"
+#include "AssociativeContainers/BTree/btree_set.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace ::TinySTL;
+
+namespace {
+
+// 体积较大的值使每个节点只容纳 3 个，便于覆盖多层分裂与合并
+struct fat_value {
+  int key;
+  char pad[96];
+  fat_value(int k) : key(k), pad() {}
+  bool operator==(const fat_value &rhs) const { return key == rhs.key; }
+};
+
+struct fat_key {
+  const int &operator()(const fat_value &x) const { return x.key; }
+};
+
+using fat_tree = btree<int, fat_value, fat_key, less<int>>;
+
+// 与 std::multiset 对照随机插入删除，每步检查结构
+template<class Tree>
+void random_against_reference(Tree &t, bool unique, int ops, int range, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::multiset<int> ref;
+  for (int i = 0; i < ops; ++i) {
+    int k = static_cast<int>(gen() % range);
+    if (gen() % 3) {
+      if (unique) {
+        bool inserted = t.insert_unique(k).second;
+        EXPECT_EQ(inserted, ref.count(k) == 0);
+        if (inserted) ref.insert(k);
+      } else {
+        t.insert_equal(k);
+        ref.insert(k);
+      }
+    } else if (gen() % 2) {
+      EXPECT_EQ(t.erase(k), ref.erase(k));
+    } else {
+      auto it = t.lower_bound(k);
+      auto rit = ref.lower_bound(k);
+      if (rit == ref.end()) {
+        EXPECT_TRUE(it == t.end());
+        continue;
+      }
+      // erase 返回的后继应与参照一致
+      auto next = t.erase(it);
+      rit = ref.erase(rit);
+      if (rit == ref.end())
+        EXPECT_TRUE(next == t.end());
+      else
+        EXPECT_EQ((*next).key, *rit);
+    }
+    if (i % 64 == 0) {
+      ASSERT_TRUE(t.verify());
+    }
+  }
+  ASSERT_TRUE(t.verify());
+  ASSERT_EQ(t.size(), ref.size());
+  auto rit = ref.begin();
+  for (auto it = t.begin(); it != t.end(); ++it, ++rit) EXPECT_EQ((*it).key, *rit);
+  auto rrit = ref.rbegin();
+  for (auto it = t.rbegin(); it != t.rend(); ++it, ++rrit) EXPECT_EQ((*it).key, *rrit);
+}
+
+}// namespace
+
+class BTreeTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(BTreeTest, node_layout) {
+  // 小键值节点容纳数十个元素，大值至少 3 个
+  EXPECT_GE(btree_set<int>::size_type(fat_tree::node_values), 3u);
+  EXPECT_EQ(fat_tree::node_values, 3u);
+  EXPECT_GE((btree<int, int, identity<int>, less<int>>::node_values), 32u);
+}
+
+TEST_F(BTreeTest, random_unique_and_equal) {
+  fat_tree u;
+  random_against_reference(u, true, 6000, 500, 1);
+  fat_tree e;
+  random_against_reference(e, false, 6000, 200, 2);
+  fat_tree copy(e);
+  EXPECT_TRUE(copy.verify());
+  EXPECT_TRUE(copy == e);
+  e.clear();
+  EXPECT_TRUE(e.begin() == e.end());
+  EXPECT_TRUE(e.verify());
+}
+
+TEST_F(BTreeTest, set_and_multiset) {
+  btree_set<int> s;
+  for (int i = 0; i < 10000; ++i) s.insert((i * 7919) % 10007 * 2);
+  EXPECT_EQ(s.size(), 10000u);
+  EXPECT_TRUE(s.verify());
+  int prev = -1;
+  for (auto x : s) {
+    EXPECT_LT(prev, x);
+    prev = x;
+  }
+  EXPECT_FALSE(s.insert(7919 * 2).second);
+  EXPECT_EQ(s.count(7919 * 2), 1u);
+  EXPECT_EQ(s.count(7919), 0u);
+  EXPECT_EQ(*s.lower_bound(7919), 7920);
+  EXPECT_EQ(*s.upper_bound(7920), 7922);
+  EXPECT_TRUE(s.find(7919) == s.end());
+
+  // 顺序追加保持节点满载，删除一半后结构仍然合法
+  btree_set<int> seq;
+  for (int i = 0; i < 5000; ++i) seq.insert(seq.end(), i);
+  auto it = seq.begin();
+  while (it != seq.end()) {
+    it = seq.erase(it);
+    if (it != seq.end()) ++it;
+  }
+  EXPECT_TRUE(seq.verify());
+  EXPECT_EQ(seq.size(), 2500u);
+  EXPECT_EQ(*seq.begin(), 1);
+  EXPECT_EQ(*--seq.end(), 4999);
+  seq.erase(seq.find(1001), seq.find(3001));
+  EXPECT_EQ(seq.size(), 1500u);
+  EXPECT_TRUE(seq.verify());
+
+  btree_multiset<int, greater<int>> ms{3, 1, 3, 2, 3};
+  EXPECT_EQ(ms.count(3), 3u);
+  EXPECT_EQ(*ms.begin(), 3);
+  EXPECT_EQ(ms.erase(3), 3u);
+  EXPECT_EQ(*ms.begin(), 2);
+  EXPECT_EQ(ms.size(), 2u);
+}
+
+TEST_F(BTreeTest, map_and_multimap) {
+  btree_map<std::string, int> m;
+  for (int i = 0; i < 1000; ++i) m[std::to_string(i)] += i;
+  m["7"] += 1;
+  EXPECT_EQ(m.size(), 1000u);
+  EXPECT_EQ(m["7"], 8);
+  EXPECT_EQ(m.count("999"), 1u);
+  EXPECT_TRUE(m.verify());
+  btree_map<std::string, int> copy(m);
+  EXPECT_TRUE(copy == m);
+  EXPECT_EQ(m.erase("500"), 1u);
+  EXPECT_FALSE(copy == m);
+  EXPECT_TRUE(m.find("500") == m.end());
+  m.clear();
+  EXPECT_TRUE(m.empty());
+
+  btree_multimap<int, int> mm;
+  for (int i = 0; i < 300; ++i) mm.insert(pair<const int, int>(i % 10, i));
+  EXPECT_EQ(mm.count(4), 30u);
+  // 等值元素保持插入次序
+  auto range = mm.equal_range(4);
+  int expect = 4;
+  for (auto it = range.first; it != range.second; ++it, expect += 10) EXPECT_EQ(it->second, expect);
+  EXPECT_TRUE(mm.verify());
+}
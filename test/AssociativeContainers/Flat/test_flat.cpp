@@ -0,0 +1,183 @@
+#include "AssociativeContainers/Flat/flat_map.h"
+#include "AssociativeContainers/Flat/flat_set.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using namespace ::TinySTL;
+
+namespace {
+
+// 可直接与 const char * 比较的透明比较器
+struct str_less {
+  using is_transparent = void;
+  bool operator()(const std::string &a, const std::string &b) const { return a < b; }
+  bool operator()(const std::string &a, const char *b) const { return std::strcmp(a.c_str(), b) < 0; }
+  bool operator()(const char *a, const std::string &b) const { return std::strcmp(a, b.c_str()) < 0; }
+};
+
+// 遇到负数即抛出异常的比较器
+struct throwing_less {
+  bool operator()(int a, int b) const {
+    if (a < 0 || b < 0) throw std::runtime_error("throwing_less");
+    return a < b;
+  }
+};
+
+// 比较 "b" 与 "c" 时抛出异常
+struct bc_throwing_less {
+  bool operator()(const std::string &a, const std::string &b) const {
+    if ((a == "b" && b == "c") || (a == "c" && b == "b")) throw std::runtime_error("bc_throwing_less");
+    return a < b;
+  }
+};
+
+}// namespace
+
+class FlatTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(FlatTest, map_basic) {
+  flat_map<int, std::string> m;
+  EXPECT_TRUE(m.insert(pair<int, std::string>(3, "c")).second);
+  EXPECT_TRUE(m.insert(pair<int, std::string>(1, "a")).second);
+  EXPECT_FALSE(m.insert(pair<int, std::string>(3, "x")).second);
+  m[2] = "b";
+  m[5];
+  EXPECT_EQ(m.size(), 4u);
+  EXPECT_EQ(m.at(3), "c");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+  int expect[] = {1, 2, 3, 5};
+  int i = 0;
+  for (auto it = m.begin(); it != m.end(); ++it) EXPECT_EQ(it->first, expect[i++]);
+  EXPECT_EQ((*m.lower_bound(4)).first, 5);
+  EXPECT_TRUE(m.upper_bound(5) == m.end());
+  EXPECT_EQ(m.erase(2), 1u);
+  EXPECT_EQ(m.erase(2), 0u);
+  auto it = m.erase(m.find(1));
+  EXPECT_EQ(it->first, 3);
+  it->second = "cc";
+  EXPECT_EQ(m.values()[0], "cc");
+  EXPECT_EQ(m.keys().size(), m.values().size());
+}
+
+TEST_F(FlatTest, map_bulk_insert) {
+  flat_map<int, int> m{{5, 50}, {1, 10}, {9, 90}};
+  // 新元素乱序、互有重复且与原有元素重复：保留原有值与首次出现的值
+  pair<int, int> more[] = {{7, 70}, {1, -1}, {3, 30}, {7, -7}, {0, 0}, {9, -9}, {11, 110}};
+  m.insert(more, more + 7);
+  int keys[] = {0, 1, 3, 5, 7, 9, 11};
+  ASSERT_EQ(m.size(), 7u);
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(m.keys()[i], keys[i]);
+    EXPECT_EQ(m.values()[i], keys[i] * 10);
+  }
+  // 大量随机键
+  flat_map<int, int> big;
+  vector<pair<int, int>> src;
+  for (int i = 0; i < 5000; ++i) src.push_back(pair<int, int>((i * 7919) % 4001, i));
+  big.insert(src.begin(), src.end());
+  EXPECT_EQ(big.size(), 4001u);
+  for (size_t i = 0; i < big.size(); ++i) {
+    EXPECT_EQ(big.keys()[i], static_cast<int>(i));
+    EXPECT_EQ((big.values()[i] * 7919) % 4001, static_cast<int>(i));
+    EXPECT_LT(big.values()[i], 4001);
+  }
+}
+
+TEST_F(FlatTest, replace_and_heterogeneous) {
+  vector<std::string> keys{"apple", "banana", "cherry"};
+  vector<int> values{1, 2, 3};
+  const std::string *buffer = keys.begin();
+  flat_map<std::string, int, str_less> m;
+  m.replace(TinySTL::move(keys), TinySTL::move(values));
+  EXPECT_EQ(m.keys().begin(), buffer);// 未复制
+  EXPECT_TRUE(keys.empty());
+  EXPECT_EQ(m.find("banana")->second, 2);
+  EXPECT_TRUE(m.contains("cherry"));
+  EXPECT_EQ(m.count("durian"), 0u);
+  EXPECT_EQ((*m.lower_bound("b")).first, "banana");
+  EXPECT_EQ((*m.upper_bound("banana")).first, "cherry");
+  auto range = m.equal_range("cherry");
+  EXPECT_TRUE(range.first != range.second && (*range.first).second == 3);
+  (*m.lower_bound("c")).second = 30;
+  const auto &cm = m;
+  EXPECT_EQ((*cm.lower_bound("cherry")).second, 30);
+  EXPECT_TRUE(cm.upper_bound("cherry") == cm.end());
+  EXPECT_TRUE(cm.equal_range("coconut").first == cm.equal_range("coconut").second);
+
+  flat_set<std::string, str_less> s{"b", "a", "c", "a"};
+  EXPECT_EQ(s.size(), 3u);
+  EXPECT_TRUE(s.contains("a"));
+  EXPECT_TRUE(s.find("d") == s.end());
+  auto srange = s.equal_range("b");
+  EXPECT_TRUE(srange.first != srange.second && *srange.first == "b");
+  vector<std::string> sorted{"x", "y"};
+  s.replace(TinySTL::move(sorted));
+  EXPECT_EQ(*s.begin(), "x");
+}
+
+TEST_F(FlatTest, set_basic) {
+  flat_set<int> s;
+  for (int i = 0; i < 100; ++i) s.insert((i * 37) % 101);
+  EXPECT_EQ(s.size(), 100u);
+  int prev = -1;
+  for (int x : s) {
+    EXPECT_LT(prev, x);
+    prev = x;
+  }
+  int more[] = {200, 5, 150, 5, 300};
+  s.insert(more, more + 5);
+  EXPECT_EQ(s.size(), 103u);
+  EXPECT_EQ(*s.rbegin(), 300);
+  EXPECT_EQ(s.erase(150), 1u);
+  EXPECT_EQ(*s.erase(s.find(200)), 300);
+  EXPECT_EQ(*s.lower_bound(101), 300);
+  flat_set<int> copy(s);
+  EXPECT_TRUE(copy == s);
+  copy.erase(copy.begin(), copy.end());
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(copy < s);
+}
+
+TEST_F(FlatTest, bulk_insert_throwing_compare) {
+  // 区间插入中比较抛出异常时，容器回到插入前的内容
+  flat_map<int, std::string, throwing_less> m{{4, "d"}, {1, "a"}, {2, "b"}};
+  vector<pair<int, std::string>> bad{{5, "e"}, {-1, "x"}, {3, "c"}};
+  EXPECT_THROW(m.insert(bad.begin(), bad.end()), std::runtime_error);
+  EXPECT_EQ(m.size(), 3u);
+  EXPECT_EQ(m.values().size(), 3u);
+  EXPECT_TRUE(m.find(1)->second == "a" && m.find(2)->second == "b" && m.find(4)->second == "d");
+  bad[1].first = 6;
+  m.insert(bad.begin(), bad.end());
+  EXPECT_EQ(m.size(), 6u);
+
+  flat_set<int, throwing_less> s{4, 1, 2};
+  int more[] = {5, -1, 3};
+  EXPECT_THROW(s.insert(more, more + 3), std::runtime_error);
+  EXPECT_TRUE(s.size() == 3 && s.keys()[0] == 1 && s.keys()[1] == 2 && s.keys()[2] == 4);
+  more[1] = 6;
+  s.insert(more, more + 3);
+  EXPECT_EQ(s.size(), 6u);
+}
+
+TEST_F(FlatTest, bulk_insert_throwing_merge) {
+  // 新元素排序时不抛出，与原有元素归并时才抛出
+  flat_set<std::string, bc_throwing_less> s{"a", "b", "e"};
+  std::string more[] = {"c", "z"};
+  EXPECT_THROW(s.insert(more, more + 2), std::runtime_error);
+  EXPECT_TRUE(s.size() == 3 && s.keys()[0] == "a" && s.keys()[1] == "b" && s.keys()[2] == "e");
+
+  flat_map<std::string, int, bc_throwing_less> m{{"a", 1}, {"b", 2}, {"e", 5}};
+  vector<pair<std::string, int>> bad{{"c", 3}, {"z", 26}};
+  EXPECT_THROW(m.insert(bad.begin(), bad.end()), std::runtime_error);
+  EXPECT_EQ(m.size(), 3u);
+  EXPECT_TRUE(m.find("a")->second == 1 && m.find("b")->second == 2 && m.find("e")->second == 5);
+
+  std::string fine[] = {"d", "a", "f"};
+  s.insert(fine, fine + 3);
+  EXPECT_TRUE(s.size() == 5 && s.keys()[2] == "d" && s.keys()[4] == "f");
+}
@@ -4,6 +4,7 @@
 #include <Hashtable/hash_func.h>
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
 
 using namespace ::TinySTL;
 using std::string;
@@ -120,4 +121,91 @@ TEST_F(HashTest, template_methods) {
     Container const &ccont = cont;
     ASSERT_TRUE(ccont.find(2) != ccont.end());
   }
-}
\ No newline at end of file
+}
+
+TEST_F(HashTest, transparent_lookup) {
+  string_hash h;
+  ASSERT_TRUE(h("hello") == h(string("hello")) && h(std::string_view("hello!", 5)) == h("hello"));
+
+  hash_map<string, int, string_hash, equal_to<>> m;
+  m["one"] = 1;
+  m["two"] = 2;
+  const char *k = "two";
+  ASSERT_TRUE(m.find(k)->second == 2 && m.count("three") == 0);
+  ASSERT_TRUE(m.find(std::string_view("one!", 3))->second == 1);
+  const hash_map<string, int, string_hash, equal_to<>> &cm = m;
+  ASSERT_TRUE(cm.find("one") != cm.end());
+
+  hash_set<string, string_hash, equal_to<>> s;
+  s.insert("a");
+  s.insert("b");
+  ASSERT_TRUE(s.count("a") == 1 && s.find(std::string_view("b")) != s.end());
+}
+
+TEST_F(HashTest, node_handle) {
+  hash_map<int, string> m;
+  for (int i = 0; i < 100; ++i) m[i] = std::to_string(i);
+  const string *addr = &m[42];
+  hash_map<int, string>::node_type nh = m.extract(42);
+  ASSERT_TRUE(m.size() == 99 && m.count(42) == 0 && nh.key() == 42 && nh.mapped() == "42");
+  nh.key() = 1000;
+  hash_map<int, string>::insert_return_type r = m.insert(TinySTL::move(nh));
+  ASSERT_TRUE(r.inserted && &r.position->second == addr && m.find(1000) != m.end());
+  r = m.insert(m.extract(m.find(7)));
+  ASSERT_TRUE(r.inserted && m.size() == 100);
+  ASSERT_TRUE(m.extract(-1).empty());
+
+  hash_map<int, string> other;
+  other[5] = "dup";
+  other[2000] = "new";
+  m.merge(other);
+  ASSERT_TRUE(m.size() == 101 && m[2000] == "new" && m[5] == "5");
+  ASSERT_TRUE(other.size() == 1 && other[5] == "dup");
+
+  hash_set<int> s, t;
+  for (int i = 0; i < 10; ++i) s.insert(i);
+  for (int i = 5; i < 15; ++i) t.insert(i);
+  hash_set<int>::node_type sn = s.extract(s.find(3));
+  ASSERT_TRUE(sn.value() == 3 && s.size() == 9);
+  hash_set<int>::insert_return_type sr = t.insert(TinySTL::move(sn));
+  ASSERT_TRUE(sr.inserted && *sr.position == 3 && t.size() == 11);
+  s.merge(t);
+  ASSERT_TRUE(s.size() == 15 && t.size() == 5);
+}
+
+struct hash_counted_value {
+  static int made;
+  int v;
+  hash_counted_value() : v(0) { ++made; }
+  hash_counted_value(int a, int b) : v(a + b) { ++made; }
+  hash_counted_value(const hash_counted_value &rhs) : v(rhs.v) { ++made; }
+  hash_counted_value &operator=(const hash_counted_value &) = default;
+};
+int hash_counted_value::made = 0;
+
+TEST_F(HashTest, try_emplace) {
+  hash_map<int, hash_counted_value> m;
+  pair<hash_map<int, hash_counted_value>::iterator, bool> r = m.try_emplace(1, 2, 3);
+  ASSERT_TRUE(r.second && r.first->second.v == 5 && hash_counted_value::made == 1);
+  hash_counted_value::made = 0;
+  ASSERT_TRUE(!m.try_emplace(1, 7, 7).second && m[1].v == 5 && hash_counted_value::made == 0);
+
+  // 填满至负载上限后，命中访问不再触发扩容
+  while (m.size() < m.bucket_count()) m[static_cast<int>(m.size()) + 100];
+  const size_t buckets = m.bucket_count();
+  const pair<const int, hash_counted_value> dup(1, hash_counted_value());
+  hash_counted_value::made = 0;
+  for (int i = 0; i < 10; ++i) ++m[1].v;
+  ASSERT_TRUE(!m.insert(dup).second && !m.emplace(dup).second);
+  ASSERT_TRUE(m.bucket_count() == buckets && hash_counted_value::made == 1 && m[1].v == 15);
+  m[-1];
+  ASSERT_TRUE(m.bucket_count() > buckets && m.count(-1) == 1);
+
+  hash_map<string, string> s;
+  string key = "k";
+  ASSERT_TRUE(s.insert_or_assign(key, string("v")).second && s["k"] == "v");
+  ASSERT_TRUE(!s.insert_or_assign(string("k"), string("w")).second && s["k"] == "w");
+  ASSERT_TRUE(s.try_emplace(string("n"), 3, 'x').first->second == "xxx");
+  ASSERT_TRUE(s.emplace("e", "f").second && !s.emplace("e", "g").second && s["e"] == "f");
+  ASSERT_TRUE(s.size() == 3 && key == "k");
+}
@@ -0,0 +1,87 @@
+#include "AssociativeContainers/Hashtable/intrusive_hashtable.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace ::TinySTL;
+
+namespace {
+
+struct session {
+  std::string name;
+  int id;
+  intrusive_hash_hook by_name;
+  intrusive_hash_hook by_id;
+  intrusive_list_hook lru;
+};
+
+struct name_of {
+  const std::string &operator()(const session &s) const { return s.name; }
+};
+
+struct id_of {
+  const int &operator()(const session &s) const { return s.id; }
+};
+
+}// namespace
+
+class IntrusiveHashtableTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(IntrusiveHashtableTest, unique_and_equal) {
+  std::vector<session> pool(200);
+  intrusive_hashtable<session, std::string, &session::by_name, name_of> names;
+  intrusive_hashtable<session, int, &session::by_id, id_of> ids;
+  intrusive_list<session, &session::lru> lru;
+
+  for (int i = 0; i < 200; ++i) {
+    pool[i].name = "s" + std::to_string(i);
+    pool[i].id = i % 50;
+    ASSERT_TRUE(names.insert_unique(pool[i]).second);
+    ids.insert_equal(pool[i]);
+    lru.push_back(pool[i]);
+  }
+  // 插入过程中 bucket 扩容，元素仍全部可查
+  ASSERT_TRUE(names.size() == 200 && ids.size() == 200);
+  ASSERT_TRUE(names.bucket_count() >= 200);
+  for (int i = 0; i < 200; ++i) {
+    auto it = names.find("s" + std::to_string(i));
+    ASSERT_TRUE(it != names.end() && &*it == &pool[i]);
+  }
+  ASSERT_TRUE(names.find("none") == names.end());
+
+  session dup;
+  dup.name = "s7";
+  auto r = names.insert_unique(dup);
+  ASSERT_FALSE(r.second);
+  ASSERT_TRUE(&*r.first == &pool[7]);
+
+  ASSERT_TRUE(ids.count(3) == 4);
+  size_t visited = 0;
+  for (auto &s : ids) {
+    (void) s;
+    ++visited;
+  }
+  ASSERT_TRUE(visited == 200);
+
+  // 同一对象同时位于三个容器中，从其中之一移除不影响其余
+  ASSERT_TRUE(ids.erase(3) == 4);
+  ASSERT_TRUE(ids.count(3) == 0 && ids.size() == 196);
+  ASSERT_TRUE(names.find("s3") != names.end());
+  ASSERT_TRUE(lru.size() == 200);
+
+  names.remove(pool[10]);
+  names.erase(names.find("s11"));
+  ASSERT_TRUE(names.size() == 198);
+  ASSERT_TRUE(names.find("s10") == names.end() && names.find("s11") == names.end());
+  ASSERT_TRUE(names.insert_unique(pool[10]).second);
+
+  const auto &cnames = names;
+  ASSERT_TRUE(cnames.find("s12")->id == 12);
+
+  names.clear();
+  ASSERT_TRUE(names.empty() && names.begin() == names.end());
+  ids.clear();
+}
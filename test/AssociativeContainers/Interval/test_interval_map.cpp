@@ -0,0 +1,105 @@
+#include "AssociativeContainers/Interval/interval_map.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace ::TinySTL;
+
+namespace {
+
+struct interval {
+  int lo, hi, id;
+};
+
+// 暴力求与 [lo, hi) 相交的区间编号
+std::vector<int> brute_overlap(const std::vector<interval> &v, int lo, int hi) {
+  std::vector<int> res;
+  for (const interval &x : v)
+    if (x.lo < hi && lo < x.hi && lo < hi) res.push_back(x.id);
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+}// namespace
+
+class IntervalMapTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(IntervalMapTest, basic) {
+  interval_map<int, char> m;
+  ASSERT_TRUE(m.empty() && !m.overlaps(0, 100));
+  m.insert(10, 20, 'a');
+  m.insert(15, 25, 'b');
+  m.insert(30, 40, 'c');
+  m.insert(10, 20, 'd');// 允许相同区间
+  ASSERT_TRUE(m.size() == 4 && m.max_high() == 40);
+  ASSERT_TRUE(m.overlaps(19, 21) && m.overlaps(0, 11) && !m.overlaps(25, 30));
+  ASSERT_TRUE(!m.overlaps(20, 10));// 空查询区间
+
+  // 半开区间：[20, 30) 与 [10, 20) 不相交
+  std::vector<char> hits;
+  m.for_each_overlap(20, 30, [&](interval_map<int, char>::iterator it) { hits.push_back(it->second); });
+  ASSERT_TRUE(hits == std::vector<char>({'b'}));
+
+  hits.clear();
+  m.for_each_containing(15, [&](interval_map<int, char>::iterator it) {
+    hits.push_back(it->second);
+    it->second = 'z';
+  });
+  ASSERT_TRUE(hits == std::vector<char>({'a', 'd', 'b'}));
+  ASSERT_TRUE(m.find(pair<int, int>(15, 25))->second == 'z');
+
+  ASSERT_TRUE(m.erase(pair<int, int>(10, 20)) == 2);
+  m.erase(m.find(pair<int, int>(30, 40)));
+  ASSERT_TRUE(m.size() == 1 && m.max_high() == 25 && !m.overlaps(25, 100));
+
+  const interval_map<int, char> c(m);
+  ASSERT_TRUE(c == m);
+  int n = 0;
+  c.for_each_overlap(0, 100, [&](interval_map<int, char>::const_iterator) { ++n; });
+  ASSERT_TRUE(n == 1);
+}
+
+TEST_F(IntervalMapTest, random_against_brute_force) {
+  std::mt19937 rng(3);
+  std::vector<interval> ref;
+  interval_map<int, int> m;
+  int next_id = 0;
+  for (int op = 0; op < 3000; ++op) {
+    if (rng() % 4 == 0 && !ref.empty()) {
+      size_t i = rng() % ref.size();
+      auto it = m.find(pair<int, int>(ref[i].lo, ref[i].hi));
+      while (it->second != ref[i].id) ++it;
+      m.erase(it);
+      ref.erase(ref.begin() + i);
+    } else {
+      int lo = static_cast<int>(rng() % 1000);
+      int hi = lo + 1 + static_cast<int>(rng() % (rng() % 8 == 0 ? 300 : 20));
+      m.insert(lo, hi, next_id);
+      ref.push_back(interval{lo, hi, next_id++});
+    }
+    if (op % 50 == 0) {
+      int lo = static_cast<int>(rng() % 1100) - 50;
+      int hi = lo + static_cast<int>(rng() % 60);
+      std::vector<int> got;
+      int prev_lo = -1000;
+      m.for_each_overlap(lo, hi, [&](interval_map<int, int>::iterator it) {
+        EXPECT_TRUE(prev_lo <= it->first.first);// 按区间次序访问
+        prev_lo = it->first.first;
+        got.push_back(it->second);
+      });
+      std::sort(got.begin(), got.end());
+      ASSERT_TRUE(got == brute_overlap(ref, lo, hi));
+      ASSERT_TRUE(m.overlaps(lo, hi) == !got.empty());
+
+      got.clear();
+      m.for_each_containing(lo, [&](interval_map<int, int>::iterator it) { got.push_back(it->second); });
+      std::sort(got.begin(), got.end());
+      ASSERT_TRUE(got == brute_overlap(ref, lo, lo + 1));
+    }
+  }
+  ASSERT_TRUE(m.size() == ref.size());
+}
@@ -1,5 +1,8 @@
 #include "AssociativeContainers/Map/stl_map.h"
+#include "AssociativeContainers/Map/stl_multimap.h"
 #include <gtest/gtest.h>
+#include <string>
+#include <string_view>
 
 using namespace ::TinySTL;
 
@@ -117,4 +120,180 @@ TEST_F(MapTest, template_methods) {
     ASSERT_TRUE(ccont.upper_bound(2) != ccont.end());
     ASSERT_TRUE(ccont.equal_range(2) != make_pair(ccont.end(), ccont.end()));
   }
-}
\ No newline at end of file
+}
+
+TEST_F(MapTest, assign_sorted) {
+  typedef map<int, char, less<int>> maptype;
+  pair<int, char> v[] = {{1, 'a'}, {2, 'b'}, {2, 'x'}, {5, 'c'}, {8, 'd'}};
+  maptype m(assign_sorted, v, v + 5);
+  ASSERT_TRUE(m.size() == 4);
+  ASSERT_TRUE(m[2] == 'b' && m[8] == 'd');
+
+  // 普通区间构造也会识别有序输入
+  maptype m2(v, v + 5);
+  ASSERT_TRUE(m2 == m);
+  m2[3] = 'z';
+  ASSERT_TRUE(m2.size() == 5 && m2.find(3)->second == 'z');
+}
+
+TEST_F(MapTest, order_statistic) {
+  typedef map<int, int, less<int>, simpleAlloc<int>, rb_tree_size_augment> maptype;
+  maptype m;
+  for (int i = 0; i < 64; ++i) m[i * 2] = i;
+  ASSERT_TRUE(m.nth(10)->first == 20 && m.nth(10)->second == 10);
+  m.nth(10)->second = -1;
+  ASSERT_TRUE(m[20] == -1);
+  ASSERT_TRUE(m.rank(21) == 11 && m.count_range(0, 10) == 5);
+
+  typedef multimap<int, char, less<int>, simpleAlloc<char>, rb_tree_size_augment> mmaptype;
+  mmaptype mm;
+  mm.insert(pair<const int, char>(1, 'a'));
+  mm.insert(pair<const int, char>(2, 'b'));
+  mm.insert(pair<const int, char>(2, 'c'));
+  mm.insert(pair<const int, char>(4, 'd'));
+  ASSERT_TRUE(mm.size() == 4 && mm.count(2) == 2);
+  // 相同键值按插入顺序排列
+  ASSERT_TRUE(mm.nth(1)->second == 'b' && mm.nth(2)->second == 'c');
+  ASSERT_TRUE(mm.rank(4) == 3 && mm.count_range(2, 5) == 3);
+  mm.erase(mm.nth(1));
+  ASSERT_TRUE(mm.nth(1)->second == 'c' && mm.count(2) == 1);
+}
+
+namespace {
+// 记录构造次数，用于确认透明查找不构造 key_type
+struct tracked_key {
+  static int made;
+  int v;
+  tracked_key(int x) : v(x) { ++made; }
+};
+int tracked_key::made = 0;
+bool operator<(const tracked_key &a, const tracked_key &b) { return a.v < b.v; }
+bool operator<(const tracked_key &a, int b) { return a.v < b; }
+bool operator<(int a, const tracked_key &b) { return a < b.v; }
+}// namespace
+
+TEST_F(MapTest, transparent_lookup) {
+  map<std::string, int, less<>> m;
+  m["apple"] = 1;
+  m["banana"] = 2;
+  m["cherry"] = 3;
+  const char *k = "banana";
+  ASSERT_TRUE(m.find(k)->second == 2 && m.count("durian") == 0);
+  ASSERT_TRUE(m.lower_bound(std::string_view("b"))->first == "banana");
+  ASSERT_TRUE(m.upper_bound("banana")->first == "cherry");
+  ASSERT_TRUE(m.equal_range("cherry").first->second == 3);
+
+  map<tracked_key, int, less<>> t;
+  for (int i = 0; i < 10; ++i) t.insert(pair<const tracked_key, int>(tracked_key(i), i));
+  tracked_key::made = 0;
+  const map<tracked_key, int, less<>> &ct = t;
+  ASSERT_TRUE(t.find(3)->second == 3 && ct.find(4)->second == 4);
+  ASSERT_TRUE(t.count(5) == 1 && t.count(10) == 0);
+  ASSERT_TRUE(ct.lower_bound(7)->second == 7 && t.upper_bound(7)->second == 8);
+  ASSERT_TRUE(tracked_key::made == 0);
+
+  // 非透明比较仍经由 key_type 转换查找
+  map<tracked_key, int> u;
+  u.insert(pair<const tracked_key, int>(tracked_key(1), 1));
+  tracked_key::made = 0;
+  ASSERT_TRUE(u.find(1) != u.end() && tracked_key::made == 1);
+}
+
+TEST_F(MapTest, node_handle) {
+  map<int, std::string> m;
+  for (int i = 0; i < 5; ++i) m[i] = std::string(1, char('a' + i));
+  const std::string *addr = &m[2];
+  map<int, std::string>::node_type nh = m.extract(2);
+  ASSERT_TRUE(m.size() == 4 && nh.key() == 2 && nh.mapped() == "c");
+  // 插回前修改键值，值对象不移动
+  nh.key() = 10;
+  map<int, std::string>::insert_return_type r = m.insert(TinySTL::move(nh));
+  ASSERT_TRUE(r.inserted && r.position->first == 10 && &m[10] == addr);
+
+  nh = m.extract(m.begin());
+  nh.key() = 1;
+  r = m.insert(TinySTL::move(nh));
+  ASSERT_TRUE(!r.inserted && r.position->second == "b" && r.node.mapped() == "a");
+
+  map<int, std::string> other;
+  other[1] = "x";
+  other[7] = "y";
+  m.merge(other);
+  ASSERT_TRUE(m.size() == 5 && m[7] == "y" && other.size() == 1 && other[1] == "x");
+
+  multimap<int, std::string> mm;
+  mm.insert(pair<const int, std::string>(1, "p"));
+  mm.merge(m);
+  mm.merge(other);
+  ASSERT_TRUE(m.empty() && other.empty() && mm.size() == 7 && mm.count(1) == 3);
+  m.merge(mm);
+  ASSERT_TRUE(m.size() == 5 && mm.size() == 2);
+  mm.insert(m.extract(1));
+  ASSERT_TRUE(mm.count(1) == 3 && m.count(1) == 0);
+}
+
+// 记录构造次数的 mapped 类型
+struct map_counted_value {
+  static int made;
+  int v;
+  map_counted_value() : v(0) { ++made; }
+  map_counted_value(int a, int b) : v(a + b) { ++made; }
+  map_counted_value(const map_counted_value &rhs) : v(rhs.v) { ++made; }
+  map_counted_value &operator=(const map_counted_value &) = default;
+};
+int map_counted_value::made = 0;
+
+TEST_F(MapTest, try_emplace) {
+  map<int, map_counted_value> m;
+  pair<map<int, map_counted_value>::iterator, bool> r = m.try_emplace(1, 2, 3);
+  ASSERT_TRUE(r.second && r.first->second.v == 5 && map_counted_value::made == 1);
+  map_counted_value::made = 0;
+  r = m.try_emplace(1, 7, 7);
+  ASSERT_TRUE(!r.second && r.first->second.v == 5);
+  ++m[1].v;
+  ASSERT_TRUE(map_counted_value::made == 0 && m[1].v == 6);
+  m[2];
+  ASSERT_TRUE(map_counted_value::made == 1 && m.size() == 2 && m[2].v == 0);
+
+  map<std::string, std::string> s;
+  std::string key = "k", val = "v";
+  ASSERT_TRUE(s.insert_or_assign(key, val).second && s["k"] == "v");
+  ASSERT_TRUE(!s.insert_or_assign("k", std::string("w")).second && s["k"] == "w");
+  ASSERT_TRUE(s.try_emplace(std::string("n"), 3, 'x').first->second == "xxx");
+  ASSERT_TRUE(s.emplace("e", "f").second && !s.emplace("e", "g").second && s["e"] == "f");
+  ASSERT_TRUE(s.size() == 3 && key == "k");
+
+  multimap<int, std::string> mm;
+  mm.emplace(1, "a");
+  mm.emplace(1, "b");
+  ASSERT_TRUE(mm.count(1) == 2);
+}
+
+TEST_F(MapTest, set_algebra) {
+  map<int, std::string> a, b;
+  for (int k = 0; k < 6; ++k) a[k] = "a";
+  for (int k = 4; k < 10; ++k) b[k] = "b";
+  map<int, std::string> u = a;
+  u.union_with(TinySTL::move(b));
+  ASSERT_TRUE(u.size() == 10 && u[5] == "a" && u[9] == "b" && b.empty());
+  for (int k = 4; k < 10; ++k) b[k] = "b";
+  map<int, std::string> i = a;
+  i.intersect_with(b);
+  ASSERT_TRUE(i.size() == 2 && i.begin()->first == 4 && i[5] == "a");
+  a.difference_with(b);
+  ASSERT_TRUE(a.size() == 4 && a.find(4) == a.end());
+}
+
+TEST_F(MapTest, split_join) {
+  map<int, std::string> m;
+  for (int i = 0; i < 50; ++i) m[i] = std::to_string(i);
+  map<int, std::string> shard = m.split(25);
+  ASSERT_TRUE(m.size() == 25 && shard.size() == 25);
+  ASSERT_TRUE(m.find(25) == m.end() && shard[25] == "25" && (--m.end())->first == 24);
+  shard.insert(pair<const int, std::string>(100, "x"));
+  m.join(TinySTL::move(shard));
+  ASSERT_TRUE(m.size() == 51 && shard.empty() && m[100] == "x" && m.begin()->first == 0);
+  map<int, std::string> tail = m.split(40);
+  map<int, std::string> back = join(TinySTL::move(m), TinySTL::move(tail));
+  ASSERT_TRUE(back.size() == 51 && back[39] == "39");
+}
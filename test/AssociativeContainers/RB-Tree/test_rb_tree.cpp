@@ -0,0 +1,327 @@
+#include "AssociativeContainers/RB-Tree/rb_tree.h"
+#include "Parallel/thread_pool.h"
+#include "SequenceContainers/List/stl_list.h"
+#include "SequenceContainers/Vector/stl_vector.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace ::TinySTL;
+
+namespace {
+
+using int_tree = rb_tree<int, int, identity<int>, less<int>>;
+using os_tree = rb_tree<int, int, identity<int>, less<int>, simpleAlloc<int>, rb_tree_size_augment>;
+using sum_tree = rb_tree<int, int, identity<int>, less<int>, simpleAlloc<int>,
+                         rb_tree_sum_augment<long, identity<int>>>;
+using min_tree = rb_tree<int, int, identity<int>, greater<int>, simpleAlloc<int>,
+                         rb_tree_min_augment<int, identity<int>>>;
+
+// 拷贝第 limit 次时抛出异常
+struct throwing_value {
+  static int copies;
+  static int limit;
+  int v;
+  throwing_value(int x) : v(x) {}
+  throwing_value(const throwing_value &rhs) : v(rhs.v) {
+    if (++copies == limit) throw std::runtime_error("copy");
+  }
+};
+int throwing_value::copies = 0;
+int throwing_value::limit = -1;
+
+struct throwing_key {
+  const int &operator()(const throwing_value &x) const { return x.v; }
+};
+
+}// namespace
+
+class RbTreeTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(RbTreeTest, linear_build_from_sorted) {
+  // 覆盖满二叉树与最底层不满的各种大小
+  for (int n = 0; n <= 70; ++n) {
+    vector<int> v;
+    for (int i = 0; i < n; ++i) v.push_back(i * 2);
+    int_tree t;
+    t.insert_unique(v.begin(), v.end());
+    ASSERT_TRUE(t.rb_verify());
+    ASSERT_TRUE(t.size() == static_cast<size_t>(n));
+    ASSERT_TRUE(TinySTL::equal(t.begin(), t.end(), v.begin()));
+    if (n > 0) {
+      ASSERT_TRUE(*t.begin() == 0 && *--t.end() == 2 * (n - 1));
+      // 建树后可继续正常插入删除
+      t.insert_unique(1);
+      t.erase(t.begin());
+      ASSERT_TRUE(t.rb_verify());
+    }
+  }
+
+  // 有序但含重复：unique 跳过重复，equal 全部保留
+  int dup[] = {1, 1, 2, 3, 3, 3, 4, 5, 5};
+  int_tree u;
+  u.insert_unique(dup, dup + 9);
+  ASSERT_TRUE(u.size() == 5 && u.rb_verify());
+  int_tree e;
+  e.insert_equal(dup, dup + 9);
+  ASSERT_TRUE(e.size() == 9 && e.rb_verify());
+  ASSERT_TRUE(e.count(3) == 3);
+  ASSERT_TRUE(TinySTL::equal(e.begin(), e.end(), dup));
+
+  // 无序输入与非空树仍走逐个插入
+  int unsorted[] = {5, 3, 9, 1, 3};
+  u.insert_unique(unsorted, unsorted + 5);
+  ASSERT_TRUE(u.size() == 6 && u.rb_verify());
+  int_tree w;
+  w.insert_unique(unsorted, unsorted + 5);
+  ASSERT_TRUE(w.size() == 4 && w.rb_verify());
+
+  // 双向但非随机访问的输入
+  list<int> l;
+  for (int i = 0; i < 100; ++i) l.push_back(i / 3);
+  int_tree from_list;
+  from_list.assign_sorted_equal(l.begin(), l.end());
+  ASSERT_TRUE(from_list.size() == 100 && from_list.rb_verify());
+  from_list.assign_sorted_unique(l.begin(), l.end());
+  ASSERT_TRUE(from_list.size() == 34 && from_list.rb_verify());
+}
+
+TEST_F(RbTreeTest, linear_build_exception_safety) {
+  using tree = rb_tree<int, throwing_value, throwing_key, less<int>>;
+  vector<throwing_value> v;
+  for (int i = 0; i < 50; ++i) v.push_back(throwing_value(i));
+  throwing_value::copies = 0;
+  throwing_value::limit = 30;
+  tree t;
+  ASSERT_THROW(t.insert_unique(v.begin(), v.end()), std::runtime_error);
+  ASSERT_TRUE(t.empty() && t.rb_verify());
+  throwing_value::limit = -1;
+  t.insert_unique(v.begin(), v.end());
+  ASSERT_TRUE(t.size() == 50 && t.rb_verify());
+}
+
+TEST_F(RbTreeTest, insert_equal_with_hint) {
+  int_tree t;
+  for (int i = 0; i < 20; ++i) t.insert_equal(t.end(), i / 2);
+  ASSERT_TRUE(t.size() == 20 && t.rb_verify());
+  t.insert_equal(t.begin(), -1);
+  t.insert_equal(t.find(5), 5);
+  t.insert_equal(t.begin(), 100);// 提示错误时退化为普通插入
+  ASSERT_TRUE(t.rb_verify());
+  ASSERT_TRUE(t.count(5) == 3 && *t.begin() == -1 && *--t.end() == 100);
+}
+
+TEST_F(RbTreeTest, order_statistic) {
+  // 随机插入删除，与有序 std::vector 对照 nth / rank / count_range
+  std::mt19937 rng(7);
+  os_tree t;
+  std::vector<int> ref;
+  for (int op = 0; op < 4000; ++op) {
+    int k = static_cast<int>(rng() % 300);
+    if (rng() % 3 == 0 && !ref.empty()) {
+      auto it = std::lower_bound(ref.begin(), ref.end(), k);
+      if (it == ref.end()) --it;
+      t.erase(t.find(*it));
+      ref.erase(it);
+    } else {
+      t.insert_equal(k);
+      ref.insert(std::upper_bound(ref.begin(), ref.end(), k), k);
+    }
+    if (op % 97 == 0) {
+      ASSERT_TRUE(t.rb_verify());
+    }
+  }
+  ASSERT_TRUE(t.rb_verify() && t.size() == ref.size());
+  for (size_t i = 0; i < ref.size(); ++i) ASSERT_TRUE(*t.nth(i) == ref[i]);
+  ASSERT_TRUE(t.nth(ref.size()) == t.end());
+  for (int k = -1; k <= 301; ++k) {
+    size_t r = std::lower_bound(ref.begin(), ref.end(), k) - ref.begin();
+    ASSERT_TRUE(t.rank(k) == r);
+    size_t c = std::lower_bound(ref.begin(), ref.end(), k + 10) - ref.begin() - r;
+    ASSERT_TRUE(t.count_range(k, k + 10) == c);
+  }
+  ASSERT_TRUE(t.count_range(10, 5) == 0);
+
+  // 拷贝与线性建树同样维护子树大小
+  os_tree u(t);
+  ASSERT_TRUE(u.rb_verify() && *u.nth(ref.size() / 2) == ref[ref.size() / 2]);
+  os_tree v;
+  v.insert_equal(ref.data(), ref.data() + ref.size());
+  ASSERT_TRUE(v.rb_verify() && *v.nth(ref.size() - 1) == ref.back());
+  v.erase(v.begin(), v.nth(ref.size() / 2));
+  ASSERT_TRUE(v.rb_verify() && v.size() == ref.size() - ref.size() / 2);
+}
+
+TEST_F(RbTreeTest, aggregate_augment) {
+  std::mt19937 rng(11);
+  sum_tree s;
+  min_tree m;
+  std::vector<int> ref;
+  for (int op = 0; op < 3000; ++op) {
+    int k = static_cast<int>(rng() % 1000) - 500;
+    if (rng() % 3 == 0 && !ref.empty()) {
+      size_t i = rng() % ref.size();
+      s.erase(s.find(ref[i]));
+      m.erase(m.find(ref[i]));
+      ref.erase(ref.begin() + i);
+    } else {
+      s.insert_equal(k);
+      m.insert_equal(k);
+      ref.push_back(k);
+    }
+    if (ref.empty()) continue;
+    long sum = 0;
+    for (int x : ref) sum += x;
+    ASSERT_TRUE(s.aggregate() == sum);
+    ASSERT_TRUE(m.aggregate() == *std::min_element(ref.begin(), ref.end()));
+  }
+  ASSERT_TRUE(s.rb_verify() && m.rb_verify());
+
+  // 以子树和剪枝：求所有正数之和时跳过和为 0 的子树，visit 返回 false 即停止
+  sum_tree p;
+  for (int i = 0; i < 100; ++i) p.insert_equal(i % 10 == 0 ? i : 0);
+  long visited = 0, total = 0;
+  p.augmented_visit([](long sub) { return sub == 0; },
+                    [&](sum_tree::iterator it) {
+                      ++visited;
+                      total += *it;
+                      return *it < 50;
+                    });
+  ASSERT_TRUE(total == 10 + 20 + 30 + 40 + 50);
+  ASSERT_TRUE(visited < 100);
+}
+
+TEST_F(RbTreeTest, node_handle) {
+  os_tree a, b;
+  for (int i = 0; i < 50; ++i) a.insert_unique(i * 2);
+  for (int i = 0; i < 50; ++i) b.insert_unique(i * 3);
+  const int *addr = &*a.find(42);
+  os_tree::node_type nh = a.extract(42);
+  ASSERT_TRUE(!nh.empty() && nh.value() == 42 && a.count(42) == 0);
+  ASSERT_TRUE(a.rb_verify() && a.size() == 49 && a.rank(44) == 21);
+  ASSERT_TRUE(a.extract(41).empty());
+
+  // 重复键插入失败，节点交还调用者
+  os_tree::insert_return_type r = b.insert_unique(TinySTL::move(nh));
+  ASSERT_TRUE(!r.inserted && *r.position == 42 && r.node.value() == 42);
+  r.node.value() = 43;
+  r = b.insert_unique(TinySTL::move(r.node));
+  ASSERT_TRUE(r.inserted && r.node.empty() && &*r.position == addr && b.rb_verify());
+
+  // merge 只移动不重复的节点，重复者留在源树
+  a.merge_unique(b);
+  ASSERT_TRUE(a.rb_verify() && b.rb_verify());
+  ASSERT_TRUE(b.size() == 16 && a.size() == 49 + 51 - 16);
+  for (auto it = b.begin(); it != b.end(); ++it) ASSERT_TRUE(*it % 6 == 0);
+  for (size_t k = 0; k < a.size(); ++k) ASSERT_TRUE(a.rank(*a.nth(k)) == k);
+
+  a.merge_equal(b);
+  ASSERT_TRUE(b.empty() && a.size() == 100 && a.count(0) == 2 && a.rb_verify());
+  ASSERT_TRUE(*a.insert_equal(a.extract(a.begin())) == 0 && a.count(0) == 2);
+}
+
+TEST_F(RbTreeTest, set_algebra) {
+  std::mt19937 gen(47);
+  thread_pool pool(4);
+  // 规模悬殊与相近的组合，覆盖 join 两侧黑高不同的情形
+  const int sizes[][2] = {{0, 10}, {1, 1000}, {1000, 3}, {500, 700}, {3000, 2500}, {20000, 40}};
+  for (auto &sz : sizes) {
+    for (int op = 0; op < 3; ++op) {
+      for (int par = 0; par < 2; ++par) {
+        std::set<int> ra, rb;
+        os_tree a, b;
+        while (static_cast<int>(ra.size()) < sz[0]) ra.insert(static_cast<int>(gen() % 40000));
+        while (static_cast<int>(rb.size()) < sz[1]) rb.insert(static_cast<int>(gen() % 40000));
+        for (int v : ra) a.insert_unique(v);
+        for (int v : rb) b.insert_unique(v);
+        std::vector<int> expect;
+        if (op == 0) {
+          std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(), std::back_inserter(expect));
+          if (par) a.parallel_union_with(TinySTL::move(b), pool, 64);
+          else a.union_with(TinySTL::move(b));
+          ASSERT_TRUE(b.empty() && b.rb_verify());
+        } else if (op == 1) {
+          std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), std::back_inserter(expect));
+          if (par) a.parallel_intersect_with(b, pool, 64);
+          else a.intersect_with(b);
+          ASSERT_TRUE(b.size() == rb.size());
+        } else {
+          std::set_difference(ra.begin(), ra.end(), rb.begin(), rb.end(), std::back_inserter(expect));
+          if (par) a.parallel_difference_with(b, pool, 64);
+          else a.difference_with(b);
+          ASSERT_TRUE(b.size() == rb.size());
+        }
+        ASSERT_TRUE(a.rb_verify() && a.size() == expect.size());
+        ASSERT_TRUE(std::equal(expect.begin(), expect.end(), a.begin()));
+      }
+    }
+  }
+
+  // 与自身运算
+  int_tree t;
+  for (int i = 0; i < 10; ++i) t.insert_unique(i);
+  t.intersect_with(t);
+  ASSERT_TRUE(t.size() == 10 && t.rb_verify());
+  t.difference_with(t);
+  ASSERT_TRUE(t.empty() && t.rb_verify());
+
+  // 左值版本先复制 other
+  int_tree u, v;
+  for (int i = 0; i < 10; ++i) u.insert_unique(i), v.insert_unique(i + 5);
+  u.union_with(v);
+  ASSERT_TRUE(u.size() == 15 && v.size() == 10 && u.rb_verify());
+
+  // 聚合附加数据在 split / join 后保持正确
+  sum_tree s1, s2;
+  for (int i = 1; i <= 100; ++i) (i % 2 ? s1 : s2).insert_unique(i);
+  s1.union_with(TinySTL::move(s2));
+  ASSERT_TRUE(s1.aggregate() == 5050 && s1.rb_verify());
+}
+
+TEST_F(RbTreeTest, split_join) {
+  std::mt19937 gen(50);
+  for (int n : {0, 1, 2, 7, 100, 3000}) {
+    for (int trial = 0; trial < 5; ++trial) {
+      std::vector<int> ref;
+      int_tree t;
+      os_tree s;
+      for (int i = 0; i < n; ++i) {
+        int v = static_cast<int>(gen() % (4 * n + 1));
+        if (t.insert_unique(v).second) ref.push_back(v);
+        s.insert_unique(v);
+      }
+      std::sort(ref.begin(), ref.end());
+      const int k = static_cast<int>(gen() % (4 * n + 3)) - 1;
+      const size_t lo = std::lower_bound(ref.begin(), ref.end(), k) - ref.begin();
+
+      int_tree hi = t.split(k);
+      os_tree shi = s.split(k);
+      ASSERT_TRUE(t.rb_verify() && hi.rb_verify() && s.rb_verify() && shi.rb_verify());
+      ASSERT_TRUE(t.size() == lo && hi.size() == ref.size() - lo);
+      ASSERT_TRUE(s.size() == lo && shi.size() == ref.size() - lo);
+      ASSERT_TRUE(std::equal(t.begin(), t.end(), ref.begin()));
+      ASSERT_TRUE(std::equal(hi.begin(), hi.end(), ref.begin() + lo));
+
+      t.join(TinySTL::move(hi));
+      s.join(TinySTL::move(shi));
+      ASSERT_TRUE(hi.empty() && hi.rb_verify() && shi.empty());
+      ASSERT_TRUE(t.rb_verify() && s.rb_verify() && t.size() == ref.size());
+      ASSERT_TRUE(std::equal(t.begin(), t.end(), ref.begin()));
+      for (size_t i = 0; i < s.size(); ++i) ASSERT_TRUE(*s.nth(i) == ref[i]);
+    }
+  }
+
+  // 重复键值：不小于 k 的全部进入右侧
+  int_tree m;
+  for (int i = 0; i < 30; ++i) m.insert_equal(i % 3);
+  int_tree r = m.split(1);
+  ASSERT_TRUE(m.size() == 10 && r.size() == 20 && r.count(1) == 10 && m.rb_verify() && r.rb_verify());
+  m.join(TinySTL::move(r));
+  ASSERT_TRUE(m.size() == 30 && m.count(2) == 10 && m.rb_verify());
+}
@@ -1,5 +1,8 @@
+#include "AssociativeContainers/Set/stl_multiset.h"
 #include "AssociativeContainers/Set/stl_set.h"
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
 
 using namespace ::TinySTL;
 
@@ -239,3 +242,139 @@ TEST_F(SetTest, template_methods) {
   ASSERT_TRUE(ckeySet.upper_bound(2) != ckeySet.end());
   ASSERT_TRUE(ckeySet.equal_range(2) != make_pair(ckeySet.begin(), ckeySet.end()));
 }
+
+TEST_F(SetTest, order_statistic) {
+  set<int, less<int>, simpleAlloc<int>, rb_tree_size_augment> s;
+  for (int i = 0; i < 100; ++i) s.insert((i * 37) % 100);
+  ASSERT_TRUE(*s.nth(0) == 0 && *s.nth(42) == 42 && s.nth(100) == s.end());
+  ASSERT_TRUE(s.rank(50) == 50 && s.rank(1000) == 100);
+  ASSERT_TRUE(s.count_range(10, 20) == 10);
+  s.erase(15);
+  ASSERT_TRUE(s.count_range(10, 20) == 9 && *s.nth(15) == 16);
+
+  multiset<int, less<int>, simpleAlloc<int>, rb_tree_size_augment> ms{3, 1, 3, 2, 3};
+  ASSERT_TRUE(ms.size() == 5 && ms.count(3) == 3);
+  ASSERT_TRUE(*ms.nth(1) == 2 && *ms.nth(4) == 3);
+  ASSERT_TRUE(ms.rank(3) == 2 && ms.count_range(2, 4) == 4);
+  ASSERT_TRUE(ms.erase(3) == 3 && ms.size() == 2);
+
+  // 默认不附加数据，节点大小不变
+  multiset<int> plain{2, 2, 1};
+  ASSERT_TRUE(plain.size() == 3 && *plain.begin() == 1);
+}
+
+TEST_F(SetTest, transparent_lookup) {
+  set<std::string, less<>> s{"alpha", "beta", "gamma"};
+  ASSERT_TRUE(s.find("beta") != s.end() && s.count("delta") == 0);
+  ASSERT_TRUE(*s.lower_bound("b") == "beta");
+  ASSERT_TRUE(s.equal_range("gamma").first != s.end());
+
+  multiset<std::string, less<>> ms{"x", "x", "y"};
+  ASSERT_TRUE(ms.count("x") == 2 && *ms.upper_bound("x") == "y");
+
+  set<int, greater<>> g{1, 5, 3};
+  ASSERT_TRUE(*g.begin() == 5 && g.find(3L) != g.end());
+}
+
+TEST_F(SetTest, node_handle) {
+  set<std::string> s{"a", "b", "c"};
+  const std::string *addr = &*s.find("b");
+  set<std::string>::node_type nh = s.extract(s.find("b"));
+  ASSERT_TRUE(s.size() == 2 && nh.value() == "b");
+  nh.value() = "z";
+  set<std::string>::insert_return_type r = s.insert(TinySTL::move(nh));
+  ASSERT_TRUE(r.inserted && *r.position == "z" && &*r.position == addr && nh.empty());
+  r = s.insert(s.extract("a"));
+  ASSERT_TRUE(r.inserted && s.size() == 3);
+
+  set<std::string> t{"a", "y"};
+  t.insert(t.extract("y"));
+  s.merge(t);
+  ASSERT_TRUE(s.size() == 4 && t.size() == 1 && *t.begin() == "a");
+
+  multiset<std::string> ms{"a", "a", "q"};
+  s.merge(ms);
+  ASSERT_TRUE(s.size() == 5 && ms.size() == 2 && ms.count("a") == 2);
+  ms.merge(s);
+  ASSERT_TRUE(s.empty() && ms.size() == 7 && ms.count("a") == 3);
+  multiset<std::string>::iterator it = ms.insert(ms.extract("q"));
+  ASSERT_TRUE(*it == "q" && ms.size() == 7);
+  ASSERT_TRUE(ms.extract("none").empty());
+}
+
+TEST_F(SetTest, set_algebra) {
+  set<int> a{1, 2, 3, 4, 5}, b{4, 5, 6};
+  set<int> u = a;
+  u.union_with(b);
+  ASSERT_TRUE(u == set<int>({1, 2, 3, 4, 5, 6}) && b.size() == 3);
+  set<int> i = a;
+  i.intersect_with(b);
+  ASSERT_TRUE(i == set<int>({4, 5}));
+  set<int> d = a;
+  d.difference_with(b);
+  ASSERT_TRUE(d == set<int>({1, 2, 3}));
+
+  // 右值版本直接链接 b 的节点
+  const int *addr = &*b.find(6);
+  a.union_with(TinySTL::move(b));
+  ASSERT_TRUE(b.empty() && a.size() == 6 && &*a.find(6) == addr);
+}
+
+TEST_F(SetTest, split_join) {
+  set<int> s;
+  for (int i = 0; i < 100; ++i) s.insert(i);
+  const int *addr = &*s.find(70);
+  set<int> hi = s.split(60);
+  ASSERT_TRUE(s.size() == 60 && hi.size() == 40 && *hi.begin() == 60 && *s.rbegin() == 59);
+  ASSERT_TRUE(&*hi.find(70) == addr);
+  set<int> all = join(TinySTL::move(s), TinySTL::move(hi));
+  ASSERT_TRUE(all.size() == 100 && s.empty() && hi.empty() && *all.rbegin() == 99);
+  ASSERT_TRUE(all.split(1000).empty() && all.split(-1).size() == 100 && all.empty());
+}
+
+// 复制次数达到 copies_left 时抛出异常
+struct set_throwing_value {
+  static int copies_left;
+  static int live;
+  int v;
+  set_throwing_value(int x) : v(x) { ++live; }
+  set_throwing_value(const set_throwing_value &rhs) : v(rhs.v) {
+    if (copies_left >= 0 && copies_left-- == 0) throw std::runtime_error("set_throwing_value");
+    ++live;
+  }
+  ~set_throwing_value() { --live; }
+  bool operator<(const set_throwing_value &rhs) const { return v < rhs.v; }
+};
+int set_throwing_value::copies_left = -1;
+int set_throwing_value::live = 0;
+
+TEST_F(SetTest, union_copy_throws) {
+  {
+    set<set_throwing_value> a, b;
+    for (int i = 0; i < 20; ++i) a.insert(set_throwing_value(i * 2));
+    for (int i = 0; i < 30; ++i) b.insert(set_throwing_value(i * 3));
+    const int live = set_throwing_value::live;
+
+    // 复制 b 的第 15 个元素时失败：异常传出，a 与 b 均不变，不泄漏节点
+    set_throwing_value::copies_left = 14;
+    ASSERT_THROW(a.union_with(b), std::runtime_error);
+    set_throwing_value::copies_left = -1;
+    ASSERT_TRUE(a.size() == 20 && b.size() == 30);
+    ASSERT_TRUE(set_throwing_value::live == live);
+    int i = 0;
+    for (auto it = a.begin(); it != a.end(); ++it, ++i) ASSERT_TRUE(it->v == i * 2);
+
+    // 复制构造与赋值同样传出异常
+    set_throwing_value::copies_left = 14;
+    ASSERT_THROW(set<set_throwing_value> c(b), std::runtime_error);
+    set_throwing_value::copies_left = 14;
+    set<set_throwing_value> d;
+    ASSERT_THROW(d = b, std::runtime_error);
+    set_throwing_value::copies_left = -1;
+    ASSERT_TRUE(d.empty() && set_throwing_value::live == live);
+
+    a.union_with(b);
+    ASSERT_TRUE(a.size() == 43);
+  }
+  ASSERT_TRUE(set_throwing_value::live == 0);
+}
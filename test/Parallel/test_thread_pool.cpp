@@ -0,0 +1,79 @@
+#include "Parallel/thread_pool.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace ::TinySTL;
+
+class ThreadPoolTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+static long long fib_serial(int n) { return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+// 嵌套的 spawn / sync
+static long long fib_parallel(thread_pool &pool, int n) {
+  if (n < 16) return fib_serial(n);
+  long long a = 0, b = 0;
+  task_group g(pool);
+  g.spawn([&pool, &a, n] { a = fib_parallel(pool, n - 1); });
+  b = fib_parallel(pool, n - 2);
+  g.sync();
+  return a + b;
+}
+
+TEST_F(ThreadPoolTest, spawn_and_sync) {
+  thread_pool pool(4);
+  ASSERT_TRUE(pool.size() == 4);
+
+  std::atomic<int> count(0);
+  task_group g(pool);
+  for (int i = 0; i < 1000; ++i) g.spawn([&count] { count.fetch_add(1); });
+  g.sync();
+  ASSERT_TRUE(count.load() == 1000);
+
+  ASSERT_TRUE(fib_parallel(pool, 25) == fib_serial(25));
+}
+
+TEST_F(ThreadPoolTest, parallel_for) {
+  thread_pool pool(3);
+  std::vector<int> v(100000, 0);
+  pool.parallel_for(size_t(0), v.size(), [&v](size_t i) { v[i] += static_cast<int>(i % 7); });
+  for (size_t i = 0; i < v.size(); ++i) ASSERT_TRUE(v[i] == static_cast<int>(i % 7));
+
+  // 显式指定 grain，并在任务内部嵌套 parallel_for
+  std::atomic<long long> sum(0);
+  pool.parallel_for(0, 10, [&pool, &sum](int i) {
+    pool.parallel_for(0, 100, [&sum, i](int j) { sum.fetch_add(i * 100 + j); }, 8);
+  }, 1);
+  ASSERT_TRUE(sum.load() == 999 * 1000 / 2);
+
+  pool.parallel_for(5, 5, [](int) { FAIL(); });
+
+  int left = 0, right = 0;
+  pool.parallel_invoke([&left] { left = 1; }, [&right] { right = 2; });
+  ASSERT_TRUE(left == 1 && right == 2);
+}
+
+TEST_F(ThreadPoolTest, exception_and_default_pool) {
+  thread_pool pool(2);
+  std::atomic<int> finished(0);
+  task_group g(pool);
+  for (int i = 0; i < 64; ++i) {
+    g.spawn([&finished, i] {
+      if (i == 10) throw std::runtime_error("task failed");
+      finished.fetch_add(1);
+    });
+  }
+  ASSERT_THROW(g.sync(), std::runtime_error);
+  ASSERT_TRUE(finished.load() == 63);// 其余任务照常完成
+  g.sync();// 异常只抛出一次
+
+  thread_pool &shared = default_thread_pool();
+  ASSERT_TRUE(&shared == &default_thread_pool());
+  std::atomic<int> count(0);
+  shared.parallel_for(0, 1000, [&count](int) { count.fetch_add(1); });
+  ASSERT_TRUE(count.load() == 1000);
+}
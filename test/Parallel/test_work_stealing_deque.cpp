@@ -0,0 +1,63 @@
+#include "Parallel/work_stealing_deque.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace ::TinySTL;
+
+class WorkStealingDequeTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(WorkStealingDequeTest, owner_and_thief_ends) {
+  work_stealing_deque<int> d(2);
+  int out = 0;
+  ASSERT_TRUE(d.empty());
+  ASSERT_FALSE(d.pop(out));
+  ASSERT_FALSE(d.steal(out));
+
+  for (int i = 0; i < 100; ++i) d.push(i);// 多次扩容
+  ASSERT_TRUE(d.size() == 100);
+
+  // 所有者从 bottom 端取（LIFO），窃取者从 top 端取（FIFO）
+  ASSERT_TRUE(d.pop(out) && out == 99);
+  ASSERT_TRUE(d.steal(out) && out == 0);
+  ASSERT_TRUE(d.steal(out) && out == 1);
+  ASSERT_TRUE(d.pop(out) && out == 98);
+  ASSERT_TRUE(d.size() == 96);
+
+  while (d.pop(out)) {}
+  ASSERT_TRUE(d.empty());
+  ASSERT_FALSE(d.steal(out));
+}
+
+TEST_F(WorkStealingDequeTest, concurrent_steal) {
+  constexpr int total = 200000;
+  constexpr int thieves = 3;
+  work_stealing_deque<int> d(16);
+  std::vector<std::atomic<int>> seen(total);
+  std::atomic<bool> done(false);
+
+  std::vector<std::thread> threads;
+  for (int k = 0; k < thieves; ++k) {
+    threads.emplace_back([&] {
+      int x;
+      while (!done.load(std::memory_order_acquire) || !d.empty())
+        if (d.steal(x)) seen[x].fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  // 所有者交替 push 与 pop，最后一个元素上与窃取者竞争
+  int x;
+  for (int i = 0; i < total; ++i) {
+    d.push(i);
+    if (i % 3 == 0 && d.pop(x)) seen[x].fetch_add(1, std::memory_order_relaxed);
+  }
+  while (d.pop(x)) seen[x].fetch_add(1, std::memory_order_relaxed);
+  done.store(true, std::memory_order_release);
+  for (auto &t : threads) t.join();
+
+  // 每个元素恰好被取出一次
+  for (int i = 0; i < total; ++i) ASSERT_TRUE(seen[i].load() == 1) << i;
+}
@@ -0,0 +1,108 @@
+#include "SequenceContainers/CircularBuffer/stl_circular_buffer.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace ::TinySTL;
+
+class CircularBufferTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(CircularBufferTest, overwrite_policy) {
+  circular_buffer<int> cb(4);
+  ASSERT_TRUE(cb.empty() && cb.capacity() == 4 && cb.reserve() == 4);
+
+  for (int i = 0; i < 10; ++i) ASSERT_TRUE(cb.push_back(i));
+  // 只保留最近的 4 个样本
+  ASSERT_TRUE(cb.full() && cb.size() == 4);
+  ASSERT_TRUE(cb.front() == 6 && cb.back() == 9);
+  for (int i = 0; i < 4; ++i) ASSERT_TRUE(cb[i] == 6 + i);
+
+  // push_front 在已满时覆盖队尾
+  ASSERT_TRUE(cb.push_front(5));
+  ASSERT_TRUE(cb.front() == 5 && cb.back() == 8);
+
+  cb.pop_front();
+  cb.pop_back();
+  ASSERT_TRUE(cb.size() == 2 && cb.front() == 6 && cb.back() == 7);
+  cb.clear();
+  ASSERT_TRUE(cb.empty());
+
+  circular_buffer<int> empty(0);
+  ASSERT_FALSE(empty.push_back(1));
+}
+
+TEST_F(CircularBufferTest, reject_policy) {
+  circular_buffer<std::string, circular_buffer_policy::reject> cb(3);
+  ASSERT_TRUE(cb.push_back("a"));
+  ASSERT_TRUE(cb.emplace_back(2, 'b'));
+  ASSERT_TRUE(cb.push_front("z"));
+  ASSERT_FALSE(cb.push_back("c"));
+  ASSERT_FALSE(cb.emplace_front("y"));
+  ASSERT_TRUE(cb.size() == 3);
+  ASSERT_TRUE(cb[0] == "z" && cb[1] == "a" && cb[2] == "bb");
+
+  cb.pop_front();
+  ASSERT_TRUE(cb.push_back("c"));
+  ASSERT_TRUE(cb.back() == "c");
+
+  // 拷贝、移动与比较
+  circular_buffer<std::string, circular_buffer_policy::reject> copy(cb);
+  ASSERT_TRUE(copy == cb);
+  circular_buffer<std::string, circular_buffer_policy::reject> moved(TinySTL::move(copy));
+  ASSERT_TRUE(moved == cb && copy.empty());
+  moved.pop_back();
+  ASSERT_TRUE(moved != cb);
+  moved = cb;
+  ASSERT_TRUE(moved == cb);
+}
+
+TEST_F(CircularBufferTest, random_access_iterator) {
+  std::vector<int> src = {1, 2, 3, 4, 5, 6, 7};
+  circular_buffer<int> cb(5, src.begin(), src.end());
+  ASSERT_TRUE(cb.size() == 5 && cb.front() == 3);
+
+  auto first = cb.begin();
+  auto last = cb.end();
+  ASSERT_TRUE(last - first == 5);
+  ASSERT_TRUE(first[4] == 7 && *(first + 2) == 5 && *(last - 1) == 7);
+  ASSERT_TRUE(first < last && last >= first);
+
+  int expected = 3;
+  for (int x : cb) ASSERT_TRUE(x == expected++);
+  expected = 7;
+  for (auto it = cb.rbegin(); it != cb.rend(); ++it) ASSERT_TRUE(*it == expected--);
+
+  for (auto it = cb.begin(); it != cb.end(); ++it) *it *= 10;
+  circular_buffer<int>::const_iterator cit = cb.begin();
+  ASSERT_TRUE(*cit == 30 && cit == cb.cbegin());
+}
+
+TEST_F(CircularBufferTest, two_spans_and_sliding_window) {
+  circular_buffer<double> window(8);
+  for (int i = 0; i < 5; ++i) window.push_back(i);
+
+  // 未回绕：第二段为空
+  auto halves = window.as_two_spans();
+  ASSERT_TRUE(halves.first.size() == 5 && halves.second.empty());
+
+  for (int i = 5; i < 12; ++i) window.push_back(i);
+  halves = window.as_two_spans();
+  ASSERT_TRUE(halves.first.size() + halves.second.size() == 8);
+  ASSERT_TRUE(halves.first.size() == 4 && halves.first.front() == 4);
+  ASSERT_TRUE(halves.second.front() == 8 && halves.second.back() == 11);
+  double sum = 0;
+  for (double x : halves.first) sum += x;
+  for (double x : halves.second) sum += x;
+  ASSERT_TRUE(sum == 4 + 5 + 6 + 7 + 8 + 9 + 10 + 11);
+
+  // 一次丢弃跨越回绕点的若干旧样本
+  window.pop_front_n(6);
+  ASSERT_TRUE(window.size() == 2 && window.front() == 10 && window.back() == 11);
+  window.pop_front_n(2);
+  ASSERT_TRUE(window.empty());
+  window.push_back(42);
+  ASSERT_TRUE(window.front() == 42);
+}
@@ -404,4 +404,282 @@ TEST_F(DequeTest, erase) {
 
   dint.erase(dint.end() - 2, dint.end());
   ASSERT_TRUE(*it == 4);
-}
\ No newline at end of file
+}
+TEST_F(DequeTest, BUFFER_SIZE) {
+  // 缓冲区大小总是 2 的幂
+  ASSERT_TRUE(deque<int>::iterator::buffer_size() == 128);
+  ASSERT_TRUE((deque<char[24]>::iterator::buffer_size() == 16));
+  ASSERT_TRUE((deque<char[1024]>::iterator::buffer_size() == 1));
+  ASSERT_TRUE((deque<int, simpleAlloc<int>, 100>::iterator::buffer_size() == 64));
+  ASSERT_TRUE((deque<int, simpleAlloc<int>, 64>::iterator::buffer_shift() == 6));
+
+  // 较小的缓冲区使随机访问频繁跨越节点
+  deque<int, simpleAlloc<int>, 3> dq;
+  for (int i = 0; i < 100; ++i) dq.push_back(i);
+  for (int i = -1; i >= -20; --i) dq.push_front(i);
+  ASSERT_TRUE(dq.size() == 120);
+  for (int i = 0; i < 120; ++i) ASSERT_TRUE(dq[i] == i - 20);
+
+  auto it = dq.begin() + 57;
+  ASSERT_TRUE(*it == 37);
+  ASSERT_TRUE(*(it - 50) == -13);
+  ASSERT_TRUE(*(it + 62) == 99);
+  ASSERT_TRUE(it[-57] == -20);
+  ASSERT_TRUE(dq.end() - it == 63);
+  ASSERT_TRUE(it - dq.begin() == 57);
+
+  dq.erase(dq.begin() + 10, dq.begin() + 30);
+  ASSERT_TRUE(dq.size() == 100);
+  ASSERT_TRUE(dq[10] == 10);
+  while (!dq.empty()) dq.pop_back();
+  ASSERT_TRUE(dq.begin() == dq.end());
+}
+
+TEST_F(DequeTest, SEGMENTED_ALGORITHMS) {
+  using small_deque = deque<int, simpleAlloc<int>, 8>;
+  int arr[100];
+  for (int i = 0; i < 100; ++i) arr[i] = i;
+
+  // 指针 -> 分段
+  small_deque dq(100, 0);
+  auto it = TinySTL::copy(arr, arr + 100, dq.begin());
+  ASSERT_TRUE(it == dq.end());
+  ASSERT_TRUE(TinySTL::equal(dq.begin(), dq.end(), arr));
+
+  // 分段 -> 指针
+  int out[100] = {0};
+  ASSERT_TRUE(TinySTL::copy(dq.begin() + 3, dq.begin() + 77, out) == out + 74);
+  for (int i = 0; i < 74; ++i) ASSERT_TRUE(out[i] == i + 3);
+
+  // 分段 -> 分段（段边界互不对齐）
+  small_deque dq2(120, -1);
+  TinySTL::copy(dq.begin() + 5, dq.end(), dq2.begin() + 11);
+  for (int i = 0; i < 95; ++i) ASSERT_TRUE(dq2[i + 11] == i + 5);
+  ASSERT_TRUE(dq2[10] == -1);
+  ASSERT_TRUE(dq2[106] == -1);
+
+  // 重叠区间的前移与后移
+  TinySTL::copy(dq.begin() + 13, dq.end(), dq.begin() + 2);
+  for (int i = 2; i < 89; ++i) ASSERT_TRUE(dq[i] == i + 11);
+  TinySTL::copy(arr, arr + 100, dq.begin());
+  auto bit = TinySTL::copy_backward(dq.begin(), dq.begin() + 87, dq.end());
+  ASSERT_TRUE(bit == dq.begin() + 13);
+  for (int i = 13; i < 100; ++i) ASSERT_TRUE(dq[i] == i - 13);
+  TinySTL::copy_backward(arr, arr + 50, dq.begin() + 61);
+  for (int i = 11; i < 61; ++i) ASSERT_TRUE(dq[i] == i - 11);
+
+  TinySTL::fill(dq.begin() + 7, dq.begin() + 93, 42);
+  ASSERT_TRUE(dq[6] != 42);
+  for (int i = 7; i < 93; ++i) ASSERT_TRUE(dq[i] == 42);
+  ASSERT_TRUE(dq[93] != 42);
+  ASSERT_TRUE(!TinySTL::equal(dq.begin(), dq.end(), arr));
+
+  // 非 POD 元素走逐段 uninitialized_copy / uninitialized_fill / destroy
+  deque<string, simpleAlloc<string>, 4> ds(30, "x");
+  string strs[30];
+  for (int i = 0; i < 30; ++i) strs[i] = std::to_string(i);
+  ds.insert(ds.begin() + 10, strs, strs + 30);
+  ASSERT_TRUE(ds.size() == 60);
+  ASSERT_TRUE(TinySTL::equal(ds.begin() + 10, ds.begin() + 40, strs));
+  deque<string, simpleAlloc<string>, 4> ds2(ds);
+  ASSERT_TRUE(ds2 == ds);
+  ds2.erase(ds2.begin() + 3, ds2.begin() + 50);
+  ASSERT_TRUE(ds2.size() == 13);
+  ASSERT_TRUE(ds2[3] == "x");
+}
+
+TEST_F(DequeTest, BULK_PUSH_AND_POP) {
+  deque<int, simpleAlloc<int>, 16> dq;
+  int arr[100];
+  for (int i = 0; i < 100; ++i) arr[i] = i;
+
+  dq.append(arr + 50, arr + 100);
+  dq.prepend(arr, arr + 50);
+  ASSERT_TRUE(dq.size() == 100);
+  ASSERT_TRUE(TinySTL::equal(dq.begin(), dq.end(), arr));
+
+  dq.append(dq.begin(), dq.begin());
+  dq.prepend(arr, arr);
+  ASSERT_TRUE(dq.size() == 100);
+
+  dq.pop_front_n(37);
+  ASSERT_TRUE(dq.size() == 63);
+  ASSERT_TRUE(dq.front() == 37);
+  dq.pop_back_n(40);
+  ASSERT_TRUE(dq.size() == 23);
+  ASSERT_TRUE(dq.back() == 59);
+  dq.pop_back_n(0);
+  ASSERT_TRUE(dq.size() == 23);
+
+  dq.pop_front_n(dq.size());
+  ASSERT_TRUE(dq.empty());
+  dq.push_back(1);
+  dq.push_front(0);
+  ASSERT_TRUE(dq.size() == 2);
+  ASSERT_TRUE(dq[0] == 0 && dq[1] == 1);
+
+  deque<string, simpleAlloc<string>, 4> ds;
+  string strs[] = {"a", "b", "c", "d", "e", "f", "g"};
+  ds.append(strs, strs + 7);
+  ds.prepend(strs + 3, strs + 7);
+  ASSERT_TRUE(ds.size() == 11);
+  ASSERT_TRUE(ds[0] == "d" && ds[3] == "g" && ds[4] == "a" && ds[10] == "g");
+  ds.pop_front_n(5);
+  ds.pop_back_n(5);
+  ASSERT_TRUE(ds.size() == 1);
+  ASSERT_TRUE(ds.front() == "b");
+}
+
+namespace {
+// 记录拷贝与移动次数
+struct Payload {
+  static int copies;
+  static int moves;
+  string data;
+  int id;
+  Payload(string s, int i) : data(TinySTL::move(s)), id(i) {}
+  Payload(const Payload &rhs) : data(rhs.data), id(rhs.id) { ++copies; }
+  Payload(Payload &&rhs) noexcept : data(TinySTL::move(rhs.data)), id(rhs.id) { ++moves; }
+  Payload &operator=(const Payload &rhs) {
+    data = rhs.data, id = rhs.id, ++copies;
+    return *this;
+  }
+  Payload &operator=(Payload &&rhs) noexcept {
+    data = TinySTL::move(rhs.data), id = rhs.id, ++moves;
+    return *this;
+  }
+};
+int Payload::copies = 0;
+int Payload::moves = 0;
+}// namespace
+
+TEST_F(DequeTest, EMPLACE_AND_MOVE) {
+  Payload::copies = Payload::moves = 0;
+  deque<Payload, simpleAlloc<Payload>, 4> dq;
+  for (int i = 10; i < 20; ++i) dq.emplace_back(std::to_string(i), i);
+  for (int i = 9; i >= 0; --i) dq.emplace_front(std::to_string(i), i);
+  ASSERT_TRUE(dq.size() == 20);
+  ASSERT_TRUE(Payload::copies == 0);
+  ASSERT_TRUE(Payload::moves == 0);
+
+  Payload p("20", 20);
+  dq.push_back(TinySTL::move(p));
+  ASSERT_TRUE(p.data.empty());
+  dq.push_front(Payload("-1", -1));
+  ASSERT_TRUE(Payload::moves == 2);
+
+  // 中间插入只移动不拷贝
+  auto it = dq.emplace(dq.begin() + 5, "x", 100);
+  ASSERT_TRUE(it->id == 100);
+  ASSERT_TRUE(dq[4].id == 3 && dq[6].id == 4);
+  it = dq.insert(dq.end() - 3, Payload("y", 200));
+  ASSERT_TRUE(it->id == 200);
+  ASSERT_TRUE(dq[dq.size() - 5].id == 17 && dq[dq.size() - 3].id == 18);
+  dq.erase(dq.begin() + 5);
+  dq.erase(dq.end() - 4);
+  dq.erase(dq.begin() + 2, dq.begin() + 4);
+  ASSERT_TRUE(Payload::copies == 0);
+
+  ASSERT_TRUE(dq.size() == 20);
+  ASSERT_TRUE(dq[1].id == 0 && dq[2].id == 3);
+  ASSERT_TRUE(dq.back().data == "20");
+
+  // 参数引用容器内元素
+  dq.push_back(dq.front());
+  ASSERT_TRUE(dq.back().id == -1);
+  ASSERT_TRUE(Payload::copies == 1);
+
+  // erase 单个元素时保持其余元素次序
+  deque<int> di{1, 2, 3, 4, 5, 6, 7};
+  di.erase(di.begin() + 2);
+  ASSERT_TRUE(di == deque<int>({1, 2, 4, 5, 6, 7}));
+}
+
+TEST_F(DequeTest, SHRINK_TO_FIT) {
+  // 峰值之后排空，元素次序不受影响
+  deque<int, simpleAlloc<int>, 16> dq;
+  for (int i = 0; i < 200000; ++i) dq.push_back(i);
+  while (dq.size() > 100) dq.pop_front();
+  ASSERT_TRUE(dq.front() == 199900 && dq.back() == 199999);
+
+  // 长期运行的队列：两端交替进出
+  for (int i = 0; i < 100000; ++i) {
+    dq.push_back(i);
+    dq.pop_front();
+  }
+  ASSERT_TRUE(dq.size() == 100);
+  for (int i = 0; i < 100; ++i) ASSERT_TRUE(dq[i] == 99900 + i);
+
+  dq.pop_back_n(50);
+  dq.pop_front_n(25);
+  dq.shrink_to_fit();
+  ASSERT_TRUE(dq.size() == 25);
+  for (int i = 0; i < 25; ++i) ASSERT_TRUE(dq[i] == 99925 + i);
+
+  // 收缩后两端依然可以继续扩展
+  for (int i = 0; i < 1000; ++i) dq.push_front(-i);
+  for (int i = 0; i < 1000; ++i) dq.push_back(i);
+  ASSERT_TRUE(dq.size() == 2025);
+  ASSERT_TRUE(dq.front() == -999 && dq.back() == 999);
+
+  dq.erase(dq.begin() + 10, dq.end() - 10);
+  ASSERT_TRUE(dq.size() == 20);
+  ASSERT_TRUE(dq[9] == -990 && dq[10] == 990);
+
+  dq.clear();
+  dq.shrink_to_fit();
+  ASSERT_TRUE(dq.empty());
+  dq.push_back(1);
+  dq.push_front(0);
+  ASSERT_TRUE(dq == (deque<int, simpleAlloc<int>, 16>{0, 1}));
+}
+
+TEST_F(DequeTest, POP_KEEPS_ITERATORS) {
+  // 两端弹出释放大量缓冲区后，指向其余元素的迭代器依然有效
+  deque<int, simpleAlloc<int>, 16> dq;
+  for (int i = 0; i < 100000; ++i) dq.push_back(i);
+  auto it = dq.begin() + 50000;
+  auto last = dq.end() - 1;
+  while (dq.front() != 49990) dq.pop_front();
+  ASSERT_TRUE(*it == 50000 && *last == 99999);
+  while (dq.back() != 50010) dq.pop_back();
+  ASSERT_TRUE(*it == 50000);
+
+  dq.pop_front_n(5);
+  dq.pop_back_n(5);
+  dq.erase(dq.begin(), dq.begin() + 2);
+  ASSERT_TRUE(*it == 50000);
+  int expect = 49997;
+  for (auto cur = dq.begin(); cur != dq.end(); ++cur) ASSERT_TRUE(*cur == expect++);
+  ASSERT_TRUE(*++it == 50001);
+}
+
+TEST_F(DequeTest, MAP_TRACKS_WORKING_SET) {
+  // 峰值之后以 pop 排空，再继续入队：map 在下次扩展时随工作集收缩
+  deque<int, simpleAlloc<int>, 16> dq;
+  for (int i = 0; i < 200000; ++i) dq.push_back(i);
+  const size_t peak = dq.map_capacity();
+  ASSERT_TRUE(peak >= 200000 / 16);
+  while (dq.size() > 100) dq.pop_front();
+  for (int i = 0; i < 100000; ++i) {
+    dq.push_back(i);
+    dq.pop_front();
+  }
+  ASSERT_TRUE(dq.map_capacity() <= 64);
+  for (int i = 0; i < 100; ++i) ASSERT_TRUE(dq[i] == 99900 + i);
+
+  // 自尾部排空后向头部扩展
+  for (int i = 0; i < 200000; ++i) dq.push_back(i);
+  while (dq.size() > 100) dq.pop_back();
+  for (int i = 0; i < 300000; ++i) {
+    dq.push_front(i);
+    dq.pop_back();
+  }
+  ASSERT_TRUE(dq.map_capacity() <= 64);
+  for (int i = 0; i < 100; ++i) ASSERT_TRUE(dq[i] == 299999 - i);
+
+  // 工作集再次增长时 map 照常扩容
+  for (int i = 0; i < 200000; ++i) dq.push_back(i);
+  ASSERT_TRUE(dq.map_capacity() >= 200100 / 16);
+  ASSERT_TRUE(dq.size() == 200100 && dq.back() == 199999);
+}
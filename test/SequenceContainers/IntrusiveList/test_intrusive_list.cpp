@@ -0,0 +1,161 @@
+#include "SequenceContainers/IntrusiveList/stl_intrusive_list.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace ::TinySTL;
+
+namespace {
+
+struct item {
+  int value;
+  intrusive_list_hook all;
+  intrusive_list_hook odd;
+  intrusive_slist_hook free;
+
+  explicit item(int v = 0) : value(v) {}
+};
+
+template<class Container>
+std::vector<int> values(const Container &c) {
+  std::vector<int> result;
+  for (auto &x : c) result.push_back(x.value);
+  return result;
+}
+
+}// namespace
+
+class IntrusiveListTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 8; ++i) items[i].value = i;
+  }
+  item items[8];
+};
+
+TEST_F(IntrusiveListTest, insert_and_erase) {
+  intrusive_list<item, &item::all> l;
+  ASSERT_TRUE(l.empty());
+  for (int i = 0; i < 4; ++i) l.push_back(items[i]);
+  l.push_front(items[4]);
+  ASSERT_TRUE(l.size() == 5);
+  ASSERT_TRUE((values(l) == std::vector<int>{4, 0, 1, 2, 3}));
+  ASSERT_TRUE(&l.front() == &items[4] && &l.back() == &items[3]);
+  ASSERT_TRUE(items[0].all.is_linked());
+
+  // iterator_to 为 O(1)，元素地址保持不变
+  auto it = l.insert(l.iterator_to(items[2]), items[5]);
+  ASSERT_TRUE(&*it == &items[5]);
+  ASSERT_TRUE((values(l) == std::vector<int>{4, 0, 1, 5, 2, 3}));
+
+  l.remove(items[1]);
+  ASSERT_FALSE(items[1].all.is_linked());
+  it = l.erase(l.iterator_to(items[5]));
+  ASSERT_TRUE(it->value == 2);
+  l.pop_front();
+  l.pop_back();
+  ASSERT_TRUE((values(l) == std::vector<int>{0, 2}));
+  ASSERT_TRUE(l.size() == 2);
+
+  auto rit = l.end();
+  --rit;
+  ASSERT_TRUE(rit->value == 2);
+
+  l.remove_if([](const item &x) { return x.value == 0; });
+  ASSERT_TRUE((values(l) == std::vector<int>{2}));
+
+  // 被移除的元素可再次链入
+  l.push_back(items[1]);
+  l.clear();
+  ASSERT_TRUE(l.empty() && l.size() == 0);
+  for (auto &x : items) ASSERT_FALSE(x.all.is_linked());
+}
+
+TEST_F(IntrusiveListTest, multiple_containers) {
+  intrusive_list<item, &item::all> all;
+  intrusive_list<item, &item::odd> odd;
+  intrusive_slist<item, &item::free> free;
+  for (auto &x : items) {
+    all.push_back(x);
+    if (x.value % 2) odd.push_front(x);
+    else
+      free.push_front(x);
+  }
+  ASSERT_TRUE(all.size() == 8 && odd.size() == 4 && free.size() == 4);
+  ASSERT_TRUE((values(odd) == std::vector<int>{7, 5, 3, 1}));
+  ASSERT_TRUE((values(free) == std::vector<int>{6, 4, 2, 0}));
+
+  // 从一个容器中移除不影响其他容器
+  odd.remove(items[3]);
+  ASSERT_TRUE(items[3].all.is_linked());
+  ASSERT_TRUE(all.size() == 8);
+  ASSERT_TRUE((values(odd) == std::vector<int>{7, 5, 1}));
+
+  // 复制对象不复制钩子
+  item copy(items[0]);
+  ASSERT_FALSE(copy.all.is_linked());
+  all.push_back(copy);
+  ASSERT_TRUE(all.back().value == 0);
+  all.pop_back();
+}
+
+TEST_F(IntrusiveListTest, splice_and_move) {
+  intrusive_list<item, &item::all> a, b;
+  for (int i = 0; i < 4; ++i) a.push_back(items[i]);
+  for (int i = 4; i < 8; ++i) b.push_back(items[i]);
+
+  a.splice(a.iterator_to(items[2]), b, b.iterator_to(items[5]));
+  ASSERT_TRUE((values(a) == std::vector<int>{0, 1, 5, 2, 3}));
+  ASSERT_TRUE(a.size() == 5 && b.size() == 3);
+
+  auto first = b.begin();
+  auto last = b.end();
+  --last;
+  a.splice(a.begin(), b, first, last);
+  ASSERT_TRUE((values(a) == std::vector<int>{4, 6, 0, 1, 5, 2, 3}));
+  ASSERT_TRUE(a.size() == 7 && b.size() == 1);
+
+  a.splice(a.end(), b);
+  ASSERT_TRUE(b.empty() && a.size() == 8);
+  ASSERT_TRUE(a.back().value == 7);
+
+  intrusive_list<item, &item::all> c(TinySTL::move(a));
+  ASSERT_TRUE(a.empty() && c.size() == 8);
+  ASSERT_TRUE(c.front().value == 4);
+  swap(b, c);
+  ASSERT_TRUE(c.empty() && b.size() == 8);
+  ASSERT_TRUE((values(b) == std::vector<int>{4, 6, 0, 1, 5, 2, 3, 7}));
+}
+
+TEST_F(IntrusiveListTest, slist_operations) {
+  intrusive_slist<item, &item::free> s;
+  for (int i = 0; i < 4; ++i) s.push_front(items[i]);
+  ASSERT_TRUE((values(s) == std::vector<int>{3, 2, 1, 0}));
+
+  auto it = s.insert_after(s.iterator_to(items[2]), items[6]);
+  ASSERT_TRUE(it->value == 6);
+  ASSERT_TRUE((values(s) == std::vector<int>{3, 2, 6, 1, 0}));
+
+  s.erase_after(s.iterator_to(items[6]));
+  ASSERT_FALSE(items[1].free.is_linked());
+  s.remove(items[3]);
+  ASSERT_TRUE((values(s) == std::vector<int>{2, 6, 0}));
+  ASSERT_TRUE(s.size() == 3 && s.front().value == 2);
+
+  intrusive_slist<item, &item::free> t;
+  t.push_front(items[7]);
+  t.push_front(items[5]);
+  s.splice_after(s.before_begin(), t, t.before_begin());
+  ASSERT_TRUE((values(s) == std::vector<int>{5, 2, 6, 0}));
+  s.splice_after(s.previous(s.end()), t);
+  ASSERT_TRUE((values(s) == std::vector<int>{5, 2, 6, 0, 7}));
+  ASSERT_TRUE(t.empty() && s.size() == 5);
+
+  s.remove_if([](const item &x) { return x.value % 2 == 0; });
+  ASSERT_TRUE((values(s) == std::vector<int>{5, 7}));
+
+  intrusive_slist<item, &item::free> u(TinySTL::move(s));
+  ASSERT_TRUE(s.empty() && (values(u) == std::vector<int>{5, 7}));
+  u.erase_after(u.before_begin(), u.end());
+  ASSERT_TRUE(u.empty());
+  for (auto &x : items) ASSERT_FALSE(x.free.is_linked());
+}
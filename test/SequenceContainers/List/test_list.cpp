@@ -1,5 +1,8 @@
 #include "SequenceContainers/List/stl_list.h"
 #include <gtest/gtest.h>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
 
 using namespace ::TinySTL;
 
@@ -194,4 +197,178 @@ size_t distance(It, It);
 TEST_F(ListTest, adl) {
   list<foo::bar> lbar;
   ASSERT_TRUE(lbar.empty());
-}
\ No newline at end of file
+}
+namespace {
+// 记录拷贝与移动次数
+struct Payload {
+  static int copies;
+  static int moves;
+  std::string data;
+  int id;
+  Payload(std::string s, int i) : data(TinySTL::move(s)), id(i) {}
+  Payload(const Payload &rhs) : data(rhs.data), id(rhs.id) { ++copies; }
+  Payload(Payload &&rhs) noexcept : data(TinySTL::move(rhs.data)), id(rhs.id) { ++moves; }
+  Payload &operator=(const Payload &) = default;
+  Payload &operator=(Payload &&) = default;
+};
+int Payload::copies = 0;
+int Payload::moves = 0;
+}// namespace
+
+TEST_F(ListTest, emplace_and_move) {
+  Payload::copies = Payload::moves = 0;
+  list<Payload> l;
+  l.emplace_back("b", 2);
+  l.emplace_front("a", 1);
+  auto it = l.emplace(l.end(), "d", 4);
+  l.emplace(it, "c", 3);
+  ASSERT_TRUE(Payload::copies == 0);
+  ASSERT_TRUE(Payload::moves == 0);
+
+  Payload p("e", 5);
+  l.push_back(TinySTL::move(p));
+  l.insert(l.begin(), Payload("z", 0));
+  ASSERT_TRUE(Payload::copies == 0);
+  ASSERT_TRUE(Payload::moves == 2);
+  ASSERT_TRUE(p.data.empty());
+
+  int expected = 0;
+  for (auto &x : l) ASSERT_TRUE(x.id == expected++);
+  ASSERT_TRUE(l.back().data == "e");
+
+  l.push_front(l.back());
+  ASSERT_TRUE(Payload::copies == 1);
+  ASSERT_TRUE(l.front().data == "e");
+
+  list<Payload> l2;
+  l2 = TinySTL::move(l);
+  ASSERT_TRUE(l.empty());
+  ASSERT_TRUE(l2.size() == 7);
+}
+
+TEST_F(ListTest, constant_size) {
+  list<int> l1{5, 3, 1};
+  ASSERT_TRUE(l1.size() == 3);
+  l1.push_back(7);
+  l1.emplace_front(0);
+  l1.insert(l1.begin(), 3, -1);// fill_insert
+  ASSERT_TRUE(l1.size() == 8);
+  l1.pop_front();
+  l1.erase(l1.begin(), ++++l1.begin());
+  ASSERT_TRUE(l1.size() == 5);
+
+  // 整体 splice
+  list<int> l2{2, 4};
+  l1.splice(l1.end(), l2);
+  ASSERT_TRUE(l1.size() == 7 && l2.size() == 0 && l2.empty());
+
+  // 单个节点跨 list
+  l2.splice(l2.begin(), l1, l1.begin());
+  ASSERT_TRUE(l1.size() == 6 && l2.size() == 1);
+
+  // 区间跨 list：需要数出区间长度
+  list<int>::iterator first = l1.begin();
+  list<int>::iterator last = first;
+  ++++++last;
+  l2.splice(l2.end(), l1, first, last);
+  ASSERT_TRUE(l1.size() == 3 && l2.size() == 4);
+
+  // 同一 list 内部移动，长度不变
+  l1.splice(l1.begin(), l1, ++l1.begin(), l1.end());
+  l1.splice(l1.end(), l1, l1.begin());
+  ASSERT_TRUE(l1.size() == 3);
+
+  l1.sort();
+  l2.sort();
+  l1.merge(l2);
+  ASSERT_TRUE(l1.size() == 7 && l2.size() == 0);
+  ASSERT_TRUE(static_cast<size_t>(TinySTL::distance(l1.begin(), l1.end())) == l1.size());
+
+  l1.push_back(7);
+  l1.unique();
+  l1.remove(4);
+  l1.reverse();
+  ASSERT_TRUE(static_cast<size_t>(TinySTL::distance(l1.begin(), l1.end())) == l1.size());
+
+  l1.resize(10);
+  ASSERT_TRUE(l1.size() == 10);
+  l1.resize(2);
+  ASSERT_TRUE(l1.size() == 2);
+
+  list<int> l3(TinySTL::move(l1));
+  ASSERT_TRUE(l3.size() == 2 && l1.size() == 0);
+  l1 = l3;
+  l3.swap(l2);
+  ASSERT_TRUE(l1.size() == 2 && l2.size() == 2 && l3.size() == 0);
+  l1.clear();
+  ASSERT_TRUE(l1.size() == 0 && l1.empty());
+}
+
+static bool same_elements(const list<int> &l, std::initializer_list<int> il) {
+  return l.size() == il.size() && TinySTL::equal(l.begin(), l.end(), il.begin());
+}
+
+struct SortRecord {
+  int key;
+  int seq;
+};
+
+TEST_F(ListTest, sort_and_sort_gathered) {
+  // 稳定性：key 相同的元素保持插入次序
+  auto by_key = [](const SortRecord &a, const SortRecord &b) { return a.key < b.key; };
+  list<SortRecord> l1;
+  list<SortRecord> l2;
+  unsigned seed = 12345;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    SortRecord r{static_cast<int>((seed >> 16) % 100), i};
+    l1.push_back(r);
+    l2.push_back(r);
+  }
+  l1.sort(by_key);
+  l2.sort_gathered(by_key);
+  ASSERT_TRUE(l1.size() == 5000 && l2.size() == 5000);
+  auto it1 = l1.begin();
+  auto it2 = l2.begin();
+  for (auto prev = it1++; it1 != l1.end(); prev = it1++) {
+    ASSERT_TRUE(prev->key < it1->key || (prev->key == it1->key && prev->seq < it1->seq));
+  }
+  for (it1 = l1.begin(); it1 != l1.end(); ++it1, ++it2) {
+    ASSERT_TRUE(it1->key == it2->key && it1->seq == it2->seq);
+  }
+  // prev 链接同样正确
+  int count = 0;
+  for (auto rit = l1.end(); rit != l1.begin(); --rit) ++count;
+  ASSERT_TRUE(count == 5000 && l1.back().key == 99);
+
+  list<int> l3{3, 1, 4, 1, 5, 9, 2, 6};
+  l3.sort(TinySTL::greater<int>());
+  ASSERT_TRUE(same_elements(l3, {9, 6, 5, 4, 3, 2, 1, 1}));
+  l3.sort_gathered();
+  ASSERT_TRUE(same_elements(l3, {1, 1, 2, 3, 4, 5, 6, 9}));
+  list<int> l4{8, 7, 0};
+  l4.sort(TinySTL::greater<int>());
+  l3.merge(l4, TinySTL::greater<int>());// l3 并非降序，仅检查节点个数
+  ASSERT_TRUE(l3.size() == 11 && l4.empty());
+
+  // 比较函数抛出异常后所有节点依然在 list 中
+  list<int> l5;
+  for (int i = 0; i < 100; ++i) l5.push_back((i * 37) % 100);
+  int calls = 0;
+  auto throwing = [&calls](int a, int b) {
+    if (++calls == 200) throw std::runtime_error("compare failed");
+    return a < b;
+  };
+  ASSERT_THROW(l5.sort(throwing), std::runtime_error);
+  ASSERT_TRUE(l5.size() == 100);
+  long long sum = 0;
+  count = 0;
+  for (int x : l5) sum += x, ++count;
+  ASSERT_TRUE(count == 100 && sum == 99 * 100 / 2);
+  calls = 0;
+  list<int> before = l5;
+  ASSERT_THROW(l5.sort_gathered(throwing), std::runtime_error);
+  ASSERT_TRUE(TinySTL::equal(l5.begin(), l5.end(), before.begin()));
+  l5.sort();
+  ASSERT_TRUE(l5.front() == 0 && l5.back() == 99);
+}
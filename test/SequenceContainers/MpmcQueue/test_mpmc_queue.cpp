@@ -0,0 +1,173 @@
+#include "SequenceContainers/MpmcQueue/stl_mpmc_queue.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::TinySTL;
+
+class MpmcQueueTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(MpmcQueueTest, try_operations) {
+  mpmc_queue<std::string> q(3);
+  ASSERT_TRUE(q.capacity() == 4);
+  ASSERT_TRUE(q.empty());
+
+  ASSERT_TRUE(q.try_push("a"));
+  std::string b = "b";
+  ASSERT_TRUE(q.try_push(TinySTL::move(b)));
+  ASSERT_TRUE(q.try_emplace(2, 'c'));
+  ASSERT_TRUE(q.try_push("d"));
+  ASSERT_FALSE(q.try_push("e"));
+  ASSERT_TRUE(q.size() == 4);
+
+  std::string out;
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_TRUE(out == "a");
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_TRUE(out == "b");
+
+  std::string in[] = {"e", "f", "g"};
+  ASSERT_TRUE(q.try_push_n(in, 3) == 2);
+
+  std::string buf[8];
+  ASSERT_TRUE(q.try_pop_n(buf, 8) == 4);
+  ASSERT_TRUE(buf[0] == "cc" && buf[1] == "d" && buf[2] == "e" && buf[3] == "f");
+  ASSERT_FALSE(q.try_pop(out));
+  ASSERT_TRUE(q.try_pop_n(buf, 8) == 0);
+
+  q.push("left in queue");// 析构时销毁剩余元素
+}
+
+TEST_F(MpmcQueueTest, many_producers_many_consumers) {
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int per_producer = 50000;
+  mpmc_queue<int> q(256);
+  std::atomic<long long> sum(0);
+  std::atomic<int> received(0);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&q, p] {
+      int base = p * per_producer;
+      for (int i = 0; i < per_producer;) {
+        // 混用三类入队接口
+        if (i % 3 == 0) {
+          q.push(base + i);
+          ++i;
+        } else if (i % 3 == 1) {
+          q.spin_push(base + i);
+          ++i;
+        } else {
+          int batch[2] = {base + i, base + i + 1};
+          int n = i + 1 < per_producer ? 2 : 1;
+          i += static_cast<int>(q.try_push_n(batch, n));
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      int buf[16];
+      for (;;) {
+        if (received.load() >= producers * per_producer) break;
+        size_t n = q.try_pop_n(buf, 16);
+        if (n == 0) {
+          int v;
+          if (!q.try_pop(v)) {
+            std::this_thread::yield();
+            continue;
+          }
+          buf[0] = v;
+          n = 1;
+        }
+        long long local = 0;
+        for (size_t i = 0; i < n; ++i) local += buf[i];
+        sum += local;
+        received += static_cast<int>(n);
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+
+  long long total = static_cast<long long>(producers) * per_producer;
+  ASSERT_TRUE(received.load() == total);
+  ASSERT_TRUE(sum.load() == total * (total - 1) / 2);
+  ASSERT_TRUE(q.empty());
+}
+
+TEST_F(MpmcQueueTest, blocking_pop_wakes_up) {
+  mpmc_queue<int> q(2);
+  std::vector<int> got;
+  std::thread consumer([&] {
+    for (int i = 0; i < 1000; ++i) {
+      int v;
+      q.pop(v);
+      got.push_back(v);
+    }
+  });
+  // 队列很小，生产者频繁阻塞于队满
+  for (int i = 0; i < 1000; ++i) q.push(i);
+  consumer.join();
+  ASSERT_TRUE(got.size() == 1000);
+  for (int i = 0; i < 1000; ++i) ASSERT_TRUE(got[i] == i);
+}
+
+// 以负数构造或复制 13 时抛出异常，移动不抛出异常
+struct mpmc_throwing_value {
+  static std::atomic<int> live;
+  int v;
+  mpmc_throwing_value(int x) : v(x) {
+    if (x < 0) throw std::runtime_error("mpmc_throwing_value");
+    ++live;
+  }
+  mpmc_throwing_value(const mpmc_throwing_value &rhs) : v(rhs.v) {
+    if (v == 13) throw std::runtime_error("mpmc_throwing_value");
+    ++live;
+  }
+  mpmc_throwing_value(mpmc_throwing_value &&rhs) noexcept : v(rhs.v) { ++live; }
+  mpmc_throwing_value &operator=(const mpmc_throwing_value &) = default;
+  mpmc_throwing_value &operator=(mpmc_throwing_value &&) noexcept = default;
+  ~mpmc_throwing_value() { --live; }
+};
+std::atomic<int> mpmc_throwing_value::live{0};
+
+TEST_F(MpmcQueueTest, throwing_ctor) {
+  {
+    mpmc_queue<mpmc_throwing_value> q(4);
+    // 构造失败时不认领槽位
+    ASSERT_THROW(q.try_emplace(-1), std::runtime_error);
+    ASSERT_THROW(q.spin_emplace(-1), std::runtime_error);
+    ASSERT_THROW(q.emplace(-1), std::runtime_error);
+    ASSERT_TRUE(q.empty());
+    q.push(mpmc_throwing_value(0));
+    ASSERT_TRUE(q.try_emplace(1));
+
+    // 批量入队在复制 13 时失败，之前的元素已经入队
+    mpmc_throwing_value batch[] = {2, 13, 3};
+    ASSERT_THROW(q.try_push_n(batch, 3), std::runtime_error);
+    ASSERT_TRUE(q.size() == 3);
+    mpmc_throwing_value out(0);
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_TRUE(q.try_pop(out));
+      ASSERT_TRUE(out.v == i);
+    }
+    ASSERT_FALSE(q.try_pop(out));
+
+    // 所有认领过的槽位均已发布，出队者不会卡在其上
+    for (int round = 0; round < 3; ++round) {
+      std::thread consumer([&] { q.pop(out); });
+      q.push(mpmc_throwing_value(round + 10));
+      consumer.join();
+      ASSERT_TRUE(out.v == round + 10);
+    }
+    q.spin_push(batch[2]);
+  }
+  ASSERT_TRUE(mpmc_throwing_value::live == 0);
+}
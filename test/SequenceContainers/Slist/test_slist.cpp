@@ -0,0 +1,190 @@
+#include "SequenceContainers/List/stl_list.h"
+#include "SequenceContainers/Slist/stl_slist.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ::TinySTL;
+
+namespace {
+
+template<class Container>
+std::vector<int> values(const Container &c) {
+  std::vector<int> result;
+  for (auto &x : c) result.push_back(x);
+  return result;
+}
+
+}// namespace
+
+class SlistTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(SlistTest, insert_and_erase_after) {
+  slist<int> s;
+  ASSERT_TRUE(s.empty() && s.size() == 0);
+  s.push_front(3);
+  s.push_front(1);
+  auto it = s.insert_after(s.begin(), 2);
+  ASSERT_TRUE(*it == 2);
+  ASSERT_TRUE((values(s) == std::vector<int>{1, 2, 3}));
+
+  int arr[] = {7, 8, 9};
+  it = s.insert_after(s.before_begin(), arr, arr + 3);
+  ASSERT_TRUE(*it == 9);
+  it = s.insert_after(s.previous(s.end()), 2, 4);
+  ASSERT_TRUE(*it == 4);
+  ASSERT_TRUE((values(s) == std::vector<int>{7, 8, 9, 1, 2, 3, 4, 4}));
+  ASSERT_TRUE(s.size() == 8 && s.front() == 7);
+
+  it = s.erase_after(s.before_begin());
+  ASSERT_TRUE(*it == 8);
+  auto first = s.begin();
+  auto last = first;
+  for (int i = 0; i < 4; ++i) ++last;
+  s.erase_after(first, last);
+  ASSERT_TRUE((values(s) == std::vector<int>{8, 3, 4, 4}));
+  s.pop_front();
+  s.unique();
+  ASSERT_TRUE((values(s) == std::vector<int>{3, 4}));
+  s.emplace_front(5);
+  s.remove(4);
+  ASSERT_TRUE((values(s) == std::vector<int>{5, 3}));
+
+  s.resize(4, 1);
+  ASSERT_TRUE((values(s) == std::vector<int>{5, 3, 1, 1}));
+  s.resize(1);
+  ASSERT_TRUE((values(s) == std::vector<int>{5}) && s.size() == 1);
+
+  slist<std::string> strs(3, "ab");
+  strs.emplace_after(strs.begin(), 2, 'c');
+  ASSERT_TRUE(*++strs.begin() == "cc");
+  ASSERT_TRUE(strs.size() == 4);
+
+  slist<int> copy{1, 2, 3};
+  slist<int> other(copy);
+  ASSERT_TRUE(other == copy);
+  other.push_front(0);
+  ASSERT_TRUE(other != copy);
+  copy = other;
+  ASSERT_TRUE(copy == other);
+  slist<int> moved(TinySTL::move(other));
+  ASSERT_TRUE(other.empty() && moved.size() == 4);
+}
+
+TEST_F(SlistTest, cached_tail) {
+  // 不缓存末节点时不额外占用空间
+  ASSERT_TRUE(sizeof(slist<int>) == 2 * sizeof(void *));
+  ASSERT_TRUE(sizeof(_slist_node<int *>) + sizeof(void *) == sizeof(_list_node<int *>));
+
+  slist<int, true> q;
+  for (int i = 0; i < 5; ++i) q.push_back(i);
+  ASSERT_TRUE(q.back() == 4);
+  ASSERT_TRUE((values(q) == std::vector<int>{0, 1, 2, 3, 4}));
+
+  // 以 FIFO 方式使用：尾进头出，末节点随之维护
+  q.pop_front();
+  q.push_back(5);
+  ASSERT_TRUE(q.front() == 1 && q.back() == 5);
+  q.erase_after(q.previous(q.previous(q.end())));
+  ASSERT_TRUE(q.back() == 4);
+  q.erase_after(q.begin(), q.end());
+  ASSERT_TRUE(q.back() == 1 && q.size() == 1);
+  q.pop_front();
+  ASSERT_TRUE(q.empty());
+  q.push_back(9);
+  ASSERT_TRUE(q.front() == 9 && q.back() == 9);
+
+  slist<int, true> r{1, 2, 3};
+  r.swap(q);
+  ASSERT_TRUE(r.back() == 9 && q.back() == 3);
+  q.push_back(4);
+  r.push_back(10);
+  ASSERT_TRUE((values(q) == std::vector<int>{1, 2, 3, 4}));
+  ASSERT_TRUE((values(r) == std::vector<int>{9, 10}));
+
+  slist<int, true> empty;
+  q.swap(empty);
+  q.push_back(1);
+  ASSERT_TRUE(q.size() == 1 && empty.back() == 4);
+
+  q.reverse();
+  empty.reverse();
+  ASSERT_TRUE(empty.back() == 1 && empty.front() == 4);
+  empty.push_back(0);
+  ASSERT_TRUE((values(empty) == std::vector<int>{4, 3, 2, 1, 0}));
+  empty.sort();
+  empty.push_back(7);
+  ASSERT_TRUE((values(empty) == std::vector<int>{0, 1, 2, 3, 4, 7}));
+}
+
+TEST_F(SlistTest, splice_after) {
+  slist<int, true> a{1, 2, 3};
+  slist<int, true> b{4, 5, 6, 7};
+
+  // 单个元素：b 中 5 移到 a 的 1 之后
+  a.splice_after(a.begin(), b, b.begin());
+  ASSERT_TRUE((values(a) == std::vector<int>{1, 5, 2, 3}));
+  ASSERT_TRUE((values(b) == std::vector<int>{4, 6, 7}));
+
+  // 区间 (4, end)：移走 b 的末段，b 的末节点回到 4
+  a.splice_after(a.previous(a.end()), b, b.begin(), b.end());
+  ASSERT_TRUE((values(a) == std::vector<int>{1, 5, 2, 3, 6, 7}));
+  ASSERT_TRUE(a.back() == 7 && b.back() == 4);
+  ASSERT_TRUE(a.size() == 6 && b.size() == 1);
+
+  b.push_back(8);
+  a.splice_after(a.before_begin(), b);
+  ASSERT_TRUE((values(a) == std::vector<int>{4, 8, 1, 5, 2, 3, 6, 7}));
+  ASSERT_TRUE(b.empty() && a.size() == 8);
+  b.push_back(1);
+  ASSERT_TRUE(b.front() == 1 && b.back() == 1);
+
+  // 同一链表内移动
+  a.splice_after(a.previous(a.end()), a, a.before_begin());
+  ASSERT_TRUE(a.back() == 4);
+  ASSERT_TRUE((values(a) == std::vector<int>{8, 1, 5, 2, 3, 6, 7, 4}));
+
+  slist<int> c{1, 3, 5};
+  slist<int> d{2, 4, 6, 8};
+  c.merge(d);
+  ASSERT_TRUE(d.empty() && c.size() == 7);
+  ASSERT_TRUE((values(c) == std::vector<int>{1, 2, 3, 4, 5, 6, 8}));
+}
+
+TEST_F(SlistTest, sort) {
+  slist<int, true> s;
+  std::vector<int> expect;
+  unsigned seed = 7;
+  for (int i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int v = static_cast<int>(seed >> 16) % 100;
+    s.push_back(v);
+    expect.push_back(v);
+  }
+  s.sort();
+  std::sort(expect.begin(), expect.end());
+  ASSERT_TRUE(values(s) == expect);
+  ASSERT_TRUE(s.back() == expect.back() && s.size() == 1000);
+
+  s.sort(TinySTL::greater<int>());
+  ASSERT_TRUE(s.front() == expect.back() && s.back() == expect.front());
+
+  // 比较抛出异常时元素不丢失
+  int calls = 0;
+  auto throwing = [&calls](int x, int y) {
+    if (++calls == 500) throw std::runtime_error("compare");
+    return x < y;
+  };
+  ASSERT_THROW(s.sort(throwing), std::runtime_error);
+  ASSERT_TRUE(s.size() == 1000);
+  std::vector<int> after = values(s);
+  ASSERT_TRUE(after.size() == 1000);
+  std::sort(after.begin(), after.end());
+  ASSERT_TRUE(after == expect);
+  s.push_back(-1);
+  ASSERT_TRUE(s.back() == -1);
+}
@@ -0,0 +1,114 @@
+#include "SequenceContainers/SoaVector/stl_soa_vector.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace ::TinySTL;
+
+class SoaVectorTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(SoaVectorTest, push_back_and_columns) {
+  soa_vector<int, double, char> v;
+  ASSERT_TRUE(v.empty());
+  ASSERT_TRUE(v.size() == 0);
+
+  for (int i = 0; i < 100; ++i) v.push_back(i, i * 0.5, static_cast<char>('a' + i % 26));
+  ASSERT_TRUE(v.size() == 100);
+  ASSERT_TRUE(v.capacity() >= 100);
+
+  span<int> ids = v.column<0>();
+  span<double> weights = v.column<1>();
+  ASSERT_TRUE(ids.size() == 100);
+  ASSERT_TRUE(ids.data() == v.data<0>());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(ids[i] == i);
+    ASSERT_TRUE(weights[i] == i * 0.5);
+    ASSERT_TRUE(std::get<2>(v[i]) == 'a' + i % 26);
+  }
+
+  // 每一列的首地址都按 cache line 对齐
+  ASSERT_TRUE(reinterpret_cast<uintptr_t>(v.data<0>()) % 64 == 0);
+  ASSERT_TRUE(reinterpret_cast<uintptr_t>(v.data<1>()) % 64 == 0);
+  ASSERT_TRUE(reinterpret_cast<uintptr_t>(v.data<2>()) % 64 == 0);
+
+  double sum = 0;
+  for (double w : v.column<1>()) sum += w;
+  ASSERT_TRUE(sum == 99 * 100 / 2 * 0.5);
+}
+
+TEST_F(SoaVectorTest, row_iterator) {
+  soa_vector<int, int> v;
+  for (int i = 0; i < 10; ++i) v.push_back(i, 0);
+
+  for (auto it = v.begin(); it != v.end(); ++it) {
+    auto row = *it;
+    std::get<1>(row) = std::get<0>(row) * 2;
+  }
+  for (int i = 0; i < 10; ++i) ASSERT_TRUE(v.data<1>()[i] == i * 2);
+
+  ASSERT_TRUE(v.end() - v.begin() == 10);
+  ASSERT_TRUE(std::get<0>(*(v.begin() + 3)) == 3);
+  ASSERT_TRUE(std::get<0>(v.begin()[7]) == 7);
+  ASSERT_TRUE(std::get<0>(*v.rbegin()) == 9);
+  ASSERT_TRUE(std::get<1>(v.back()) == 18);
+
+  const soa_vector<int, int> &cv = v;
+  soa_vector<int, int>::const_iterator cit = v.begin();
+  ASSERT_TRUE(cit == cv.begin());
+  ASSERT_TRUE(std::get<1>(cv.front()) == 0);
+}
+
+TEST_F(SoaVectorTest, non_trivial_field) {
+  soa_vector<std::string, int> v;
+  for (int i = 0; i < 50; ++i) v.push_back(std::to_string(i), i);
+  // 引用容器内元素进行插入，扩容时不能失效
+  v.push_back(std::get<0>(v[0]), std::get<1>(v[0]));
+  ASSERT_TRUE(v.size() == 51);
+  ASSERT_TRUE(std::get<0>(v.back()) == "0");
+
+  soa_vector<std::string, int> copy(v);
+  ASSERT_TRUE(copy == v);
+  std::get<0>(copy[10]) = "ten";
+  ASSERT_TRUE(copy != v);
+  ASSERT_TRUE(std::get<0>(v[10]) == "10");
+
+  soa_vector<std::string, int> moved(TinySTL::move(copy));
+  ASSERT_TRUE(copy.empty());
+  ASSERT_TRUE(std::get<0>(moved[10]) == "ten");
+
+  v = moved;
+  ASSERT_TRUE(v == moved);
+}
+
+TEST_F(SoaVectorTest, pop_clear_resize) {
+  soa_vector<int, std::string> v;
+  v.resize(5, 7, "x");
+  ASSERT_TRUE(v.size() == 5);
+  ASSERT_TRUE(std::get<0>(v[4]) == 7);
+  ASSERT_TRUE(std::get<1>(v[4]) == "x");
+
+  v.pop_back();
+  ASSERT_TRUE(v.size() == 4);
+
+  v.resize(10);
+  ASSERT_TRUE(v.size() == 10);
+  ASSERT_TRUE(std::get<0>(v[9]) == 0);
+  ASSERT_TRUE(std::get<1>(v[9]).empty());
+
+  v.resize(2);
+  ASSERT_TRUE(v.size() == 2);
+  v.shrink_to_fit();
+  ASSERT_TRUE(v.capacity() == 2);
+  ASSERT_TRUE(std::get<1>(v[1]) == "x");
+
+  v.reserve(100);
+  ASSERT_TRUE(v.capacity() == 100);
+  ASSERT_TRUE(std::get<0>(v[0]) == 7);
+
+  v.clear();
+  ASSERT_TRUE(v.empty());
+  ASSERT_TRUE(v.capacity() == 100);
+}
@@ -0,0 +1,193 @@
+#include "SequenceContainers/SpscQueue/stl_spsc_queue.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::TinySTL;
+
+class SpscQueueTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+TEST_F(SpscQueueTest, bounded_basic) {
+  spsc_queue<int> q(5);
+  ASSERT_TRUE(q.capacity() == 8);
+  ASSERT_TRUE(q.empty());
+  ASSERT_TRUE(q.front() == nullptr);
+
+  for (int i = 0; i < 8; ++i) ASSERT_TRUE(q.try_push(i));
+  ASSERT_FALSE(q.try_push(8));
+  ASSERT_TRUE(q.size() == 8);
+  ASSERT_TRUE(*q.front() == 0);
+
+  int out = -1;
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_TRUE(out == 0);
+  ASSERT_TRUE(q.try_push(8));
+
+  int buf[16];
+  ASSERT_TRUE(q.try_pop_n(buf, 16) == 8);
+  for (int i = 0; i < 8; ++i) ASSERT_TRUE(buf[i] == i + 1);
+  ASSERT_FALSE(q.try_pop(out));
+
+  // 批量入队跨越环形缓冲区的尾部
+  int src[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ASSERT_TRUE(q.try_push_n(src, 10) == 8);
+  ASSERT_TRUE(q.try_pop_n(buf, 3) == 3);
+  ASSERT_TRUE(q.try_push_n(src + 8, 2) == 2);
+  ASSERT_TRUE(q.try_pop_n(buf, 16) == 7);
+  ASSERT_TRUE(buf[0] == 3 && buf[4] == 7 && buf[5] == 8 && buf[6] == 9);
+}
+
+TEST_F(SpscQueueTest, bounded_non_trivial) {
+  spsc_queue<std::string> q(4);
+  std::string s = "moved";
+  ASSERT_TRUE(q.try_push(TinySTL::move(s)));
+  ASSERT_TRUE(q.try_emplace(3, 'x'));
+  ASSERT_TRUE(q.try_push("left in queue"));
+  std::string out;
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_TRUE(out == "moved");
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_TRUE(out == "xxx");
+  // 析构时销毁剩余元素
+}
+
+TEST_F(SpscQueueTest, bounded_two_threads) {
+  constexpr int N = 200000;
+  spsc_queue<int> q(1024);
+  std::thread producer([&q] {
+    int batch[32];
+    int next = 0;
+    while (next < N) {
+      int n = 0;
+      for (; n < 32 && next + n < N; ++n) batch[n] = next + n;
+      next += static_cast<int>(q.try_push_n(batch, n));
+    }
+  });
+  long long sum = 0;
+  int expected = 0;
+  bool ordered = true;
+  int buf[64];
+  while (expected < N) {
+    size_t n = q.try_pop_n(buf, 64);
+    for (size_t i = 0; i < n; ++i, ++expected) {
+      ordered = ordered && buf[i] == expected;
+      sum += buf[i];
+    }
+  }
+  producer.join();
+  ASSERT_TRUE(ordered);
+  ASSERT_TRUE(sum == static_cast<long long>(N) * (N - 1) / 2);
+  ASSERT_TRUE(q.empty());
+}
+
+TEST_F(SpscQueueTest, unbounded_basic) {
+  unbounded_spsc_queue<std::string, 4> q;
+  for (int i = 0; i < 10; ++i) q.push(std::to_string(i));
+  ASSERT_TRUE(q.size() == 10);
+
+  std::string out;
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_TRUE(q.try_pop(out));
+    ASSERT_TRUE(out == std::to_string(i));
+  }
+  std::vector<std::string> more = {"a", "b", "c", "d", "e", "f", "g"};
+  q.push_n(more.begin(), more.size());
+  q.emplace(2, 'z');
+  ASSERT_TRUE(q.size() == 12);
+
+  std::string buf[20];
+  ASSERT_TRUE(q.try_pop_n(buf, 20) == 12);
+  ASSERT_TRUE(buf[0] == "6" && buf[4] == "a" && buf[10] == "g" && buf[11] == "zz");
+  ASSERT_FALSE(q.try_pop(out));
+  q.push("left in queue");
+}
+
+struct spsc_throwing_value {
+  static int live;
+  int v;
+  spsc_throwing_value(int x) : v(x) {
+    if (x < 0) throw std::runtime_error("spsc_throwing_value");
+    ++live;
+  }
+  spsc_throwing_value(const spsc_throwing_value &rhs) : spsc_throwing_value(rhs.v) {}
+  spsc_throwing_value &operator=(const spsc_throwing_value &) = default;
+  ~spsc_throwing_value() { --live; }
+};
+int spsc_throwing_value::live = 0;
+
+TEST_F(SpscQueueTest, unbounded_throwing_ctor) {
+  {
+    unbounded_spsc_queue<spsc_throwing_value, 4> q;
+    for (int i = 0; i < 4; ++i) q.emplace(i);
+    // 在缓冲区边界上构造失败：不发布元素，串接的节点留给下一次入队
+    ASSERT_THROW(q.emplace(-1), std::runtime_error);
+    ASSERT_THROW(q.emplace(-1), std::runtime_error);
+    ASSERT_TRUE(q.size() == 4);
+    for (int i = 4; i < 6; ++i) q.emplace(i);
+
+    // 批量入队中途失败，已构造的元素全部析构
+    std::vector<int> batch = {6, 7, 8, 9, 10, -1};
+    ASSERT_THROW(q.push_n(batch.begin(), batch.size()), std::runtime_error);
+    ASSERT_TRUE(q.size() == 6 && spsc_throwing_value::live == 6);
+    batch.back() = 11;
+    q.push_n(batch.begin(), batch.size());
+    ASSERT_TRUE(q.size() == 12);
+
+    spsc_throwing_value out(0);
+    for (int i = 0; i < 12; ++i) {
+      ASSERT_TRUE(q.try_pop(out));
+      ASSERT_TRUE(out.v == i);
+    }
+    ASSERT_FALSE(q.try_pop(out));
+    q.emplace(12);
+  }
+  ASSERT_TRUE(spsc_throwing_value::live == 0);
+}
+
+TEST_F(SpscQueueTest, bounded_throwing_ctor) {
+  {
+    spsc_queue<spsc_throwing_value> q(8);
+    q.try_emplace(0);
+    // 批量入队中途失败，已构造的元素全部析构，tail 不前进
+    std::vector<int> batch = {1, 2, 3, -1, 5};
+    ASSERT_THROW(q.try_push_n(batch.begin(), batch.size()), std::runtime_error);
+    ASSERT_TRUE(q.size() == 1 && spsc_throwing_value::live == 1);
+    batch[3] = 4;
+    ASSERT_TRUE(q.try_push_n(batch.begin(), batch.size()) == 5);
+
+    spsc_throwing_value out(0);
+    for (int i = 0; i < 6; ++i) {
+      ASSERT_TRUE(q.try_pop(out));
+      ASSERT_TRUE(out.v == i);
+    }
+    ASSERT_FALSE(q.try_pop(out));
+  }
+  ASSERT_TRUE(spsc_throwing_value::live == 0);
+}
+
+TEST_F(SpscQueueTest, unbounded_two_threads) {
+  constexpr int N = 200000;
+  unbounded_spsc_queue<int, 64> q;
+  std::thread producer([&q] {
+    for (int i = 0; i < N; i += 10) {
+      int batch[10];
+      for (int j = 0; j < 10; ++j) batch[j] = i + j;
+      q.push_n(batch, 10);
+    }
+  });
+  int expected = 0;
+  bool ordered = true;
+  int buf[100];
+  while (expected < N) {
+    size_t n = q.try_pop_n(buf, 100);
+    for (size_t i = 0; i < n; ++i, ++expected) ordered = ordered && buf[i] == expected;
+  }
+  producer.join();
+  ASSERT_TRUE(ordered);
+  ASSERT_TRUE(q.empty());
+}
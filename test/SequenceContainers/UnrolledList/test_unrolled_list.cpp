@@ -0,0 +1,173 @@
+#include "SequenceContainers/UnrolledList/stl_unrolled_list.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace ::TinySTL;
+
+class UnrolledListTest : public testing::Test {
+ protected:
+  void SetUp() override {}
+};
+
+template<class List>
+static bool same_as(const List &l, const std::vector<typename List::value_type> &v) {
+  if (l.size() != v.size()) return false;
+  size_t i = 0;
+  for (auto it = l.begin(); it != l.end(); ++it, ++i)
+    if (!(*it == v[i])) return false;
+  return i == v.size();
+}
+
+TEST_F(UnrolledListTest, push_insert_erase) {
+  unrolled_list<int, 4> ul;
+  ASSERT_TRUE(ul.empty() && ul.begin() == ul.end());
+  for (int i = 0; i < 10; ++i) ul.push_back(i);
+  for (int i = -1; i >= -5; --i) ul.push_front(i);
+  std::vector<int> v = {-5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ASSERT_TRUE(same_as(ul, v));
+  ASSERT_TRUE(ul.front() == -5 && ul.back() == 9);
+
+  // 随机位置插入与删除，触发节点的分裂与合并
+  unsigned seed = 1;
+  for (int round = 0; round < 2000; ++round) {
+    seed = seed * 1103515245u + 12345u;
+    size_t pos = v.empty() ? 0 : (seed >> 8) % (v.size() + 1);
+    auto it = ul.begin();
+    for (size_t k = 0; k < pos; ++k) ++it;
+    if ((seed >> 20) % 3 != 0 || v.empty() || pos == v.size()) {
+      auto res = ul.insert(it, round);
+      ASSERT_TRUE(*res == round);
+      v.insert(v.begin() + pos, round);
+    } else {
+      auto res = ul.erase(it);
+      v.erase(v.begin() + pos);
+      if (pos < v.size()) {
+        ASSERT_TRUE(*res == v[pos]);
+      } else {
+        ASSERT_TRUE(res == ul.end());
+      }
+    }
+  }
+  ASSERT_TRUE(same_as(ul, v));
+
+  // 反向遍历
+  size_t i = v.size();
+  for (auto it = ul.end(); it != ul.begin();) ASSERT_TRUE(*--it == v[--i]);
+
+  auto first = ul.begin();
+  for (int k = 0; k < 10; ++k) ++first;
+  auto last = first;
+  for (int k = 0; k < 100; ++k) ++last;
+  ul.erase(first, last);
+  v.erase(v.begin() + 10, v.begin() + 110);
+  ASSERT_TRUE(same_as(ul, v));
+
+  ul.pop_front();
+  ul.pop_back();
+  v.erase(v.begin());
+  v.pop_back();
+  ASSERT_TRUE(same_as(ul, v));
+  ul.clear();
+  ASSERT_TRUE(ul.empty() && ul.size() == 0);
+}
+
+TEST_F(UnrolledListTest, ordered_insert_and_copy) {
+  unrolled_list<std::string> ul;
+  ASSERT_TRUE((unrolled_list<std::string>::node_capacity >= 4));
+  std::vector<std::string> v;
+  unsigned seed = 7;
+  for (int i = 0; i < 500; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    std::string s = std::to_string(seed % 10000);
+    auto it = ul.begin();
+    while (it != ul.end() && *it < s) ++it;
+    ul.emplace(it, s);
+    v.insert(std::lower_bound(v.begin(), v.end(), s), s);
+  }
+  ASSERT_TRUE(same_as(ul, v));
+
+  unrolled_list<std::string> copy(ul);
+  ASSERT_TRUE(copy == ul);
+  unrolled_list<std::string> moved(TinySTL::move(copy));
+  ASSERT_TRUE(moved == ul && copy.empty());
+  moved.remove(v[0]);
+  ASSERT_TRUE(moved != ul);
+  moved = ul;
+  ASSERT_TRUE(moved == ul);
+
+  // 参数引用容器内的元素
+  unrolled_list<std::string, 4> small{"a", "b", "c", "d"};
+  small.insert(++small.begin(), small.back());
+  ASSERT_TRUE(same_as(small, {"a", "d", "b", "c", "d"}));
+}
+
+TEST_F(UnrolledListTest, splice_merge_remove) {
+  unrolled_list<int, 4> a{1, 2, 3, 4, 5, 6, 7};
+  unrolled_list<int, 4> b{10, 11, 12, 13, 14};
+
+  // 整体 splice 到中间
+  auto pos = a.begin();
+  ++pos, ++pos, ++pos;
+  a.splice(pos, b);
+  ASSERT_TRUE(same_as(a, {1, 2, 3, 10, 11, 12, 13, 14, 4, 5, 6, 7}));
+  ASSERT_TRUE(b.empty() && b.size() == 0);
+
+  // 区间 splice 到另一个 list
+  auto first = a.begin();
+  ++first, ++first, ++first;
+  auto last = first;
+  for (int k = 0; k < 5; ++k) ++last;
+  b.splice(b.end(), a, first, last);
+  ASSERT_TRUE(same_as(a, {1, 2, 3, 4, 5, 6, 7}));
+  ASSERT_TRUE(same_as(b, {10, 11, 12, 13, 14}));
+
+  // 单个元素，以及同一 list 内部的移动
+  b.splice(b.begin(), a, --a.end());
+  ASSERT_TRUE(same_as(b, {7, 10, 11, 12, 13, 14}) && a.size() == 6);
+  first = a.begin();
+  last = first;
+  ++last, ++last;
+  a.splice(a.end(), a, first, last);
+  ASSERT_TRUE(same_as(a, {3, 4, 5, 6, 1, 2}) && a.size() == 6);
+
+  // merge 要求两侧有序
+  unrolled_list<int, 4> c{1, 3, 5, 7, 9, 11};
+  unrolled_list<int, 4> d{2, 3, 4, 10, 20};
+  c.merge(d);
+  ASSERT_TRUE(same_as(c, {1, 2, 3, 3, 4, 5, 7, 9, 10, 11, 20}));
+  ASSERT_TRUE(d.empty());
+
+  unrolled_list<int, 4> e{9, 7, 5};
+  unrolled_list<int, 4> f{8, 6};
+  e.merge(f, TinySTL::greater<int>());
+  ASSERT_TRUE(same_as(e, {9, 8, 7, 6, 5}));
+
+  c.remove(3);
+  c.remove_if([](int x) { return x % 2 == 0; });
+  ASSERT_TRUE(same_as(c, {1, 5, 7, 9, 11}));
+  c.remove_if([](int) { return true; });
+  ASSERT_TRUE(c.empty() && c.begin() == c.end());
+}
+
+TEST_F(UnrolledListTest, splice_self_single) {
+  unrolled_list<int, 4> l{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  // 把元素链入它自身之前或之后都不改变 list
+  for (int k = 0; k < 10; ++k) {
+    auto it = l.begin();
+    for (int i = 0; i < k; ++i) ++it;
+    l.splice(it, l, it);
+    auto next = it;
+    ++next;
+    l.splice(next, l, it);
+  }
+  ASSERT_TRUE(same_as(l, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  auto it = l.begin();
+  ++it, ++it, ++it, ++it;
+  l.splice(l.begin(), l, it);
+  ASSERT_TRUE(same_as(l, {4, 0, 1, 2, 3, 5, 6, 7, 8, 9}));
+  l.clear();
+  ASSERT_TRUE(l.empty() && l.begin() == l.end());
+}